@@ -0,0 +1,204 @@
+/**
+* @file alfabeto.c
+* @brief Implementación del TDA Alfabeto.
+* Las tablas de posiciones se escriben una por alfabeto; la tabla de plegado se construye a partir de ellas al
+* configurarla, por lo que solo contiene reemplazos que pertenecen al alfabeto compilado.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <string.h>
+#include "define.h"
+#include "alfabeto.h"
+
+#if ALFABETO==ALFABETO_MINUSCULAS
+const signed char alfabeto_posiciones[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+const char alfabeto_caracteres[ALFABETO_TAMANIO] = {
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w',
+    'x', 'y', 'z'
+};
+#elif ALFABETO==ALFABETO_ALFANUMERICO
+const signed char alfabeto_posiciones[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+const char alfabeto_caracteres[ALFABETO_TAMANIO] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w',
+    'x', 'y', 'z'
+};
+#else
+const signed char alfabeto_posiciones[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 26, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 27, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+const char alfabeto_caracteres[ALFABETO_TAMANIO] = {
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w',
+    'x', 'y', 'z', (char) 0xB1, (char) 0xC3
+};
+#endif
+
+/**
+ * Letra base de cada caracter entre U+00C0 y U+00FF (segundo byte entre 0x80 y 0xBF en UTF-8), o "" si no es una letra.
+ * La 'ñ' y la 'Ñ' se resuelven aparte, ya que dependen de si el alfabeto la incluye.
+*/
+static const char *bases_latinas[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "ss",
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "y"
+};
+
+//Bytes que delimitan palabras, además de '\0', con el mismo criterio que lector.c.
+#define ALFABETO_SEPARADORES " \n.:;,"
+
+//Segundo byte de la 'Ñ' y de la 'ñ' en UTF-8.
+#define ALFABETO_ENIE_MAYUSCULA 0x91
+#define ALFABETO_ENIE_MINUSCULA 0xB1
+
+//Tabla de plegado establecida, y si ya fue construida.
+static alfabeto_plegado_t tabla_plegado;
+static int tabla_construida = FALSE;
+
+void alfabeto_configurar_plegado(int plegado){
+    alfabeto_plegado_t *P = &tabla_plegado;
+
+    memset(P, 0, sizeof(alfabeto_plegado_t));
+    //Los caracteres ASCII del alfabeto se conservan; con plegado, las mayúsculas se reemplazan por su minúscula.
+    for (int c=0; c<128; c++){
+        if (ALFABETO_POSICION(c)>=0){
+            P->simples[c] = (unsigned char) c;
+        }
+    }
+    if (plegado!=ALFABETO_PLEGADO_NINGUNO){
+        for (int c='A'; c<='Z'; c++){
+            P->simples[c] = (unsigned char) (c - 'A' + 'a');
+        }
+    }
+
+    //Letras de Latin-1: la 'ñ' se conserva si el alfabeto la incluye, y el resto se reemplaza por su letra base.
+    if (plegado==ALFABETO_PLEGADO_LATINO){
+        for (int i=0; i<64; i++){
+            strcpy(P->latinos[i], bases_latinas[i]);
+        }
+    }
+#if ALFABETO==ALFABETO_ESPANOL
+    strcpy(P->latinos[ALFABETO_ENIE_MINUSCULA - 0x80], "\xC3\xB1");
+    if (plegado!=ALFABETO_PLEGADO_NINGUNO){
+        strcpy(P->latinos[ALFABETO_ENIE_MAYUSCULA - 0x80], "\xC3\xB1");
+    }
+#endif
+    P->multibyte = FALSE;
+    for (int i=0; i<64; i++){
+        if (P->latinos[i][0]!='\0'){
+            P->multibyte = TRUE;
+        }
+    }
+    if (P->multibyte==TRUE){
+        P->simples[0xC3] = ALFABETO_LATINO;
+    }
+    P->identidad = (plegado==ALFABETO_PLEGADO_NINGUNO && P->multibyte==FALSE) ? TRUE : FALSE;
+
+    for (int c=0; c<256; c++){
+        if (P->simples[c]==ALFABETO_LATINO){
+            P->clases[c] = ALFABETO_CLASE_LATINO;
+        }
+        else{
+            P->clases[c] = (P->simples[c]==0) ? ALFABETO_CLASE_INVALIDO : ALFABETO_POSICION(P->simples[c]);
+        }
+    }
+    for (const char *c=ALFABETO_SEPARADORES; *c!='\0'; c++){
+        P->clases[(unsigned char) *c] = ALFABETO_CLASE_SEPARADOR;
+    }
+    P->clases[0] = ALFABETO_CLASE_SEPARADOR;
+    tabla_construida = TRUE;
+}
+
+const alfabeto_plegado_t *alfabeto_plegado(){
+    if (tabla_construida==FALSE){
+        alfabeto_configurar_plegado(ALFABETO_PLEGADO_NINGUNO);
+    }
+    return &tabla_plegado;
+}
+
+int alfabeto_plegar(char *palabra){
+    const alfabeto_plegado_t *P = alfabeto_plegado();
+    char *lectura = palabra;
+    char *escritura = palabra;
+    int to_return = TRUE;
+
+    while (*lectura!='\0' && to_return==TRUE){
+        unsigned char reemplazo = P->simples[(unsigned char) *lectura];
+
+        if (reemplazo==0){
+            to_return = FALSE;
+        }
+        else if (reemplazo==ALFABETO_LATINO){
+            unsigned char siguiente = (unsigned char) lectura[1];
+            //El segundo byte debe ser de continuación y corresponder a una letra con reemplazo.
+            if ((siguiente & 0xC0)!=0x80 || P->latinos[siguiente - 0x80][0]=='\0'){
+                to_return = FALSE;
+            }
+            else{
+                for (const char *c=P->latinos[siguiente - 0x80]; *c!='\0'; c++){
+                    *escritura = *c;
+                    escritura++;
+                }
+                lectura = lectura + 2;
+            }
+        }
+        else{
+            *escritura = (char) reemplazo;
+            escritura++;
+            lectura++;
+        }
+    }
+    *escritura = '\0';
+
+    return (to_return==TRUE && escritura>palabra) ? TRUE : FALSE;
+}
@@ -0,0 +1,116 @@
+/**
+* @file alfabeto.h
+* @brief Archivo encabezado del TDA Alfabeto.
+* Define, al compilar, el alfabeto de las palabras que se cuentan: qué bytes pueden formar una palabra y qué posición
+* ocupa cada uno entre los hijos de un nodo de los tries. Se elige con -DALFABETO=... entre:
+*   -ALFABETO_MINUSCULAS (por defecto): las 26 letras entre 'a' y 'z'.
+*   -ALFABETO_ALFANUMERICO: los dígitos entre '0' y '9' y las letras entre 'a' y 'z' (36 posiciones).
+*   -ALFABETO_ESPANOL: las letras entre 'a' y 'z' y la 'ñ', que en UTF-8 ocupa dos bytes (0xC3 0xB1) y por lo tanto dos
+*    niveles de los tries (28 posiciones).
+* Las posiciones respetan el orden de los bytes, por lo que los recorridos de los tries siguen el orden de strcmp.
+* La cantidad de hijos de los nodos (ALFABETO_TAMANIO) es una constante, de modo que el tamaño de los nodos y los ciclos
+* sobre sus hijos se resuelven al compilar.
+*
+* Además, al ejecutar se elige una tabla de plegado que decide cómo se transforman los caracteres leídos antes de
+* contarlos: sin plegado (solo se aceptan palabras formadas por caracteres del alfabeto), pasando las mayúsculas a
+* minúsculas, o pasando además las letras acentuadas de Latin-1 codificadas en UTF-8 (entre U+00C0 y U+00FF) a su
+* letra base. Cualquier otro caracter invalida la palabra que lo contiene.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef ALFABETO_H_INCLUDED
+#define ALFABETO_H_INCLUDED
+
+//Alfabetos disponibles al compilar.
+#define ALFABETO_MINUSCULAS 0
+#define ALFABETO_ALFANUMERICO 1
+#define ALFABETO_ESPANOL 2
+
+#ifndef ALFABETO
+#define ALFABETO ALFABETO_MINUSCULAS
+#endif
+
+#if ALFABETO==ALFABETO_MINUSCULAS
+#define ALFABETO_TAMANIO 26
+//Las letras son contiguas, por lo que la posición se calcula sin consultar la tabla.
+#define ALFABETO_POSICION(c) ((((unsigned char) (c)) - 'a' < 26u) ? (((unsigned char) (c)) - 'a') : -1)
+#define ALFABETO_CARACTER(i) ((char) ('a' + (i)))
+#elif ALFABETO==ALFABETO_ALFANUMERICO
+#define ALFABETO_TAMANIO 36
+#define ALFABETO_POSICION(c) (alfabeto_posiciones[(unsigned char) (c)])
+#define ALFABETO_CARACTER(i) (alfabeto_caracteres[(i)])
+#elif ALFABETO==ALFABETO_ESPANOL
+#define ALFABETO_TAMANIO 28
+#define ALFABETO_POSICION(c) (alfabeto_posiciones[(unsigned char) (c)])
+#define ALFABETO_CARACTER(i) (alfabeto_caracteres[(i)])
+#else
+#error "ALFABETO debe ser ALFABETO_MINUSCULAS, ALFABETO_ALFANUMERICO o ALFABETO_ESPANOL."
+#endif
+
+/**
+ * @typedef alfabeto_mascara_t
+ * @brief Entero con un bit por cada posición del alfabeto.
+*/
+#if ALFABETO_TAMANIO<=32
+typedef unsigned int alfabeto_mascara_t;
+#else
+typedef unsigned long long alfabeto_mascara_t;
+#endif
+
+//Posición de cada byte en el alfabeto (-1 si no pertenece) y byte de cada posición, para los alfabetos no contiguos.
+extern const signed char alfabeto_posiciones[256];
+extern const char alfabeto_caracteres[ALFABETO_TAMANIO];
+
+//Tablas de plegado disponibles al ejecutar.
+#define ALFABETO_PLEGADO_NINGUNO 0 ///Solo se aceptan palabras formadas por caracteres del alfabeto.
+#define ALFABETO_PLEGADO_MAYUSCULAS 1 ///Las mayúsculas se pasan a minúsculas.
+#define ALFABETO_PLEGADO_LATINO 2 ///Además, las letras acentuadas de Latin-1 en UTF-8 se pasan a su letra base.
+
+//Marca de la tabla de bytes simples para el primer byte de las letras de Latin-1 en UTF-8 (0xC3).
+#define ALFABETO_LATINO 0xFF
+
+//Clases de la tabla de clases que no son posiciones del alfabeto.
+#define ALFABETO_CLASE_INVALIDO -1 ///El byte invalida la palabra que lo contiene.
+#define ALFABETO_CLASE_SEPARADOR -2 ///El byte delimita palabras (los mismos separadores que en lector.c).
+#define ALFABETO_CLASE_LATINO -3 ///El byte es 0xC3 y se reemplaza junto al siguiente (ver 'latinos').
+
+/**
+ * @struct alfabeto_plegado
+ * @brief Modela una tabla de plegado. Para cada byte, 'simples' indica el byte por el que se reemplaza, 0 si invalida la
+ * palabra, o ALFABETO_LATINO si es 0xC3, en cuyo caso el byte siguiente (entre 0x80 y 0xBF) se reemplaza, junto a él,
+ * por la cadena de 'latinos' que le corresponde (vacía si invalida la palabra). Ningún reemplazo es más largo que los
+ * bytes que reemplaza, por lo que las palabras pueden plegarse sobre sí mismas.
+ * 'clases' reúne en una sola consulta por byte la separación, el plegado y la posición: la posición en el alfabeto del
+ * byte que reemplaza a un byte simple, o una de las clases ALFABETO_CLASE_*.
+*/
+struct alfabeto_plegado {
+    unsigned char simples[256];
+    signed char clases[256];
+    char latinos[64][3];
+    int multibyte; ///TRUE si algún byte está marcado con ALFABETO_LATINO.
+    int identidad; ///TRUE si la tabla no reemplaza ningún caracter: solo acepta los bytes del alfabeto.
+};
+typedef struct alfabeto_plegado alfabeto_plegado_t;
+
+/**
+ * @brief Establece la tabla de plegado con la que se leen las palabras a partir de la invocación (por defecto,
+ * ALFABETO_PLEGADO_NINGUNO).
+ * @param plegado ALFABETO_PLEGADO_NINGUNO, ALFABETO_PLEGADO_MAYUSCULAS o ALFABETO_PLEGADO_LATINO.
+*/
+extern void alfabeto_configurar_plegado(int plegado);
+
+/**
+ * @brief Devuelve la tabla de plegado establecida.
+ * @return Puntero a la tabla, que no debe modificarse.
+*/
+extern const alfabeto_plegado_t *alfabeto_plegado();
+
+/**
+ * @brief Pliega en el lugar la palabra dada con la tabla de plegado establecida.
+ * @param palabra Puntero a la cadena de caracteres (sin separadores).
+ * @return TRUE si la palabra plegada es válida (no vacía y formada solo por caracteres del alfabeto), FALSE si no.
+*/
+extern int alfabeto_plegar(char *palabra);
+
+#endif // ALFABETO_H_INCLUDED
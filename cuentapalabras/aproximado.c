@@ -0,0 +1,348 @@
+/**
+* @file aproximado.c
+* @brief Implementación del TDA Aproximado.
+* Las palabras del resumen Space-Saving se organizan en un heap de mínimos por cantidad, para reemplazar la menos
+* repetida en tiempo logarítmico, y en una tabla hash de direccionamiento abierto, para ubicarlas en tiempo constante.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "aproximado.h"
+
+//Constante e, utilizada para dimensionar el sketch sin depender de la biblioteca matemática.
+#define APROXIMADO_E 2.718281828459045
+
+/**
+ * @struct entrada_resumen
+ * @brief Modela una palabra del resumen Space-Saving.
+*/
+struct entrada_resumen {
+    char *palabra;
+    unsigned long long hash; //Hash de la palabra, conservado para reubicarla en la tabla.
+    long long cantidad; //Cota superior de las repeticiones de la palabra.
+    long long error; //Cantidad que tenía la entrada reemplazada al ingresar la palabra (cota del sobreconteo).
+    int pos_heap; //Posición de la entrada en el heap.
+};
+
+/**
+ * @struct aproximado
+ * @brief Modela el Count-Min Sketch junto al resumen Space-Saving.
+*/
+struct aproximado {
+    long long *sketch; //Matriz de profundidad x ancho contadores, por filas.
+    unsigned long ancho;
+    int profundidad;
+    struct entrada_resumen *entradas; //Entradas del resumen, en orden de ingreso.
+    int cant_entradas;
+    int capacidad;
+    int *heap; //Índices de las entradas, ordenados como heap de mínimos por cantidad.
+    int *tabla; //Índices de las entradas por hash de la palabra, o -1 si la posición está libre.
+    unsigned long tam_tabla; //Potencia de 2 mayor o igual al doble de la capacidad.
+    unsigned long memoria_palabras; //Bytes reservados para las palabras del resumen.
+};
+
+/**
+ * @brief Reserva 'n' bytes, finalizando el programa si no es posible.
+ * @throw ERROR_APROXIMADO_MEMORIA si no se logra reservar memoria.
+*/
+static void *aux_reservar(unsigned long n){
+    void *to_return = malloc(n);
+    if (to_return==NULL){
+        printf("Error %d: No se pudo reservar memoria para el contador aproximado.\n", ERROR_APROXIMADO_MEMORIA);
+        exit(ERROR_APROXIMADO_MEMORIA);
+    }
+    return to_return;
+}
+
+/**
+ * @brief Calcula el hash FNV-1a de 64 bits de la palabra, mezclado para que sus dos mitades sean independientes.
+*/
+static unsigned long long aux_hash(char *s){
+    unsigned long long h = 14695981039346656037ULL;
+
+    while (*s!='\0'){
+        h = (h ^ (unsigned char) *s) * 1099511628211ULL;
+        s++;
+    }
+    h = (h ^ (h>>33)) * 0xff51afd7ed558ccdULL;
+    h = (h ^ (h>>33)) * 0xc4ceb9fe1a85ec53ULL;
+
+    return h ^ (h>>33);
+}
+
+/**
+ * @brief Devuelve la columna de la palabra en la fila dada del sketch (doble hashing sobre las mitades del hash).
+*/
+static unsigned long aux_columna(aproximado_t *A, unsigned long long hash, int fila){
+    unsigned long long h1 = hash & 0xFFFFFFFFULL;
+    unsigned long long h2 = (hash >> 32) | 1;
+    return (unsigned long) ((h1 + fila*h2) % A->ancho);
+}
+
+aproximado_t *aproximado_crear(double error, double probabilidad_fallo, int capacidad){
+    aproximado_t *A = (aproximado_t*) aux_reservar(sizeof(struct aproximado));
+    double probabilidad = 1;
+
+    //ancho = techo(e/error) y profundidad = techo(ln(1/probabilidad_fallo)).
+    A->ancho = (unsigned long) (APROXIMADO_E/error) + 1;
+    A->profundidad = 0;
+    while (probabilidad>probabilidad_fallo){
+        probabilidad = probabilidad / APROXIMADO_E;
+        A->profundidad = A->profundidad + 1;
+    }
+    A->sketch = (long long*) aux_reservar(A->ancho*A->profundidad*sizeof(long long));
+    memset(A->sketch, 0, A->ancho*A->profundidad*sizeof(long long));
+
+    A->capacidad = capacidad;
+    A->cant_entradas = 0;
+    A->entradas = (struct entrada_resumen*) aux_reservar(capacidad*sizeof(struct entrada_resumen));
+    A->heap = (int*) aux_reservar(capacidad*sizeof(int));
+    A->tam_tabla = 1;
+    while (A->tam_tabla < 2*(unsigned long)capacidad){
+        A->tam_tabla = 2*A->tam_tabla;
+    }
+    A->tabla = (int*) aux_reservar(A->tam_tabla*sizeof(int));
+    for (unsigned long i=0; i<A->tam_tabla; i++){
+        A->tabla[i] = -1;
+    }
+    A->memoria_palabras = 0;
+
+    return A;
+}
+
+//----RESUMEN SPACE-SAVING----
+
+/**
+ * @brief Devuelve la posición de la tabla que ocupa la palabra, o la posición libre donde debería ubicarse.
+*/
+static unsigned long aux_buscar_en_tabla(aproximado_t *A, char *s, unsigned long long hash){
+    unsigned long pos = hash & (A->tam_tabla-1);
+
+    while (A->tabla[pos]!=-1 && strcmp(A->entradas[A->tabla[pos]].palabra, s)!=0){
+        pos = (pos+1) & (A->tam_tabla-1);
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Libera la posición dada de la tabla, desplazando hacia atrás las entradas siguientes que dejarían de ser alcanzables.
+*/
+static void aux_quitar_de_tabla(aproximado_t *A, unsigned long pos){
+    unsigned long libre = pos;
+    unsigned long siguiente = (pos+1) & (A->tam_tabla-1);
+
+    while (A->tabla[siguiente]!=-1){
+        unsigned long ideal = A->entradas[A->tabla[siguiente]].hash & (A->tam_tabla-1);
+        //La entrada puede ocupar la posición libre si esta se encuentra entre su posición ideal y su posición actual.
+        if (((siguiente-ideal) & (A->tam_tabla-1)) >= ((siguiente-libre) & (A->tam_tabla-1))){
+            A->tabla[libre] = A->tabla[siguiente];
+            libre = siguiente;
+        }
+        siguiente = (siguiente+1) & (A->tam_tabla-1);
+    }
+    A->tabla[libre] = -1;
+}
+
+/**
+ * @brief Intercambia dos posiciones del heap, actualizando la posición registrada en cada entrada.
+*/
+static void aux_heap_intercambiar(aproximado_t *A, int i, int j){
+    int aux = A->heap[i];
+    A->heap[i] = A->heap[j];
+    A->heap[j] = aux;
+    A->entradas[A->heap[i]].pos_heap = i;
+    A->entradas[A->heap[j]].pos_heap = j;
+}
+
+/**
+ * @brief Restablece la propiedad de heap desde la posición dada hacia arriba.
+*/
+static void aux_heap_subir(aproximado_t *A, int pos){
+    while (pos>0 && A->entradas[A->heap[pos]].cantidad < A->entradas[A->heap[(pos-1)/2]].cantidad){
+        aux_heap_intercambiar(A, pos, (pos-1)/2);
+        pos = (pos-1)/2;
+    }
+}
+
+/**
+ * @brief Restablece la propiedad de heap desde la posición dada hacia abajo.
+*/
+static void aux_heap_hundir(aproximado_t *A, int pos){
+    int terminado = FALSE;
+
+    while (terminado==FALSE){
+        int menor = pos;
+        int izq = 2*pos+1;
+        int der = 2*pos+2;
+        if (izq<A->cant_entradas && A->entradas[A->heap[izq]].cantidad < A->entradas[A->heap[menor]].cantidad){
+            menor = izq;
+        }
+        if (der<A->cant_entradas && A->entradas[A->heap[der]].cantidad < A->entradas[A->heap[menor]].cantidad){
+            menor = der;
+        }
+        if (menor==pos){
+            terminado = TRUE;
+        }
+        else{
+            aux_heap_intercambiar(A, pos, menor);
+            pos = menor;
+        }
+    }
+}
+
+/**
+ * @brief Asigna una copia de la palabra a la entrada dada, reutilizando su memoria si alcanza.
+*/
+static void aux_asignar_palabra(aproximado_t *A, struct entrada_resumen *e, char *s, unsigned long long hash){
+    unsigned long longitud = strlen(s);
+    unsigned long anterior = (e->palabra==NULL) ? 0 : strlen(e->palabra)+1;
+
+    if (anterior < longitud+1){
+        free(e->palabra);
+        e->palabra = (char*) aux_reservar(longitud+1);
+        A->memoria_palabras = A->memoria_palabras - anterior + longitud+1;
+    }
+    strcpy(e->palabra, s);
+    e->hash = hash;
+}
+
+/**
+ * @brief Suma 'cantidad' a la palabra en el resumen. Si la palabra no está y el resumen está completo, reemplaza a la
+ * palabra menos repetida, heredando su cantidad como cota del error.
+*/
+static void aux_actualizar_resumen(aproximado_t *A, char *s, unsigned long long hash, long long cantidad){
+    unsigned long pos = aux_buscar_en_tabla(A, s, hash);
+
+    if (A->tabla[pos]!=-1){
+        struct entrada_resumen *e = &(A->entradas[A->tabla[pos]]);
+        e->cantidad = e->cantidad + cantidad;
+        aux_heap_hundir(A, e->pos_heap);
+    }
+    else if (A->cant_entradas < A->capacidad){
+        int indice = A->cant_entradas;
+        struct entrada_resumen *e = &(A->entradas[indice]);
+
+        e->palabra = NULL;
+        aux_asignar_palabra(A, e, s, hash);
+        e->cantidad = cantidad;
+        e->error = 0;
+        e->pos_heap = indice;
+        A->heap[indice] = indice;
+        A->tabla[pos] = indice;
+        A->cant_entradas = A->cant_entradas + 1;
+        aux_heap_subir(A, indice);
+    }
+    else{
+        int indice = A->heap[0];
+        struct entrada_resumen *e = &(A->entradas[indice]);
+
+        aux_quitar_de_tabla(A, aux_buscar_en_tabla(A, e->palabra, e->hash));
+        aux_asignar_palabra(A, e, s, hash);
+        e->error = e->cantidad;
+        e->cantidad = e->cantidad + cantidad;
+        A->tabla[aux_buscar_en_tabla(A, s, hash)] = indice;
+        aux_heap_hundir(A, 0);
+    }
+}
+
+//----OPERACIONES----
+
+/**
+ * @brief Devuelve la estimación del sketch para la palabra: el mínimo de sus contadores en cada fila.
+*/
+static long long aux_estimar_en_sketch(aproximado_t *A, unsigned long long hash){
+    long long to_return = -1;
+
+    for (int fila=0; fila<A->profundidad; fila++){
+        long long valor = A->sketch[fila*A->ancho + aux_columna(A, hash, fila)];
+        if (to_return==-1 || valor<to_return){
+            to_return = valor;
+        }
+    }
+
+    return to_return;
+}
+
+void aproximado_insertar(aproximado_t *A, char *s, long long cantidad){
+    unsigned long long hash = aux_hash(s);
+
+    for (int fila=0; fila<A->profundidad; fila++){
+        A->sketch[fila*A->ancho + aux_columna(A, hash, fila)] += cantidad;
+    }
+    aux_actualizar_resumen(A, s, hash, cantidad);
+}
+
+long long aproximado_cantidad(aproximado_t *A, char *s){
+    unsigned long long hash = aux_hash(s);
+    long long to_return = aux_estimar_en_sketch(A, hash);
+    unsigned long pos = aux_buscar_en_tabla(A, s, hash);
+
+    //Ambas cantidades son cotas superiores de la real, por lo que se informa la menor.
+    if (A->tabla[pos]!=-1 && A->entradas[A->tabla[pos]].cantidad < to_return){
+        to_return = A->entradas[A->tabla[pos]].cantidad;
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Función de comparación de qsort que ordena entradas del resumen por su palabra.
+*/
+static int aux_comparar_entradas(const void *e1, const void *e2){
+    return strcmp((*(struct entrada_resumen* const*) e1)->palabra, (*(struct entrada_resumen* const*) e2)->palabra);
+}
+
+void aproximado_recorrer_prefijo(aproximado_t *A, char *prefijo, funcion_visita_t visitar, void *contexto){
+    struct entrada_resumen **seleccion = (struct entrada_resumen**) aux_reservar(A->cant_entradas*sizeof(struct entrada_resumen*) + 1);
+    unsigned long longitud_prefijo = strlen(prefijo);
+    int cant_seleccion = 0;
+
+    for (int i=0; i<A->cant_entradas; i++){
+        if (strncmp(A->entradas[i].palabra, prefijo, longitud_prefijo)==0){
+            seleccion[cant_seleccion] = &(A->entradas[i]);
+            cant_seleccion = cant_seleccion + 1;
+        }
+    }
+    qsort(seleccion, cant_seleccion, sizeof(struct entrada_resumen*), aux_comparar_entradas);
+
+    for (int i=0; i<cant_seleccion; i++){
+        long long estimacion = aux_estimar_en_sketch(A, seleccion[i]->hash);
+        visitar(seleccion[i]->palabra, (seleccion[i]->cantidad < estimacion) ? seleccion[i]->cantidad : estimacion, contexto);
+    }
+    free(seleccion);
+}
+
+unsigned long aproximado_memoria(aproximado_t *A){
+    return sizeof(struct aproximado)
+        + A->ancho*A->profundidad*sizeof(long long)
+        + A->capacidad*(sizeof(struct entrada_resumen) + sizeof(int))
+        + A->tam_tabla*sizeof(int)
+        + A->memoria_palabras;
+}
+
+void aproximado_vaciar(aproximado_t *A){
+    memset(A->sketch, 0, A->ancho*A->profundidad*sizeof(long long));
+    for (int i=0; i<A->cant_entradas; i++){
+        free(A->entradas[i].palabra);
+    }
+    for (unsigned long i=0; i<A->tam_tabla; i++){
+        A->tabla[i] = -1;
+    }
+    A->cant_entradas = 0;
+    A->memoria_palabras = 0;
+}
+
+void aproximado_eliminar(aproximado_t **A){
+    aproximado_vaciar(*A);
+    free((*A)->sketch);
+    free((*A)->entradas);
+    free((*A)->heap);
+    free((*A)->tabla);
+    free(*A);
+    *A = NULL;
+}
@@ -0,0 +1,81 @@
+/**
+* @file aproximado.h
+* @brief Archivo encabezado del TDA Aproximado.
+* Cuenta palabras de forma aproximada con memoria acotada, independiente de la cantidad de palabras distintas:
+*  - Un Count-Min Sketch de 'profundidad' filas por 'ancho' contadores responde la cantidad de cualquier palabra.
+*  - Un resumen Space-Saving de 'capacidad' palabras conserva las palabras más repetidas.
+*
+* Garantías, siendo N la cantidad total de palabras insertadas:
+*  - La cantidad informada de una palabra nunca es menor a la real.
+*  - Con probabilidad al menos 1-probabilidad_fallo, la cantidad informada excede a la real en a lo sumo error*N
+*    (ancho = e/error, profundidad = ln(1/probabilidad_fallo)).
+*  - Toda palabra con más de N/capacidad repeticiones está en el resumen, y su cantidad en el resumen excede a la
+*    real en a lo sumo N/capacidad. Se informa el mínimo entre la cantidad del resumen y la del sketch.
+* Las palabras que recibe deben estar compuestas solo por caracteres del alfabeto (ver alfabeto.h).
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef APROXIMADO_H_INCLUDED
+#define APROXIMADO_H_INCLUDED
+
+#include "multiset.h"
+
+#define ERROR_APROXIMADO_MEMORIA -19
+
+struct aproximado;
+typedef struct aproximado aproximado_t;
+
+/**
+ * @brief Crea un contador aproximado vacío y lo devuelve.
+ * @param error Error máximo de una cantidad, como fracción del total de palabras insertadas (entre 0 y 1).
+ * @param probabilidad_fallo Probabilidad de que una cantidad exceda el error máximo (entre 0 y 1).
+ * @param capacidad Cantidad de palabras que conserva el resumen de las más repetidas.
+ * @throw ERROR_APROXIMADO_MEMORIA si no se logra reservar memoria.
+ * @return Puntero al contador construido.
+*/
+extern aproximado_t *aproximado_crear(double error, double probabilidad_fallo, int capacidad);
+
+/**
+ * @brief Suma 'cantidad' repeticiones de la palabra 's'.
+ * @param A Puntero al contador.
+ * @param s Puntero a la palabra (solo caracteres del alfabeto).
+ * @param cantidad Entero positivo a sumar.
+ * @throw ERROR_APROXIMADO_MEMORIA si no se logra reservar memoria para la palabra.
+*/
+extern void aproximado_insertar(aproximado_t *A, char *s, long long cantidad);
+
+/**
+ * @brief Devuelve una cota superior de la cantidad de repeticiones de la palabra 's' (ver garantías).
+ * @param A Puntero al contador.
+ * @param s Puntero a la palabra (solo caracteres del alfabeto).
+ * @return Entero mayor o igual a 0.
+*/
+extern long long aproximado_cantidad(aproximado_t *A, char *s);
+
+/**
+ * @brief Recorre en orden lexicográfico las palabras del resumen que comienzan con 'prefijo'.
+ * @param A Puntero al contador.
+ * @param prefijo Puntero al prefijo (vacío para recorrer todo el resumen).
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador.
+ * @throw ERROR_APROXIMADO_MEMORIA si no se logra reservar memoria para el recorrido.
+*/
+extern void aproximado_recorrer_prefijo(aproximado_t *A, char *prefijo, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Devuelve la cantidad de bytes reservados por el contador.
+*/
+extern unsigned long aproximado_memoria(aproximado_t *A);
+
+/**
+ * @brief Remueve todas las palabras del contador, que puede seguir utilizándose.
+*/
+extern void aproximado_vaciar(aproximado_t *A);
+
+/**
+ * @brief Elimina el contador liberando la memoria reservada. Luego de la invocación '*A' es NULL.
+*/
+extern void aproximado_eliminar(aproximado_t **A);
+
+#endif // APROXIMADO_H_INCLUDED
@@ -0,0 +1,151 @@
+/**
+* @file benchmark_aproximado.c
+* @brief Compara el conteo exacto (MULTISET_MODO_TRIE) con el aproximado (MULTISET_MODO_APROXIMADO) sobre un flujo
+* sintético de palabras con distribución de Zipf: tiempo de inserción, memoria, y exactitud de las K palabras más repetidas.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o benchmark_aproximado benchmark_aproximado.c zipf.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c -lm -lpthread
+*
+* Uso:
+*   benchmark_aproximado [palabras del flujo] [vocabulario] [K] [error]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../define.h"
+#include "../multiset.h"
+#include "zipf.h"
+
+#define ERROR_BENCHMARK_MEMORIA -1
+
+/**
+ * @struct conteo
+ * @brief Modela una palabra junto a su cantidad, recopilada al recorrer un multiset.
+*/
+struct conteo {
+    char *palabra;
+    long long cantidad;
+};
+
+/**
+ * @struct recopilacion
+ * @brief Modela el arreglo de conteos recopilados.
+*/
+struct recopilacion {
+    struct conteo *conteos;
+    int cantidad;
+    int capacidad;
+};
+
+static void *aux_reservar(unsigned long n){
+    void *to_return = malloc(n);
+    if (to_return==NULL){
+        printf("Error %d: No se pudo reservar memoria.\n", ERROR_BENCHMARK_MEMORIA);
+        exit(ERROR_BENCHMARK_MEMORIA);
+    }
+    return to_return;
+}
+
+static void aux_visitar_recopilacion(char *palabra, long long cantidad, void *contexto){
+    struct recopilacion *R = (struct recopilacion*) contexto;
+
+    if (R->cantidad==R->capacidad){
+        R->capacidad = (R->capacidad==0) ? 1024 : 2*R->capacidad;
+        R->conteos = (struct conteo*) realloc(R->conteos, R->capacidad*sizeof(struct conteo));
+        if (R->conteos==NULL){
+            printf("Error %d: No se pudo reservar memoria.\n", ERROR_BENCHMARK_MEMORIA);
+            exit(ERROR_BENCHMARK_MEMORIA);
+        }
+    }
+    R->conteos[R->cantidad].palabra = (char*) aux_reservar(strlen(palabra)+1);
+    strcpy(R->conteos[R->cantidad].palabra, palabra);
+    R->conteos[R->cantidad].cantidad = cantidad;
+    R->cantidad = R->cantidad + 1;
+}
+
+static int aux_comparar_conteos(const void *c1, const void *c2){
+    long long a = ((const struct conteo*) c1)->cantidad;
+    long long b = ((const struct conteo*) c2)->cantidad;
+    return (a<b) - (a>b);
+}
+
+/**
+ * @brief Inserta el flujo en el multiset y devuelve los segundos empleados.
+*/
+static double aux_cargar(multiset_t *m, char **vocabulario, int *flujo, int cant_flujo){
+    clock_t inicio = clock();
+    for (int i=0; i<cant_flujo; i++){
+        multiset_insertar(m, vocabulario[flujo[i]]);
+    }
+    return (clock()-inicio) / (double) CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv){
+    int cant_flujo = (argc>1) ? atoi(argv[1]) : 5000000;
+    int cant_vocabulario = (argc>2) ? atoi(argv[2]) : 1000000;
+    int k = (argc>3) ? atoi(argv[3]) : 100;
+    double error = (argc>4) ? atof(argv[4]) : MULTISET_APROXIMADO_ERROR;
+    int capacidad = (argc>5) ? atoi(argv[5]) : 10*k;
+    struct recopilacion exacto = {NULL, 0, 0};
+    struct recopilacion aproximado = {NULL, 0, 0};
+    int aciertos = 0;
+    long long error_maximo = 0;
+    double error_total = 0;
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(cant_vocabulario);
+    int *flujo = zipf_generar_flujo(cant_flujo, cant_vocabulario, 1.0);
+
+    multiset_t *m_exacto = multiset_crear_modo(MULTISET_MODO_TRIE);
+    double t_exacto = aux_cargar(m_exacto, vocabulario, flujo, cant_flujo);
+
+    multiset_configurar_aproximado(error, capacidad);
+    multiset_t *m_aproximado = multiset_crear_modo(MULTISET_MODO_APROXIMADO);
+    double t_aproximado = aux_cargar(m_aproximado, vocabulario, flujo, cant_flujo);
+
+    multiset_recorrer(m_exacto, aux_visitar_recopilacion, &exacto);
+    multiset_recorrer(m_aproximado, aux_visitar_recopilacion, &aproximado);
+    qsort(exacto.conteos, exacto.cantidad, sizeof(struct conteo), aux_comparar_conteos);
+    qsort(aproximado.conteos, aproximado.cantidad, sizeof(struct conteo), aux_comparar_conteos);
+
+    //Exactitud sobre las K palabras más repetidas según el conteo exacto.
+    int cant_top = (k<exacto.cantidad) ? k : exacto.cantidad;
+    for (int i=0; i<cant_top; i++){
+        long long estimacion = multiset_cantidad(m_aproximado, exacto.conteos[i].palabra);
+        long long diferencia = estimacion - exacto.conteos[i].cantidad;
+        for (int j=0; j<aproximado.cantidad; j++){
+            if (strcmp(aproximado.conteos[j].palabra, exacto.conteos[i].palabra)==0){
+                aciertos = aciertos + 1;
+            }
+        }
+        if (diferencia>error_maximo){
+            error_maximo = diferencia;
+        }
+        error_total = error_total + diferencia;
+    }
+
+    printf("Flujo: %d palabras, vocabulario: %d (distintas vistas: %d), K=%d, error=%g, capacidad=%d\n", cant_flujo, cant_vocabulario, exacto.cantidad, k, error, capacidad);
+    printf("%-12s %10s %14s\n", "modo", "segundos", "memoria (KB)");
+    printf("%-12s %10.3f %14lu\n", "exacto", t_exacto, multiset_memoria(m_exacto)/1024);
+    printf("%-12s %10.3f %14lu\n", "aproximado", t_aproximado, multiset_memoria(m_aproximado)/1024);
+    printf("Top-%d presentes en el resumen: %d (%.1f%%)\n", cant_top, aciertos, 100.0*aciertos/cant_top);
+    printf("Sobreconteo en el top-%d: promedio %.2f, maximo %lld (cota error*N = %.0f)\n", cant_top, error_total/cant_top, error_maximo, error*cant_flujo);
+
+    for (int i=0; i<exacto.cantidad; i++){
+        free(exacto.conteos[i].palabra);
+    }
+    for (int i=0; i<aproximado.cantidad; i++){
+        free(aproximado.conteos[i].palabra);
+    }
+    free(exacto.conteos);
+    free(aproximado.conteos);
+    zipf_liberar_vocabulario(vocabulario, cant_vocabulario);
+    free(flujo);
+    multiset_eliminar(&m_exacto);
+    multiset_eliminar(&m_aproximado);
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+* @file benchmark_bufer.c
+* @brief Mide el conteo de textos que ya están en memoria, como los que recibe un servicio que utiliza el programa como
+* biblioteca: copiando cada texto para separarlo en el lugar (lector_procesar_contenido), separándolo con el lector de
+* flujo, que copia cada palabra (lector_flujo_procesar), y con conteo_contar_bufer, que separa e inserta las palabras
+* en una sola pasada sobre el propio texto. Verifica además que los tres conteos visiten las mismas palabras con las
+* mismas cantidades.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o benchmark_bufer benchmark_bufer.c zipf.c ../conteo.c ../lector.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c -lm -lpthread
+*
+* Uso:
+*   benchmark_bufer [textos] [palabras por texto] [vocabulario]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../define.h"
+#include "../lector.h"
+#include "../multiset.h"
+#include "../conteo.h"
+#include "zipf.h"
+
+/**
+ * @brief Devuelve los segundos de procesador transcurridos desde 'inicio'.
+*/
+static double aux_segundos_desde(clock_t inicio){
+    return (clock()-inicio) / (double) CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Función que inserta cada palabra recibida en el multiset dado como contexto.
+*/
+static void aux_insertar_palabra(char *palabra, void *contexto){
+    multiset_insertar((multiset_t*) contexto, palabra);
+}
+
+/**
+ * @brief Función de visita que acumula en el contexto un hash de la secuencia de palabras y cantidades visitadas.
+*/
+static void aux_visitar_hash(char *palabra, long long cantidad, void *contexto){
+    unsigned long long *hash = (unsigned long long*) contexto;
+    while (*palabra!='\0'){
+        *hash = (*hash ^ (unsigned char) *palabra) * 1099511628211ULL;
+        palabra++;
+    }
+    *hash = (*hash ^ (unsigned long long) cantidad) * 1099511628211ULL;
+}
+
+int main(int argc, char **argv){
+    int cant_textos = (argc>1) ? atoi(argv[1]) : 20000;
+    int palabras_por_texto = (argc>2) ? atoi(argv[2]) : 500;
+    int cant_vocabulario = (argc>3) ? atoi(argv[3]) : 100000;
+    char *nombres[] = {"copia", "flujo", "bufer"};
+    unsigned long long hash_referencia = 0;
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(cant_vocabulario);
+    int *flujo = zipf_generar_flujo(cant_textos*palabras_por_texto, cant_vocabulario, 1.0);
+
+    //Los textos se arman consecutivos en un único arreglo, separando las palabras con espacios y signos de puntuación.
+    char **textos = (char**) malloc(cant_textos*sizeof(char*));
+    unsigned long *longitudes = (unsigned long*) malloc(cant_textos*sizeof(unsigned long));
+    unsigned long longitud_maxima = 0;
+    unsigned long bytes = 0;
+    for (int t=0; t<cant_textos; t++){
+        unsigned long n = 0;
+        for (int i=0; i<palabras_por_texto; i++){
+            n = n + strlen(vocabulario[flujo[t*palabras_por_texto+i]]) + 1;
+        }
+        textos[t] = (char*) malloc(n);
+        n = 0;
+        for (int i=0; i<palabras_por_texto; i++){
+            char *palabra = vocabulario[flujo[t*palabras_por_texto+i]];
+            memcpy(textos[t]+n, palabra, strlen(palabra));
+            n = n + strlen(palabra);
+            textos[t][n] = (i%10==9) ? '.' : ' ';
+            n = n + 1;
+        }
+        longitudes[t] = n;
+        bytes = bytes + n;
+        if (n>longitud_maxima){
+            longitud_maxima = n;
+        }
+    }
+    char *copia = (char*) malloc(longitud_maxima+1);
+
+    printf("Textos: %d, palabras por texto: %d, vocabulario: %d, MB: %.1f\n", cant_textos, palabras_por_texto, cant_vocabulario, bytes / (1024.0*1024.0));
+    printf("%-10s %12s %12s\n", "conteo", "segundos", "MB/s");
+
+    for (int k=0; k<3; k++){
+        multiset_t *m = multiset_crear();
+        unsigned long long hash = 14695981039346656037ULL;
+
+        clock_t inicio = clock();
+        for (int t=0; t<cant_textos; t++){
+            if (k==0){
+                //El texto del invocador no puede modificarse, por lo que se copia antes de separarlo en el lugar.
+                memcpy(copia, textos[t], longitudes[t]);
+                lector_procesar_contenido(copia, longitudes[t], aux_insertar_palabra, m);
+            }
+            else if (k==1){
+                lector_flujo_t l;
+                lector_flujo_iniciar(&l);
+                lector_flujo_procesar(&l, textos[t], longitudes[t], aux_insertar_palabra, m);
+                lector_flujo_finalizar(&l, aux_insertar_palabra, m);
+            }
+            else{
+                conteo_contar_bufer(m, textos[t], longitudes[t]);
+            }
+        }
+        double segundos = aux_segundos_desde(inicio);
+
+        multiset_recorrer(m, aux_visitar_hash, &hash);
+        if (k==0){
+            hash_referencia = hash;
+        }
+        printf("%-10s %12.3f %12.1f%s\n", nombres[k], segundos, (bytes / (1024.0*1024.0)) / segundos,
+               (hash==hash_referencia) ? "" : "   (CONTEO DISTINTO)");
+        multiset_eliminar(&m);
+    }
+
+    for (int t=0; t<cant_textos; t++){
+        free(textos[t]);
+    }
+    free(textos);
+    free(longitudes);
+    free(copia);
+    free(flujo);
+    zipf_liberar_vocabulario(vocabulario, cant_vocabulario);
+    return 0;
+}
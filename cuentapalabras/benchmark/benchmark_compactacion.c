@@ -0,0 +1,107 @@
+/**
+* @file benchmark_compactacion.c
+* @brief Mide el efecto de multiset_compactar sobre las consultas: construye un multiset con un flujo sintético con
+* distribución de Zipf y consulta la cantidad de otro flujo de palabras antes y después de reubicar sus nodos.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o benchmark_compactacion benchmark_compactacion.c zipf.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c -lm -lpthread
+*
+* Uso:
+*   benchmark_compactacion [palabras del flujo] [vocabulario]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../define.h"
+#include "../multiset.h"
+#include "zipf.h"
+
+//Cantidad de repeticiones de cada medición; se informa la menor.
+#define REPETICIONES 3
+//Cantidad de palabras de cada archivo simulado al construir el multiset.
+#define PALABRAS_POR_ARCHIVO 100000
+
+/**
+ * @brief Función de visita que suma la palabra al multiset recibido como contexto.
+*/
+static void aux_visitar_suma(char *palabra, long long cantidad, void *contexto){
+    multiset_insertar_cantidad((multiset_t*) contexto, palabra, cantidad);
+}
+
+/**
+ * @brief Consulta la cantidad de cada palabra del flujo y devuelve los segundos empleados, junto a la suma de las cantidades.
+*/
+static double aux_medir(multiset_t *m, char **vocabulario, int *flujo, int cant_flujo, long long *suma){
+    double to_return = -1;
+
+    for (int r=0; r<REPETICIONES; r++){
+        clock_t inicio = clock();
+        *suma = 0;
+        for (int i=0; i<cant_flujo; i++){
+            *suma = *suma + multiset_cantidad(m, vocabulario[flujo[i]]);
+        }
+        double segundos = (clock()-inicio) / (double) CLOCKS_PER_SEC;
+        if (to_return<0 || segundos<to_return){
+            to_return = segundos;
+        }
+    }
+
+    return to_return;
+}
+
+int main(int argc, char **argv){
+    int cant_flujo = (argc>1) ? atoi(argv[1]) : 5000000;
+    int cant_vocabulario = (argc>2) ? atoi(argv[2]) : 200000;
+    double exponentes[] = {0.0, 0.8, 1.0, 1.2};
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(cant_vocabulario);
+
+    //El multiset se construye con un flujo de exponente 1, como el de un texto natural, y del mismo modo que los totales
+    //de cuentapalabras: cada archivo se cuenta en un multiset propio que se suma a los totales y luego se elimina,
+    //por lo que los nodos de los totales quedan intercalados en el heap con los de los archivos.
+    multiset_t *m = multiset_crear_modo(MULTISET_MODO_TRIE);
+    int *construccion = zipf_generar_flujo(cant_flujo, cant_vocabulario, 1.0);
+    for (int inicio=0; inicio<cant_flujo; inicio=inicio+PALABRAS_POR_ARCHIVO){
+        multiset_t *archivo = multiset_crear_modo(MULTISET_MODO_TRIE);
+        for (int i=inicio; i<cant_flujo && i<inicio+PALABRAS_POR_ARCHIVO; i++){
+            multiset_insertar(archivo, vocabulario[construccion[i]]);
+        }
+        multiset_recorrer(archivo, aux_visitar_suma, m);
+        multiset_eliminar(&archivo);
+    }
+    free(construccion);
+
+    int *consultas[sizeof(exponentes)/sizeof(double)];
+    double sin_compactar[sizeof(exponentes)/sizeof(double)];
+    long long sumas[sizeof(exponentes)/sizeof(double)];
+    for (unsigned int e=0; e<sizeof(exponentes)/sizeof(double); e++){
+        consultas[e] = zipf_generar_flujo(cant_flujo, cant_vocabulario, exponentes[e]);
+        sin_compactar[e] = aux_medir(m, vocabulario, consultas[e], cant_flujo, &(sumas[e]));
+    }
+
+    clock_t inicio = clock();
+    multiset_compactar(m);
+    double segundos_compactacion = (clock()-inicio) / (double) CLOCKS_PER_SEC;
+
+    printf("Flujo: %d palabras, vocabulario: %d, memoria: %lu bytes, compactacion: %.3fs\n", cant_flujo, cant_vocabulario, multiset_memoria(m), segundos_compactacion);
+    printf("%-10s %14s %14s %10s\n", "exponente", "sin compactar", "compactado", "mejora");
+    for (unsigned int e=0; e<sizeof(exponentes)/sizeof(double); e++){
+        long long suma;
+        double compactado = aux_medir(m, vocabulario, consultas[e], cant_flujo, &suma);
+
+        //Las consultas deben devolver las mismas cantidades antes y después de compactar.
+        if (suma!=sumas[e]){
+            printf("Error: las cantidades cambiaron al compactar (%lld y %lld).\n", sumas[e], suma);
+        }
+        printf("%-10.1f %13.3fs %13.3fs %9.2fx\n", exponentes[e], sin_compactar[e], compactado, sin_compactar[e]/compactado);
+        free(consultas[e]);
+    }
+
+    multiset_eliminar(&m);
+    zipf_liberar_vocabulario(vocabulario, cant_vocabulario);
+    return 0;
+}
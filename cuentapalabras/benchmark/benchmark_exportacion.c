@@ -0,0 +1,113 @@
+/**
+* @file benchmark_exportacion.c
+* @brief Mide la escritura de totales.out para un vocabulario grande: con la lista de multiset_elementos_por_frecuencia
+* y fprintf (como aux_exportar_multiset_a_archivo) y con exportacion_escribir_por_frecuencia usando 1, 2, 4 y 8 hilos.
+* Verifica además que todas las variantes escriban exactamente el mismo archivo.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o benchmark_exportacion benchmark_exportacion.c zipf.c ../exportacion.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c ../traza.c -lm -lpthread
+*
+* Uso:
+*   benchmark_exportacion [archivo temporal] [palabras del flujo] [vocabulario]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../define.h"
+#include "../multiset.h"
+#include "../exportacion.h"
+#include "zipf.h"
+
+/**
+ * @brief Devuelve los segundos transcurridos desde 'inicio' (tiempo real, ya que la exportación utiliza varios hilos).
+*/
+static double aux_segundos_desde(struct timespec *inicio){
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - inicio->tv_sec) + (fin.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Escribe el multiset en 'path' con 'cant_hilos' hilos, o con la lista y fprintf si 'cant_hilos' es 0.
+ * @return Segundos empleados.
+*/
+static double aux_medir(multiset_t *m, char *path, int cant_hilos){
+    struct timespec inicio;
+    FILE *f = fopen(path, "w");
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    if (cant_hilos==0){
+        lista_t L = multiset_elementos_por_frecuencia(m);
+        cursor_lista_t cursor = lista_cursor(&L);
+        while (lista_cursor_valido(&cursor)==TRUE){
+            elemento_t *elem = lista_cursor_eliminar(&cursor);
+            fprintf(f, "%lld   %s\n", elem->a, elem->b);
+            free(elem->b);
+            free(elem);
+        }
+    }
+    else{
+        exportacion_escribir_por_frecuencia(m, f, cant_hilos);
+    }
+    fclose(f);
+
+    return aux_segundos_desde(&inicio);
+}
+
+/**
+ * @brief Devuelve TRUE si los archivos dados tienen el mismo contenido.
+*/
+static int aux_iguales(char *path1, char *path2){
+    FILE *f1 = fopen(path1, "r");
+    FILE *f2 = fopen(path2, "r");
+    int c1 = fgetc(f1);
+    int c2 = fgetc(f2);
+
+    while (c1==c2 && c1!=EOF){
+        c1 = fgetc(f1);
+        c2 = fgetc(f2);
+    }
+    fclose(f1);
+    fclose(f2);
+
+    return (c1==c2) ? TRUE : FALSE;
+}
+
+int main(int argc, char **argv){
+    char *path = (argc>1) ? argv[1] : "/tmp/benchmark_exportacion.out";
+    int cant_flujo = (argc>2) ? atoi(argv[2]) : 20000000;
+    int cant_vocabulario = (argc>3) ? atoi(argv[3]) : 2000000;
+    char path_referencia[strlen(path) + 16];
+    int hilos[] = {1, 2, 4, 8};
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(cant_vocabulario);
+    int *flujo = zipf_generar_flujo(cant_flujo, cant_vocabulario, 1.0);
+    multiset_t *m = multiset_crear();
+    for (int i=0; i<cant_flujo; i++){
+        multiset_insertar(m, vocabulario[flujo[i]]);
+    }
+    printf("Palabras: %d, distintas: %u\n", cant_flujo, multiset_cantidad_palabras(m));
+    printf("%-28s %10s\n", "exportacion", "segundos");
+
+    strcpy(path_referencia, path);
+    strcat(path_referencia, ".referencia");
+    printf("%-28s %10.3f\n", "lista y fprintf", aux_medir(m, path_referencia, 0));
+    for (int i=0; i<4; i++){
+        char nombre[32];
+        sprintf(nombre, "exportacion (%d hilos)", hilos[i]);
+        double segundos = aux_medir(m, path, hilos[i]);
+        printf("%-28s %10.3f%s\n", nombre, segundos, (aux_iguales(path, path_referencia)==TRUE) ? "" : "   (SALIDA DISTINTA)");
+    }
+
+    remove(path);
+    remove(path_referencia);
+    multiset_eliminar(&m);
+    free(flujo);
+    zipf_liberar_vocabulario(vocabulario, cant_vocabulario);
+    return 0;
+}
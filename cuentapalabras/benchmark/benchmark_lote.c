@@ -0,0 +1,121 @@
+/**
+* @file benchmark_lote.c
+* @brief Mide la lectura de un directorio de muchos archivos pequeños: archivo por archivo con lector_leer_archivo,
+* en lote con lectura simple y en lote con io_uring (ver lote.h). En todos los casos se separan las palabras y se cuentan,
+* sin construir multisets, para aislar el costo de la lectura.
+* Los archivos se generan al inicio y se eliminan al finalizar; como se acaban de escribir, se leen desde la cache de
+* páginas del sistema, por lo que se mide el costo de las llamadas al sistema y no el del disco.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o benchmark_lote benchmark_lote.c zipf.c ../lote.c ../lector.c ../alfabeto.c ../traza.c -lm
+*
+* Uso:
+*   benchmark_lote [directorio temporal] [cantidad de archivos]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../define.h"
+#include "../lector.h"
+#include "../lote.h"
+#include "zipf.h"
+
+//Cantidad de palabras del vocabulario con que se generan los archivos.
+#define VOCABULARIO 20000
+//Cantidad máxima de palabras de cada archivo (la cantidad de cada uno es aleatoria, entre 1 y este valor).
+#define PALABRAS_POR_ARCHIVO 200
+
+/**
+ * @brief Función que cuenta las palabras recibidas en el entero apuntado por el contexto.
+*/
+static void aux_contar_palabra(char *palabra, void *contexto){
+    (void) palabra;
+    *((long long*) contexto) = *((long long*) contexto) + 1;
+}
+
+/**
+ * @brief Función que recibe el contenido de un archivo del lote y cuenta sus palabras. Los archivos generados son
+ * menores a LOTE_TAMANIO_PARTE, por lo que siempre se reciben completos.
+*/
+static void aux_contar_contenido(int indice, char *contenido, unsigned long n, int parte, void *contexto){
+    (void) indice;
+    (void) parte;
+    if (contenido!=NULL){
+        lector_procesar_contenido(contenido, n, aux_contar_palabra, contexto);
+    }
+}
+
+/**
+ * @brief Devuelve los segundos transcurridos desde 'inicio' (tiempo real, ya que incluye la espera de las lecturas).
+*/
+static double aux_segundos_desde(struct timespec *inicio){
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - inicio->tv_sec) + (fin.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+int main(int argc, char **argv){
+    char *directorio = (argc>1) ? argv[1] : "/tmp/benchmark_lote";
+    int cant_archivos = (argc>2) ? atoi(argv[2]) : 100000;
+    char **rutas = (char**) malloc(cant_archivos*sizeof(char*));
+    unsigned long bytes = 0;
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(VOCABULARIO);
+    int *flujo = zipf_generar_flujo(PALABRAS_POR_ARCHIVO, VOCABULARIO, 1.0);
+    mkdir(directorio, 0755);
+
+    //Cada archivo toma una cantidad aleatoria de palabras de un mismo flujo, a partir de una posición distinta.
+    for (int i=0; i<cant_archivos; i++){
+        rutas[i] = (char*) malloc(strlen(directorio) + 32);
+        sprintf(rutas[i], "%s/archivo%06d.txt", directorio, i);
+        FILE *f = fopen(rutas[i], "w");
+        if (f==NULL){
+            printf("No se pudo crear '%s'.\n", rutas[i]);
+            return 1;
+        }
+        int cant_palabras = 1 + rand() % PALABRAS_POR_ARCHIVO;
+        for (int j=0; j<cant_palabras; j++){
+            bytes = bytes + fprintf(f, "%s%c", vocabulario[flujo[(i+j) % PALABRAS_POR_ARCHIVO]], (j%12==11) ? '\n' : ' ');
+        }
+        fclose(f);
+    }
+    printf("Archivos: %d, bytes: %lu\n", cant_archivos, bytes);
+    printf("%-28s %10s %12s\n", "lectura", "segundos", "palabras");
+
+    struct timespec inicio;
+    long long palabras = 0;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    for (int i=0; i<cant_archivos; i++){
+        lector_leer_archivo(rutas[i], aux_contar_palabra, &palabras);
+    }
+    printf("%-28s %10.3f %12lld\n", "lector_leer_archivo", aux_segundos_desde(&inicio), palabras);
+
+    lote_configurar_io_uring(FALSE);
+    palabras = 0;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    lote_leer_archivos(rutas, cant_archivos, aux_contar_contenido, &palabras);
+    printf("%-28s %10.3f %12lld\n", "lote (lectura simple)", aux_segundos_desde(&inicio), palabras);
+
+    lote_configurar_io_uring(TRUE);
+    palabras = 0;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    int modo = lote_leer_archivos(rutas, cant_archivos, aux_contar_contenido, &palabras);
+    printf("%-28s %10.3f %12lld\n", (modo==LOTE_IO_URING) ? "lote (io_uring)" : "lote (io_uring no disponible)", aux_segundos_desde(&inicio), palabras);
+
+    for (int i=0; i<cant_archivos; i++){
+        remove(rutas[i]);
+        free(rutas[i]);
+    }
+    rmdir(directorio);
+    free(rutas);
+    free(flujo);
+    zipf_liberar_vocabulario(vocabulario, VOCABULARIO);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+* @file benchmark_rafaga.c
+* @brief Compara el trie de ráfagas (MULTISET_MODO_RAFAGA) con el trie de 26 hijos por nodo (MULTISET_MODO_TRIE) y con
+* el árbol Patricia (MULTISET_MODO_COMPACTO) sobre un flujo sintético con distribución de Zipf: tiempo de inserción,
+* memoria, tiempo de consulta y tiempo del recorrido ordenado. Verifica además que los recorridos completos y por
+* prefijo de las tres implementaciones visiten las mismas palabras en el mismo orden.
+*
+* Compilación (desde este directorio; -DRAFAGA_UMBRAL=N cambia el umbral de las cubetas):
+*   gcc -O2 -o benchmark_rafaga benchmark_rafaga.c zipf.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c -lm -lpthread
+*
+* Uso:
+*   benchmark_rafaga [palabras del flujo] [vocabulario]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../define.h"
+#include "../multiset.h"
+#include "zipf.h"
+
+//Cantidad de prefijos de dos letras cuyos recorridos se comparan.
+#define CANT_PREFIJOS 200
+
+/**
+ * @brief Devuelve los segundos de procesador transcurridos desde 'inicio'.
+*/
+static double aux_segundos_desde(clock_t inicio){
+    return (clock()-inicio) / (double) CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Función de visita que acumula en el contexto un hash de la secuencia de palabras y cantidades visitadas.
+*/
+static void aux_visitar_hash(char *palabra, long long cantidad, void *contexto){
+    unsigned long long *hash = (unsigned long long*) contexto;
+    while (*palabra!='\0'){
+        *hash = (*hash ^ (unsigned char) *palabra) * 1099511628211ULL;
+        palabra++;
+    }
+    *hash = (*hash ^ (unsigned long long) cantidad) * 1099511628211ULL;
+}
+
+int main(int argc, char **argv){
+    int cant_flujo = (argc>1) ? atoi(argv[1]) : 10000000;
+    int cant_vocabulario = (argc>2) ? atoi(argv[2]) : 1000000;
+    int modos[] = {MULTISET_MODO_TRIE, MULTISET_MODO_COMPACTO, MULTISET_MODO_RAFAGA};
+    char *nombres[] = {"trie", "patricia", "rafagas"};
+    unsigned long long hash_referencia = 0;
+    unsigned long long hash_prefijos_referencia = 0;
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(cant_vocabulario);
+    int *flujo = zipf_generar_flujo(cant_flujo, cant_vocabulario, 1.0);
+    int *consultas = zipf_generar_flujo(cant_flujo, cant_vocabulario, 1.0);
+
+    printf("Palabras: %d, vocabulario: %d\n", cant_flujo, cant_vocabulario);
+    printf("%-10s %12s %12s %12s %12s\n", "multiset", "insercion", "memoria MB", "consultas", "recorrido");
+
+    for (int k=0; k<3; k++){
+        multiset_t *m = multiset_crear_modo(modos[k]);
+        unsigned long long hash = 14695981039346656037ULL;
+        unsigned long long hash_prefijos = 14695981039346656037ULL;
+        long long suma = 0;
+
+        clock_t inicio = clock();
+        for (int i=0; i<cant_flujo; i++){
+            multiset_insertar(m, vocabulario[flujo[i]]);
+        }
+        double segundos_insercion = aux_segundos_desde(inicio);
+
+        inicio = clock();
+        for (int i=0; i<cant_flujo; i++){
+            suma = suma + multiset_cantidad(m, vocabulario[consultas[i]]);
+        }
+        double segundos_consultas = aux_segundos_desde(inicio);
+
+        inicio = clock();
+        multiset_recorrer(m, aux_visitar_hash, &hash);
+        double segundos_recorrido = aux_segundos_desde(inicio);
+
+        //Los prefijos se toman del propio flujo, por lo que abarcan tanto nodos como cubetas del trie de ráfagas.
+        for (int i=0; i<CANT_PREFIJOS; i++){
+            char prefijo[3] = {vocabulario[flujo[i]][0], vocabulario[flujo[i]][1], '\0'};
+            multiset_recorrer_prefijo(m, prefijo, aux_visitar_hash, &hash_prefijos);
+            multiset_recorrer_prefijo(m, vocabulario[flujo[i]], aux_visitar_hash, &hash_prefijos);
+        }
+        if (k==0){
+            hash_referencia = hash;
+            hash_prefijos_referencia = hash_prefijos;
+        }
+
+        printf("%-10s %12.3f %12.1f %12.3f %12.3f%s   (suma %lld)\n", nombres[k], segundos_insercion,
+               multiset_memoria(m) / (1024.0*1024.0), segundos_consultas, segundos_recorrido,
+               (hash==hash_referencia && hash_prefijos==hash_prefijos_referencia) ? "" : "   (RECORRIDO DISTINTO)", suma);
+        multiset_eliminar(&m);
+    }
+
+    free(flujo);
+    free(consultas);
+    zipf_liberar_vocabulario(vocabulario, cant_vocabulario);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+* @file benchmark_reciclaje.c
+* @brief Mide el conteo de muchos archivos pequeños en un multiset por archivo, como hace el programa: creando y
+* eliminando el multiset de cada archivo (multiset_crear y multiset_eliminar) y reutilizando uno solo, que se reinicia
+* entre archivos conservando sus nodos (multiset_reiniciar). Informa, cada cierta cantidad de archivos, las reservas de
+* memoria acumuladas y la memoria residente del proceso, y verifica que ambas formas cuenten lo mismo en cada archivo.
+* Las reservas se cuentan interceptando malloc en el enlazado, por lo que requiere el enlazador de GNU y Linux.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o benchmark_reciclaje benchmark_reciclaje.c zipf.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c -lm -lpthread -Wl,--wrap=malloc
+*
+* Uso:
+*   benchmark_reciclaje [archivos] [palabras por archivo] [vocabulario]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "../define.h"
+#include "../multiset.h"
+#include "zipf.h"
+
+//Cantidad de invocaciones a malloc desde el inicio del programa.
+static unsigned long long cant_reservas = 0;
+
+extern void *__real_malloc(size_t tamanio);
+
+/**
+ * @brief Reemplaza a malloc en el enlazado (-Wl,--wrap=malloc) para contar las reservas.
+*/
+void *__wrap_malloc(size_t tamanio){
+    cant_reservas++;
+    return __real_malloc(tamanio);
+}
+
+/**
+ * @brief Devuelve los segundos de procesador transcurridos desde 'inicio'.
+*/
+static double aux_segundos_desde(clock_t inicio){
+    return (clock()-inicio) / (double) CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Devuelve la memoria residente del proceso en MB, leída de /proc/self/statm (0 si no está disponible).
+*/
+static double aux_memoria_residente(){
+    double to_return = 0;
+    unsigned long paginas, residentes;
+    FILE *f = fopen("/proc/self/statm", "r");
+
+    if (f!=NULL){
+        if (fscanf(f, "%lu %lu", &paginas, &residentes)==2){
+            to_return = residentes * (double) sysconf(_SC_PAGESIZE) / (1024.0*1024.0);
+        }
+        fclose(f);
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Función de visita que acumula en el contexto un hash de la secuencia de palabras y cantidades visitadas.
+*/
+static void aux_visitar_hash(char *palabra, long long cantidad, void *contexto){
+    unsigned long long *hash = (unsigned long long*) contexto;
+    while (*palabra!='\0'){
+        *hash = (*hash ^ (unsigned char) *palabra) * 1099511628211ULL;
+        palabra++;
+    }
+    *hash = (*hash ^ (unsigned long long) cantidad) * 1099511628211ULL;
+}
+
+int main(int argc, char **argv){
+    int cant_archivos = (argc>1) ? atoi(argv[1]) : 20000;
+    int palabras_por_archivo = (argc>2) ? atoi(argv[2]) : 2000;
+    int cant_vocabulario = (argc>3) ? atoi(argv[3]) : 100000;
+    int cada = (cant_archivos>=5) ? cant_archivos/5 : 1;
+    char *nombres[] = {"eliminar", "reiniciar"};
+
+    srand(17);
+    char **vocabulario = zipf_generar_vocabulario(cant_vocabulario);
+    int *flujo = zipf_generar_flujo(cant_archivos*palabras_por_archivo, cant_vocabulario, 1.0);
+    unsigned long long *hashes = (unsigned long long*) malloc(cant_archivos*sizeof(unsigned long long));
+
+    printf("Archivos: %d, palabras por archivo: %d, vocabulario: %d\n", cant_archivos, palabras_por_archivo, cant_vocabulario);
+    printf("%-10s %10s %16s %12s\n", "multiset", "archivos", "reservas", "MB residente");
+
+    for (int k=0; k<2; k++){
+        multiset_t *m = (k==1) ? multiset_crear() : NULL;
+        int distintos = 0;
+        unsigned long long reservas_iniciales = cant_reservas;
+
+        clock_t inicio = clock();
+        for (int a=0; a<cant_archivos; a++){
+            unsigned long long hash = 14695981039346656037ULL;
+
+            if (k==0){
+                m = multiset_crear();
+            }
+            for (int i=0; i<palabras_por_archivo; i++){
+                multiset_insertar(m, vocabulario[flujo[a*palabras_por_archivo+i]]);
+            }
+            multiset_recorrer(m, aux_visitar_hash, &hash);
+            if (k==0){
+                hashes[a] = hash;
+                multiset_eliminar(&m);
+            }
+            else{
+                if (hash!=hashes[a]){
+                    distintos++;
+                }
+                multiset_reiniciar(m);
+            }
+
+            if ((a+1)%cada==0){
+                printf("%-10s %10d %16llu %12.1f\n", nombres[k], a+1, cant_reservas - reservas_iniciales, aux_memoria_residente());
+            }
+        }
+        double segundos = aux_segundos_desde(inicio);
+
+        if (k==1){
+            multiset_eliminar(&m);
+        }
+        printf("%-10s %.3f segundos%s\n", nombres[k], segundos, (distintos==0) ? "" : "   (CONTEO DISTINTO)");
+    }
+
+    free(hashes);
+    free(flujo);
+    zipf_liberar_vocabulario(vocabulario, cant_vocabulario);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+* @file zipf.c
+* @brief Implementación del generador de corpus sintéticos de los benchmarks.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "zipf.h"
+
+static void *aux_reservar(unsigned long n){
+    void *to_return = malloc(n);
+    if (to_return==NULL){
+        printf("Error %d: No se pudo reservar memoria.\n", ERROR_ZIPF_MEMORIA);
+        exit(ERROR_ZIPF_MEMORIA);
+    }
+    return to_return;
+}
+
+char **zipf_generar_vocabulario(int cant_palabras){
+    char **to_return = (char**) aux_reservar(cant_palabras*sizeof(char*));
+
+    for (int i=0; i<cant_palabras; i++){
+        int longitud = 3 + rand()%10;
+        to_return[i] = (char*) aux_reservar(longitud+12);
+        for (int j=0; j<longitud; j++){
+            to_return[i][j] = 'a' + rand()%26;
+        }
+        //Un sufijo con el índice codificado en letras garantiza que las palabras sean distintas.
+        int indice = i;
+        int j = longitud;
+        do {
+            to_return[i][j] = 'a' + indice%26;
+            indice = indice/26;
+            j++;
+        } while (indice>0);
+        to_return[i][j] = '\0';
+    }
+
+    return to_return;
+}
+
+int *zipf_generar_flujo(int cant_flujo, int cant_vocabulario, double exponente){
+    double *acumulada = (double*) aux_reservar(cant_vocabulario*sizeof(double));
+    int *to_return = (int*) aux_reservar(cant_flujo*sizeof(int));
+    double suma = 0;
+
+    for (int i=0; i<cant_vocabulario; i++){
+        suma = suma + 1.0/pow(i+1, exponente);
+        acumulada[i] = suma;
+    }
+    //Se muestrea la distribución acumulada por búsqueda binaria.
+    for (int i=0; i<cant_flujo; i++){
+        double u = suma * (rand() / ((double) RAND_MAX + 1));
+        int izq = 0;
+        int der = cant_vocabulario-1;
+        while (izq<der){
+            int medio = (izq+der)/2;
+            if (acumulada[medio]<u)
+                izq = medio+1;
+            else
+                der = medio;
+        }
+        to_return[i] = izq;
+    }
+    free(acumulada);
+
+    return to_return;
+}
+
+void zipf_liberar_vocabulario(char **vocabulario, int cant_palabras){
+    for (int i=0; i<cant_palabras; i++){
+        free(vocabulario[i]);
+    }
+    free(vocabulario);
+}
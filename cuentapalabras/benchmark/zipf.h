@@ -0,0 +1,38 @@
+/**
+* @file zipf.h
+* @brief Archivo encabezado del generador de corpus sintéticos de los benchmarks.
+* Genera un vocabulario de palabras distintas y un flujo de índices de dicho vocabulario con distribución de Zipf,
+* que modela la frecuencia de las palabras en textos naturales.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef ZIPF_H_INCLUDED
+#define ZIPF_H_INCLUDED
+
+#define ERROR_ZIPF_MEMORIA -1
+
+/**
+ * @brief Genera un vocabulario de palabras distintas de entre 3 y 12 letras (más un sufijo que las distingue).
+ * @param cant_palabras Cantidad de palabras del vocabulario.
+ * @throw ERROR_ZIPF_MEMORIA si no se logra reservar memoria.
+ * @return Arreglo de palabras, a liberar con zipf_liberar_vocabulario.
+*/
+extern char **zipf_generar_vocabulario(int cant_palabras);
+
+/**
+ * @brief Genera un flujo de índices del vocabulario donde la palabra i-ésima aparece con probabilidad proporcional a 1/(i+1)^exponente.
+ * @param cant_flujo Cantidad de índices a generar.
+ * @param cant_vocabulario Cantidad de palabras del vocabulario.
+ * @param exponente Exponente de la distribución (1 para textos naturales; mayor implica más concentración).
+ * @throw ERROR_ZIPF_MEMORIA si no se logra reservar memoria.
+ * @return Arreglo de índices, a liberar con free.
+*/
+extern int *zipf_generar_flujo(int cant_flujo, int cant_vocabulario, double exponente);
+
+/**
+ * @brief Libera el vocabulario generado.
+*/
+extern void zipf_liberar_vocabulario(char **vocabulario, int cant_palabras);
+
+#endif // ZIPF_H_INCLUDED
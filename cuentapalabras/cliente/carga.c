@@ -0,0 +1,176 @@
+/**
+* @file carga.c
+* @brief Generador de carga para el servidor de cuentapalabras.
+* Lanza H hilos que envían consultas durante S segundos, cada uno por su propia conexión persistente, y reporta el
+* rendimiento (consultas por segundo) y la latencia p50/p99. Las consultas alternan entre PROTOCOLO_CANTIDAD
+* sobre las palabras dadas y PROTOCOLO_TOP con K=10 sobre los totales.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o carga carga.c ../protocolo.c -lpthread
+*
+* Uso:
+*   carga <socket> <hilos> <segundos> <palabra> [palabra ...]
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../define.h"
+#include "../protocolo.h"
+
+#define ERROR_CARGA_CONEXION -1
+#define ERROR_CARGA_PARAMETROS -2
+#define ERROR_CARGA_MEMORIA -3
+
+/**
+ * @struct hilo_carga
+ * @brief Modela los parámetros y las latencias medidas (en nanosegundos) de un hilo del generador.
+*/
+struct hilo_carga {
+    pthread_t hilo;
+    char *path_socket;
+    char **palabras;
+    int cant_palabras;
+    double segundos;
+    long long *latencias;
+    unsigned long cant_latencias;
+    unsigned long capacidad;
+};
+typedef struct hilo_carga hilo_carga_t;
+
+static double aux_ahora(){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec/1e9;
+}
+
+static int aux_comparar_latencias(const void *a, const void *b){
+    long long x = *(const long long*) a;
+    long long y = *(const long long*) b;
+    return (x>y) - (x<y);
+}
+
+static int aux_conectar(char *path_socket){
+    struct sockaddr_un direccion;
+    int to_return = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    strncpy(direccion.sun_path, path_socket, sizeof(direccion.sun_path)-1);
+
+    if (to_return<0 || connect(to_return, (struct sockaddr*) &direccion, sizeof(direccion))<0){
+        printf("Error %d: No se pudo conectar con el servidor en '%s'.\n", ERROR_CARGA_CONEXION, path_socket);
+        exit(ERROR_CARGA_CONEXION);
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Cuerpo de cada hilo: envía consultas por su conexión hasta agotar el tiempo y registra la latencia de cada una.
+*/
+static void* aux_ejecutar_hilo(void *parametro){
+    hilo_carga_t *h = (hilo_carga_t*) parametro;
+    int conexion = aux_conectar(h->path_socket);
+    double fin = aux_ahora() + h->segundos;
+    unsigned long i = 0;
+
+    while (aux_ahora()<fin){
+        int32_t estado;
+        double inicio = aux_ahora();
+        int exito;
+
+        if (i%2==0)
+            exito = protocolo_enviar_solicitud(conexion, PROTOCOLO_CANTIDAD, NULL, h->palabras[(i/2)%h->cant_palabras]);
+        else
+            exito = protocolo_enviar_solicitud(conexion, PROTOCOLO_TOP, NULL, "10");
+        exito = exito && protocolo_recibir_respuesta(conexion, &estado, NULL, NULL);
+
+        if (exito==FALSE){
+            printf("Error %d: Se perdió la conexión con el servidor.\n", ERROR_CARGA_CONEXION);
+            exit(ERROR_CARGA_CONEXION);
+        }
+        if (h->cant_latencias==h->capacidad){
+            h->capacidad = (h->capacidad==0) ? 1024 : 2*h->capacidad;
+            h->latencias = (long long*) realloc(h->latencias, h->capacidad*sizeof(long long));
+            if (h->latencias==NULL){
+                printf("Error %d: No se pudo reservar memoria.\n", ERROR_CARGA_MEMORIA);
+                exit(ERROR_CARGA_MEMORIA);
+            }
+        }
+        h->latencias[h->cant_latencias] = (long long) ((aux_ahora()-inicio)*1e9);
+        h->cant_latencias = h->cant_latencias + 1;
+        i++;
+    }
+    close(conexion);
+
+    return NULL;
+}
+
+int main(int argc, char **argv){
+    hilo_carga_t *hilos;
+    long long *latencias;
+    unsigned long total = 0;
+    int cant_hilos;
+    double segundos;
+
+    if (argc<5){
+        printf("Uso: carga <socket> <hilos> <segundos> <palabra> [palabra ...]\n");
+        exit(ERROR_CARGA_PARAMETROS);
+    }
+    cant_hilos = atoi(argv[2]);
+    segundos = atof(argv[3]);
+    if (cant_hilos<=0 || segundos<=0){
+        printf("Error %d: La cantidad de hilos y los segundos deben ser positivos.\n", ERROR_CARGA_PARAMETROS);
+        exit(ERROR_CARGA_PARAMETROS);
+    }
+
+    hilos = (hilo_carga_t*) calloc(cant_hilos, sizeof(hilo_carga_t));
+    if (hilos==NULL){
+        printf("Error %d: No se pudo reservar memoria.\n", ERROR_CARGA_MEMORIA);
+        exit(ERROR_CARGA_MEMORIA);
+    }
+    for (int i=0; i<cant_hilos; i++){
+        hilos[i].path_socket = argv[1];
+        hilos[i].palabras = argv+4;
+        hilos[i].cant_palabras = argc-4;
+        hilos[i].segundos = segundos;
+        pthread_create(&hilos[i].hilo, NULL, aux_ejecutar_hilo, &hilos[i]);
+    }
+    for (int i=0; i<cant_hilos; i++){
+        pthread_join(hilos[i].hilo, NULL);
+        total = total + hilos[i].cant_latencias;
+    }
+
+    //Se reúnen las latencias de todos los hilos para calcular los percentiles.
+    latencias = (long long*) malloc((total+1)*sizeof(long long));
+    if (latencias==NULL){
+        printf("Error %d: No se pudo reservar memoria.\n", ERROR_CARGA_MEMORIA);
+        exit(ERROR_CARGA_MEMORIA);
+    }
+    total = 0;
+    for (int i=0; i<cant_hilos; i++){
+        memcpy(latencias+total, hilos[i].latencias, hilos[i].cant_latencias*sizeof(long long));
+        total = total + hilos[i].cant_latencias;
+        free(hilos[i].latencias);
+    }
+    qsort(latencias, total, sizeof(long long), aux_comparar_latencias);
+
+    printf("Consultas: %lu en %.1f s con %d hilos\n", total, segundos, cant_hilos);
+    printf("Rendimiento: %.0f consultas/s\n", total/segundos);
+    if (total>0){
+        printf("Latencia p50: %.1f us\n", latencias[total/2]/1e3);
+        printf("Latencia p99: %.1f us\n", latencias[(total*99)/100]/1e3);
+    }
+
+    free(latencias);
+    free(hilos);
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+* @file cliente.c
+* @brief Cliente de línea de comandos del servidor de cuentapalabras (ver cuentapalabras -s).
+* Envía una solicitud al servidor y muestra los registros de la respuesta con el mismo formato que los archivos .out.
+*
+* Compilación (desde este directorio):
+*   gcc -O2 -o cliente cliente.c ../protocolo.c
+*
+* Uso:
+*   cliente <socket> ingestar <archivo o directorio>
+*   cliente <socket> cantidad <palabra> [archivo]
+*   cliente <socket> top <K> [archivo]
+*   cliente <socket> prefijo <prefijo> [archivo]
+*   cliente <socket> detener
+* Si no se indica el archivo, la consulta se realiza sobre los totales.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../define.h"
+#include "../protocolo.h"
+
+#define ERROR_CLIENTE_CONEXION -1
+#define ERROR_CLIENTE_PARAMETROS -2
+
+/**
+ * @brief Muestra una palabra y su cantidad.
+*/
+static void aux_mostrar_registro(char *palabra, long long cantidad, void *contexto){
+    printf("%lld   %s\n", cantidad, palabra);
+}
+
+/**
+ * @brief Retorna el código de operación correspondiente al nombre dado, o 0 si el nombre es desconocido.
+*/
+static uint32_t aux_obtener_operacion(char *nombre){
+    uint32_t to_return = 0;
+
+    if (strcmp(nombre, "ingestar")==0)
+        to_return = PROTOCOLO_INGESTAR;
+    else if (strcmp(nombre, "cantidad")==0)
+        to_return = PROTOCOLO_CANTIDAD;
+    else if (strcmp(nombre, "top")==0)
+        to_return = PROTOCOLO_TOP;
+    else if (strcmp(nombre, "prefijo")==0)
+        to_return = PROTOCOLO_PREFIJO;
+    else if (strcmp(nombre, "detener")==0)
+        to_return = PROTOCOLO_DETENER;
+
+    return to_return;
+}
+
+/**
+ * @brief Conecta con el servidor que escucha en el socket de la ruta dada.
+ * @throw ERROR_CLIENTE_CONEXION si no se pudo conectar.
+*/
+static int aux_conectar(char *path_socket){
+    struct sockaddr_un direccion;
+    int to_return = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    strncpy(direccion.sun_path, path_socket, sizeof(direccion.sun_path)-1);
+
+    if (to_return<0 || connect(to_return, (struct sockaddr*) &direccion, sizeof(direccion))<0){
+        printf("Error %d: No se pudo conectar con el servidor en '%s'.\n", ERROR_CLIENTE_CONEXION, path_socket);
+        exit(ERROR_CLIENTE_CONEXION);
+    }
+
+    return to_return;
+}
+
+int main(int argc, char **argv){
+    uint32_t operacion = (argc>2) ? aux_obtener_operacion(argv[2]) : 0;
+    int32_t estado = PROTOCOLO_OK;
+    char *argumento = NULL;
+    char *archivo = NULL;
+    int conexion;
+
+    if (operacion==0 || (operacion!=PROTOCOLO_DETENER && argc<4)){
+        printf("Uso: cliente <socket> ingestar|cantidad|top|prefijo|detener [argumento] [archivo]\n");
+        exit(ERROR_CLIENTE_PARAMETROS);
+    }
+    if (operacion!=PROTOCOLO_DETENER){
+        argumento = argv[3];
+        archivo = (argc>4) ? argv[4] : NULL;
+    }
+
+    conexion = aux_conectar(argv[1]);
+    if (protocolo_enviar_solicitud(conexion, operacion, archivo, argumento)==FALSE
+        || protocolo_recibir_respuesta(conexion, &estado, aux_mostrar_registro, NULL)==FALSE){
+        printf("Error %d: Se perdió la conexión con el servidor.\n", ERROR_CLIENTE_CONEXION);
+        exit(ERROR_CLIENTE_CONEXION);
+    }
+    close(conexion);
+
+    if (estado==PROTOCOLO_ERROR_ARCHIVO)
+        printf("El archivo indicado no existe.\n");
+    else if (estado==PROTOCOLO_ERROR_SOLICITUD)
+        printf("El servidor rechazó la solicitud.\n");
+
+    return (estado==PROTOCOLO_OK) ? 0 : estado;
+}
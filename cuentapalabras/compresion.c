@@ -0,0 +1,657 @@
+/**
+* @file compresion.c
+* @brief Implementación del TDA Compresion.
+* Los archivos comprimidos de salida se construyen con fopencookie, de modo que el resto del programa escribe en ellos
+* con fprintf y fwrite como en cualquier otro archivo.
+* La descompresión en un hilo propio utiliza una cola circular de COMPRESION_BLOQUES bloques: el hilo descompresor
+* llena los bloques libres y el hilo invocador entrega los llenos, esperando cada uno al otro solo si la cola se vacía o
+* se llena.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "lector.h"
+#include "compresion.h"
+#include "traza.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sys/types.h>
+#define COMPRESION_CON_HILOS
+#endif
+
+#ifdef COMPRESION_CON_ZLIB
+#include <zlib.h>
+#endif
+#ifdef COMPRESION_CON_ZSTD
+#include <zstd.h>
+#endif
+
+#if defined(COMPRESION_CON_ZLIB) || defined(COMPRESION_CON_ZSTD)
+#define COMPRESION_CON_FORMATOS
+#endif
+
+//Cantidad de bloques de la cola entre el hilo descompresor y el invocador.
+#define COMPRESION_BLOQUES 4
+//Tamaño mínimo del contenido comprimido para descomprimirlo en un hilo propio; en archivos menores el costo de crear el
+//hilo supera al de descomprimirlos.
+#define COMPRESION_MINIMO_HILO (1 << 16)
+
+/**
+ * @struct descompresion
+ * @brief Modela el estado de la descompresión de un contenido: la cola de bloques y, si se utiliza un hilo propio, su
+ * sincronización con el hilo invocador.
+*/
+struct descompresion {
+    char *contenido; //Contenido comprimido.
+    unsigned long n; //Cantidad de bytes del contenido.
+    int formato; //Formato de compresión.
+#ifdef COMPRESION_CON_ZLIB
+    z_stream z; //Estado del descompresor gzip.
+#endif
+#ifdef COMPRESION_CON_ZSTD
+    ZSTD_DCtx *zstd; //Estado del descompresor zstd.
+#endif
+    int en_trama; //TRUE si el último miembro (gzip) o trama (zstd) comenzado aún no terminó.
+    int relleno; //TRUE si tras el último miembro o trama comenzó el relleno de bytes nulos, que ocupa el resto del contenido.
+    char *bloques[COMPRESION_BLOQUES]; //Bloques descomprimidos (solo se utiliza el primero sin hilo propio).
+    unsigned long longitudes[COMPRESION_BLOQUES]; //Cantidad de bytes de cada bloque.
+    unsigned long producidos; //Cantidad de bloques llenados desde el inicio.
+    unsigned long consumidos; //Cantidad de bloques entregados desde el inicio.
+    int terminado; //TRUE cuando el descompresor llenó el último bloque.
+    int con_hilo; //TRUE si la descompresión se realiza en un hilo propio.
+    funcion_bloque_t *entregar; //Función del invocador (sin hilo propio, se invoca al llenar cada bloque).
+    void *contexto; //Datos del invocador.
+#ifdef COMPRESION_CON_HILOS
+    pthread_mutex_t mutex; //Protege a 'producidos', 'consumidos' y 'terminado'.
+    pthread_cond_t hay_bloque; //Se señala al llenar un bloque o terminar.
+    pthread_cond_t hay_lugar; //Se señala al entregar un bloque.
+#endif
+};
+
+int compresion_disponible(int formato){
+    int to_return = FALSE;
+
+    if (formato==COMPRESION_NINGUNA){
+        to_return = TRUE;
+    }
+#ifdef COMPRESION_CON_ZLIB
+    if (formato==COMPRESION_GZIP){
+        to_return = TRUE;
+    }
+#endif
+#ifdef COMPRESION_CON_ZSTD
+    if (formato==COMPRESION_ZSTD){
+        to_return = TRUE;
+    }
+#endif
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Devuelve TRUE si 'nombre' termina con 'sufijo'.
+*/
+static int aux_termina_con(char *nombre, char *sufijo){
+    int longitud_nombre = strlen(nombre);
+    int longitud_sufijo = strlen(sufijo);
+    return (longitud_nombre>=longitud_sufijo && strcmp(nombre + longitud_nombre - longitud_sufijo, sufijo)==0) ? TRUE : FALSE;
+}
+
+int compresion_formato_de_nombre(char *nombre){
+    int to_return = COMPRESION_NINGUNA;
+
+    if (aux_termina_con(nombre, ".gz")==TRUE){
+        to_return = COMPRESION_GZIP;
+    }
+    else if (aux_termina_con(nombre, ".zst")==TRUE){
+        to_return = COMPRESION_ZSTD;
+    }
+
+    return to_return;
+}
+
+char *compresion_extension(int formato){
+    char *to_return = "";
+
+    if (formato==COMPRESION_GZIP){
+        to_return = ".gz";
+    }
+    else if (formato==COMPRESION_ZSTD){
+        to_return = ".zst";
+    }
+
+    return to_return;
+}
+
+int compresion_es_archivo_txt(char *nombre){
+    int formato = compresion_formato_de_nombre(nombre);
+    int to_return = FALSE;
+
+    if (formato==COMPRESION_NINGUNA){
+        to_return = lector_es_archivo_txt(nombre);
+    }
+    else if (compresion_disponible(formato)==TRUE){
+        //Se comprueba el nombre sin la extensión de la compresión.
+        int longitud = strlen(nombre) - strlen(compresion_extension(formato));
+        char sin_extension[longitud+1];
+        memcpy(sin_extension, nombre, longitud);
+        sin_extension[longitud] = '\0';
+        to_return = lector_es_archivo_txt(sin_extension);
+    }
+
+    return to_return;
+}
+
+//----COLA DE BLOQUES----
+
+#ifdef COMPRESION_CON_FORMATOS
+
+/**
+ * @brief Operación Devuelve el próximo bloque a llenar. Con hilo propio, espera a que haya un bloque libre.
+*/
+static char *aux_bloque_libre(struct descompresion *D){
+    char *to_return = D->bloques[0];
+
+#ifdef COMPRESION_CON_HILOS
+    if (D->con_hilo==TRUE){
+        pthread_mutex_lock(&(D->mutex));
+        while (D->producidos - D->consumidos == COMPRESION_BLOQUES){
+            pthread_cond_wait(&(D->hay_lugar), &(D->mutex));
+        }
+        pthread_mutex_unlock(&(D->mutex));
+        to_return = D->bloques[D->producidos % COMPRESION_BLOQUES];
+    }
+#endif
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Publica el bloque obtenido con aux_bloque_libre, que contiene 'n' bytes. Sin hilo propio, lo entrega
+ * directamente al invocador.
+*/
+static void aux_publicar_bloque(struct descompresion *D, unsigned long n){
+#ifdef COMPRESION_CON_HILOS
+    if (D->con_hilo==TRUE){
+        pthread_mutex_lock(&(D->mutex));
+        D->longitudes[D->producidos % COMPRESION_BLOQUES] = n;
+        D->producidos = D->producidos + 1;
+        pthread_cond_signal(&(D->hay_bloque));
+        pthread_mutex_unlock(&(D->mutex));
+    }
+    else
+#endif
+    {
+        D->entregar(D->bloques[0], n, D->contexto);
+    }
+}
+
+/**
+ * @brief Operación Informa que el contenido está dañado y finaliza el programa.
+ * @throw ERROR_COMPRESION_DATOS.
+*/
+static void aux_error_datos(){
+    printf("Error %d: El contenido comprimido no es valido o esta incompleto.\n", ERROR_COMPRESION_DATOS);
+    exit(ERROR_COMPRESION_DATOS);
+}
+
+/**
+ * @brief Operación Dada la entrada que sigue al fin de un miembro o trama, consume los bytes nulos de relleno con los que
+ * algunas herramientas completan el archivo (un miembro o trama nunca comienza con un byte nulo). Una vez comenzado el
+ * relleno, el resto del contenido, incluidas las partes siguientes, debe ser nulo.
+ * @param D Puntero al estado de la descompresión.
+ * @param entrada Puntero a los bytes pendientes de la parte actual.
+ * @param n Cantidad de bytes pendientes.
+ * @throw ERROR_COMPRESION_DATOS si tras un byte de relleno hay un byte no nulo.
+ * @return Cantidad de bytes consumidos: 0 o 'n'.
+*/
+static unsigned long aux_saltar_relleno(struct descompresion *D, char *entrada, unsigned long n){
+    unsigned long to_return = 0;
+
+    if (n>0 && (D->relleno==TRUE || entrada[0]=='\0')){
+        D->relleno = TRUE;
+        for (unsigned long i=0; i<n; i++){
+            if (entrada[i]!='\0'){
+                aux_error_datos();
+            }
+        }
+        to_return = n;
+    }
+
+    return to_return;
+}
+#endif
+
+//----DESCOMPRESORES----
+
+#ifdef COMPRESION_CON_ZLIB
+/**
+ * @brief Operación Descomprime una parte de un contenido gzip (o zlib), admitiendo varios miembros concatenados. Lo que
+ * quede pendiente del último miembro se completa con la parte siguiente.
+ * @throw ERROR_COMPRESION_DATOS si el contenido no es válido.
+*/
+static void aux_descomprimir_gzip(struct descompresion *D, char *contenido, unsigned long n){
+    int lleno = TRUE;
+
+    D->z.next_in = (Bytef*) contenido;
+    D->z.avail_in = (uInt) n;
+    //Se continúa mientras quede entrada o el último bloque se haya llenado (puede haber salida pendiente).
+    while (D->z.avail_in>0 || (lleno==TRUE && D->en_trama==TRUE)){
+        //Si quedan bytes tras el fin de un miembro, son relleno o comienza otro.
+        if (D->en_trama==FALSE){
+            unsigned long saltados = aux_saltar_relleno(D, (char*) D->z.next_in, D->z.avail_in);
+            D->z.next_in = D->z.next_in + saltados;
+            D->z.avail_in = D->z.avail_in - (uInt) saltados;
+            if (D->z.avail_in>0){
+                inflateReset(&(D->z));
+                D->en_trama = TRUE;
+            }
+        }
+        if (D->en_trama==TRUE){
+            char *bloque = aux_bloque_libre(D);
+            D->z.next_out = (Bytef*) bloque;
+            D->z.avail_out = COMPRESION_TAMANIO_BLOQUE;
+            int resultado = inflate(&(D->z), Z_NO_FLUSH);
+            if (resultado==Z_STREAM_END){
+                D->en_trama = FALSE;
+            }
+            else if (resultado!=Z_OK && resultado!=Z_BUF_ERROR){
+                aux_error_datos();
+            }
+            lleno = (D->z.avail_out==0) ? TRUE : FALSE;
+            if (D->z.avail_out<COMPRESION_TAMANIO_BLOQUE){
+                aux_publicar_bloque(D, COMPRESION_TAMANIO_BLOQUE - D->z.avail_out);
+            }
+        }
+    }
+}
+#endif
+
+#ifdef COMPRESION_CON_ZSTD
+/**
+ * @brief Operación Descomprime una parte de un contenido zstd, admitiendo varias tramas concatenadas. Lo que quede
+ * pendiente de la última trama se completa con la parte siguiente.
+ * @throw ERROR_COMPRESION_DATOS si el contenido no es válido.
+*/
+static void aux_descomprimir_zstd(struct descompresion *D, char *contenido, unsigned long n){
+    ZSTD_inBuffer entrada = {contenido, n, 0};
+    ZSTD_outBuffer salida;
+    int lleno = TRUE;
+
+    //Se continúa mientras quede entrada o el último bloque se haya llenado (puede haber salida pendiente).
+    while (entrada.pos<entrada.size || (lleno==TRUE && D->en_trama==TRUE)){
+        //Si quedan bytes tras el fin de una trama, pueden ser relleno.
+        if (D->en_trama==FALSE){
+            entrada.pos = entrada.pos + aux_saltar_relleno(D, contenido + entrada.pos, entrada.size - entrada.pos);
+        }
+        if (entrada.pos<entrada.size || D->en_trama==TRUE){
+            salida.dst = aux_bloque_libre(D);
+            salida.size = COMPRESION_TAMANIO_BLOQUE;
+            salida.pos = 0;
+            size_t pendiente = ZSTD_decompressStream(D->zstd, &salida, &entrada);
+            if (ZSTD_isError(pendiente)){
+                aux_error_datos();
+            }
+            D->en_trama = (pendiente!=0) ? TRUE : FALSE;
+            lleno = (salida.pos==salida.size) ? TRUE : FALSE;
+            if (salida.pos>0){
+                aux_publicar_bloque(D, salida.pos);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Operación Inicializa el descompresor del formato del contenido.
+ * @throw ERROR_COMPRESION_MEMORIA si no se pudo reservar memoria para el descompresor.
+*/
+static void aux_iniciar_descompresor(struct descompresion *D){
+    D->en_trama = FALSE;
+    D->relleno = FALSE;
+#ifdef COMPRESION_CON_ZLIB
+    if (D->formato==COMPRESION_GZIP){
+        memset(&(D->z), 0, sizeof(z_stream));
+        //Con 15+32 bits de ventana, zlib detecta por sí mismo si el encabezado es gzip o zlib.
+        if (inflateInit2(&(D->z), 15 + 32)!=Z_OK){
+            printf("Error %d: No se pudo reservar memoria para la descompresion.\n", ERROR_COMPRESION_MEMORIA);
+            exit(ERROR_COMPRESION_MEMORIA);
+        }
+    }
+#endif
+#ifdef COMPRESION_CON_ZSTD
+    if (D->formato==COMPRESION_ZSTD){
+        D->zstd = ZSTD_createDCtx();
+        if (D->zstd==NULL){
+            printf("Error %d: No se pudo reservar memoria para la descompresion.\n", ERROR_COMPRESION_MEMORIA);
+            exit(ERROR_COMPRESION_MEMORIA);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Operación Descomprime una parte del contenido según su formato, llenando y publicando bloques.
+*/
+static void aux_descomprimir_parte(struct descompresion *D, char *contenido, unsigned long n){
+#ifndef COMPRESION_CON_FORMATOS
+    (void) D;
+    (void) contenido;
+    (void) n;
+#endif
+#ifdef COMPRESION_CON_ZLIB
+    if (D->formato==COMPRESION_GZIP){
+        aux_descomprimir_gzip(D, contenido, n);
+    }
+#endif
+#ifdef COMPRESION_CON_ZSTD
+    if (D->formato==COMPRESION_ZSTD){
+        aux_descomprimir_zstd(D, contenido, n);
+    }
+#endif
+}
+
+/**
+ * @brief Operación Libera el descompresor, comprobando que el contenido no haya quedado truncado.
+ * @throw ERROR_COMPRESION_DATOS si el último miembro o trama no terminó.
+*/
+static void aux_finalizar_descompresor(struct descompresion *D){
+#ifdef COMPRESION_CON_ZLIB
+    if (D->formato==COMPRESION_GZIP){
+        inflateEnd(&(D->z));
+    }
+#endif
+#ifdef COMPRESION_CON_ZSTD
+    if (D->formato==COMPRESION_ZSTD){
+        ZSTD_freeDCtx(D->zstd);
+    }
+#endif
+#ifdef COMPRESION_CON_FORMATOS
+    if (D->en_trama==TRUE){
+        aux_error_datos();
+    }
+#endif
+}
+
+/**
+ * @brief Operación Descomprime el contenido completo según su formato, llenando y publicando bloques.
+*/
+static void aux_descomprimir(struct descompresion *D){
+    aux_iniciar_descompresor(D);
+    aux_descomprimir_parte(D, D->contenido, D->n);
+    aux_finalizar_descompresor(D);
+}
+
+#ifdef COMPRESION_CON_HILOS
+/**
+ * @brief Operación Función que ejecuta el hilo descompresor.
+*/
+static void *aux_ejecutar_descompresor(void *contexto){
+    struct descompresion *D = (struct descompresion*) contexto;
+
+    traza_comenzar("descomprimir", NULL);
+    aux_descomprimir(D);
+    traza_terminar("descomprimir");
+    pthread_mutex_lock(&(D->mutex));
+    D->terminado = TRUE;
+    pthread_cond_signal(&(D->hay_bloque));
+    pthread_mutex_unlock(&(D->mutex));
+
+    return NULL;
+}
+#endif
+
+void compresion_descomprimir(char *contenido, unsigned long n, int formato, funcion_bloque_t entregar, void *contexto){
+    struct descompresion D;
+    int cant_bloques = 1;
+
+    D.contenido = contenido;
+    D.n = n;
+    D.formato = formato;
+    D.producidos = 0;
+    D.consumidos = 0;
+    D.terminado = FALSE;
+    D.con_hilo = FALSE;
+    D.entregar = entregar;
+    D.contexto = contexto;
+#ifdef COMPRESION_CON_HILOS
+    if (n>=COMPRESION_MINIMO_HILO){
+        D.con_hilo = TRUE;
+        cant_bloques = COMPRESION_BLOQUES;
+    }
+#endif
+    for (int i=0; i<cant_bloques; i++){
+        D.bloques[i] = (char*) malloc(COMPRESION_TAMANIO_BLOQUE);
+        if (D.bloques[i]==NULL){
+            printf("Error %d: No se pudo reservar memoria para la descompresion.\n", ERROR_COMPRESION_MEMORIA);
+            exit(ERROR_COMPRESION_MEMORIA);
+        }
+    }
+
+#ifdef COMPRESION_CON_HILOS
+    if (D.con_hilo==TRUE){
+        pthread_t descompresor;
+        int quedan = TRUE;
+
+        pthread_mutex_init(&(D.mutex), NULL);
+        pthread_cond_init(&(D.hay_bloque), NULL);
+        pthread_cond_init(&(D.hay_lugar), NULL);
+        pthread_create(&descompresor, NULL, aux_ejecutar_descompresor, &D);
+
+        //Mientras el descompresor llena los bloques siguientes, se entrega cada bloque lleno al invocador.
+        while (quedan==TRUE){
+            pthread_mutex_lock(&(D.mutex));
+            //En la traza, esperar un bloque indica que la descompresión es más lenta que el conteo.
+            if (D.consumidos==D.producidos && D.terminado==FALSE){
+                traza_comenzar("esperar bloque", NULL);
+                while (D.consumidos==D.producidos && D.terminado==FALSE){
+                    pthread_cond_wait(&(D.hay_bloque), &(D.mutex));
+                }
+                traza_terminar("esperar bloque");
+            }
+            quedan = (D.consumidos<D.producidos) ? TRUE : FALSE;
+            pthread_mutex_unlock(&(D.mutex));
+
+            if (quedan==TRUE){
+                int i = D.consumidos % COMPRESION_BLOQUES;
+                entregar(D.bloques[i], D.longitudes[i], contexto);
+                pthread_mutex_lock(&(D.mutex));
+                D.consumidos = D.consumidos + 1;
+                pthread_cond_signal(&(D.hay_lugar));
+                pthread_mutex_unlock(&(D.mutex));
+            }
+        }
+
+        pthread_join(descompresor, NULL);
+        pthread_mutex_destroy(&(D.mutex));
+        pthread_cond_destroy(&(D.hay_bloque));
+        pthread_cond_destroy(&(D.hay_lugar));
+    }
+    else
+#endif
+    {
+        aux_descomprimir(&D);
+    }
+
+    for (int i=0; i<cant_bloques; i++){
+        free(D.bloques[i]);
+    }
+}
+
+descompresion_t *compresion_flujo_crear(int formato, funcion_bloque_t entregar, void *contexto){
+    descompresion_t *to_return = (descompresion_t*) malloc(sizeof(descompresion_t));
+
+    if (to_return!=NULL){
+        to_return->bloques[0] = (char*) malloc(COMPRESION_TAMANIO_BLOQUE);
+    }
+    if (to_return==NULL || to_return->bloques[0]==NULL){
+        printf("Error %d: No se pudo reservar memoria para la descompresion.\n", ERROR_COMPRESION_MEMORIA);
+        exit(ERROR_COMPRESION_MEMORIA);
+    }
+    to_return->contenido = NULL;
+    to_return->n = 0;
+    to_return->formato = formato;
+    to_return->producidos = 0;
+    to_return->consumidos = 0;
+    to_return->terminado = FALSE;
+    to_return->con_hilo = FALSE;
+    to_return->entregar = entregar;
+    to_return->contexto = contexto;
+    aux_iniciar_descompresor(to_return);
+
+    return to_return;
+}
+
+void compresion_flujo_procesar(descompresion_t *D, char *contenido, unsigned long n){
+    aux_descomprimir_parte(D, contenido, n);
+}
+
+void compresion_flujo_finalizar(descompresion_t **D){
+    aux_finalizar_descompresor(*D);
+    free((*D)->bloques[0]);
+    free(*D);
+    *D = NULL;
+}
+
+//----ARCHIVOS DE SALIDA----
+
+#if defined(__GLIBC__) && defined(COMPRESION_CON_ZLIB)
+/**
+ * @brief Operación Función de escritura del archivo gzip: comprime los bytes dados.
+*/
+static ssize_t aux_escribir_gzip(void *cookie, const char *datos, size_t n){
+    ssize_t to_return = n;
+    if (n>0){
+        to_return = gzwrite((gzFile) cookie, datos, (unsigned) n);
+        //gzwrite devuelve 0 ante un error, que stdio espera como -1.
+        to_return = (to_return==0) ? -1 : to_return;
+    }
+    return to_return;
+}
+
+/**
+ * @brief Operación Función de cierre del archivo gzip: finaliza la compresión y cierra el archivo.
+*/
+static int aux_cerrar_gzip(void *cookie){
+    return (gzclose((gzFile) cookie)==Z_OK) ? 0 : EOF;
+}
+#endif
+
+#if defined(__GLIBC__) && defined(COMPRESION_CON_ZSTD)
+/**
+ * @struct salida_zstd
+ * @brief Modela un archivo de salida zstd: el archivo subyacente, el contexto de compresión y su búfer de salida.
+*/
+struct salida_zstd {
+    FILE *archivo; //Archivo donde se escribe el contenido comprimido.
+    ZSTD_CCtx *contexto; //Contexto de compresión.
+    char *bufer; //Búfer con el contenido comprimido a escribir.
+    size_t capacidad; //Capacidad del búfer.
+};
+
+/**
+ * @brief Operación Comprime la entrada dada con la directiva dada y escribe lo producido.
+ * @return 0 si se completó la directiva, o -1 ante un error.
+*/
+static int aux_comprimir_zstd(struct salida_zstd *Z, ZSTD_inBuffer *entrada, ZSTD_EndDirective directiva){
+    int to_return = 0;
+    size_t pendiente = 1;
+
+    //Con ZSTD_e_continue se consume toda la entrada; con ZSTD_e_end, además, se vuelca lo pendiente hasta cerrar la trama.
+    while (to_return==0 && (entrada->pos<entrada->size || (directiva==ZSTD_e_end && pendiente!=0))){
+        ZSTD_outBuffer salida = {Z->bufer, Z->capacidad, 0};
+        pendiente = ZSTD_compressStream2(Z->contexto, &salida, entrada, directiva);
+        if (ZSTD_isError(pendiente) || fwrite(Z->bufer, 1, salida.pos, Z->archivo)!=salida.pos){
+            to_return = -1;
+        }
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Función de escritura del archivo zstd: comprime los bytes dados.
+*/
+static ssize_t aux_escribir_zstd(void *cookie, const char *datos, size_t n){
+    ZSTD_inBuffer entrada = {datos, n, 0};
+    return (aux_comprimir_zstd((struct salida_zstd*) cookie, &entrada, ZSTD_e_continue)==0) ? (ssize_t) n : -1;
+}
+
+/**
+ * @brief Operación Función de cierre del archivo zstd: cierra la trama y el archivo.
+*/
+static int aux_cerrar_zstd(void *cookie){
+    struct salida_zstd *Z = (struct salida_zstd*) cookie;
+    ZSTD_inBuffer entrada = {NULL, 0, 0};
+    int to_return = aux_comprimir_zstd(Z, &entrada, ZSTD_e_end);
+
+    if (fclose(Z->archivo)!=0){
+        to_return = EOF;
+    }
+    ZSTD_freeCCtx(Z->contexto);
+    free(Z->bufer);
+    free(Z);
+
+    return to_return;
+}
+#endif
+
+FILE *compresion_abrir_salida(char *path, int formato){
+    FILE *to_return = NULL;
+
+    if (formato==COMPRESION_NINGUNA){
+        to_return = fopen(path, "w");
+    }
+#if defined(__GLIBC__) && defined(COMPRESION_CON_ZLIB)
+    else if (formato==COMPRESION_GZIP){
+        gzFile archivo = gzopen(path, "wb");
+        if (archivo!=NULL){
+            cookie_io_functions_t funciones = {NULL, aux_escribir_gzip, NULL, aux_cerrar_gzip};
+            to_return = fopencookie(archivo, "w", funciones);
+            if (to_return==NULL){
+                gzclose(archivo);
+            }
+        }
+    }
+#endif
+#if defined(__GLIBC__) && defined(COMPRESION_CON_ZSTD)
+    else if (formato==COMPRESION_ZSTD){
+        struct salida_zstd *Z = (struct salida_zstd*) malloc(sizeof(struct salida_zstd));
+        if (Z==NULL){
+            printf("Error %d: No se pudo reservar memoria para la compresion.\n", ERROR_COMPRESION_MEMORIA);
+            exit(ERROR_COMPRESION_MEMORIA);
+        }
+        Z->archivo = fopen(path, "wb");
+        Z->contexto = ZSTD_createCCtx();
+        Z->capacidad = ZSTD_CStreamOutSize();
+        Z->bufer = (char*) malloc(Z->capacidad);
+        if (Z->contexto==NULL || Z->bufer==NULL){
+            printf("Error %d: No se pudo reservar memoria para la compresion.\n", ERROR_COMPRESION_MEMORIA);
+            exit(ERROR_COMPRESION_MEMORIA);
+        }
+        if (Z->archivo!=NULL){
+            cookie_io_functions_t funciones = {NULL, aux_escribir_zstd, NULL, aux_cerrar_zstd};
+            to_return = fopencookie(Z, "w", funciones);
+        }
+        if (to_return==NULL){
+            if (Z->archivo!=NULL){
+                fclose(Z->archivo);
+            }
+            ZSTD_freeCCtx(Z->contexto);
+            free(Z->bufer);
+            free(Z);
+        }
+    }
+#endif
+
+    return to_return;
+}
@@ -0,0 +1,114 @@
+/**
+* @file compresion.h
+* @brief Archivo encabezado del TDA Compresion.
+* Permite contar archivos de texto comprimidos (.txt.gz y .txt.zst) sin descomprimirlos a disco y escribir los archivos
+* de salida comprimidos. El soporte de cada formato se incluye al compilar: gzip con COMPRESION_CON_ZLIB (enlazando con
+* -lz) y zstd con COMPRESION_CON_ZSTD (enlazando con -lzstd). Los formatos no incluidos no se reconocen.
+* Con hilos POSIX, la descompresión de los archivos grandes se realiza en un hilo propio, que entrega bloques al hilo
+* invocador mientras este cuenta los anteriores.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef COMPRESION_H_INCLUDED
+#define COMPRESION_H_INCLUDED
+
+#include <stdio.h>
+
+#define ERROR_COMPRESION_DATOS -27
+#define ERROR_COMPRESION_MEMORIA -28
+
+//Formatos de compresión.
+#define COMPRESION_NINGUNA 0
+#define COMPRESION_GZIP 1
+#define COMPRESION_ZSTD 2
+
+//Tamaño de los bloques descomprimidos que se entregan al invocador.
+#define COMPRESION_TAMANIO_BLOQUE (1 << 18)
+
+/**
+ * @typedef void(funcion_bloque_t)
+ * @brief Plantilla de función que recibe cada bloque descomprimido. El bloque solo es válido durante la invocación.
+*/
+typedef void (funcion_bloque_t)(char *bloque, unsigned long n, void *contexto);
+
+//Estado de la descompresión de un contenido que se recibe por partes (ver compresion_flujo_crear).
+struct descompresion;
+typedef struct descompresion descompresion_t;
+
+/**
+ * @brief Devuelve TRUE si el formato dado se incluyó al compilar (COMPRESION_NINGUNA siempre lo está).
+*/
+extern int compresion_disponible(int formato);
+
+/**
+ * @brief Devuelve el formato de compresión de un archivo según su extensión (.gz o .zst), o COMPRESION_NINGUNA.
+*/
+extern int compresion_formato_de_nombre(char *nombre);
+
+/**
+ * @brief Devuelve la extensión que corresponde al formato dado ("" para COMPRESION_NINGUNA).
+*/
+extern char *compresion_extension(int formato);
+
+/**
+ * @brief Comprueba si el nombre dado es el de un archivo de texto que puede contarse: .txt, o bien .txt.gz o .txt.zst si
+ * el formato correspondiente está disponible.
+ * @param nombre Puntero a cadena de caracteres.
+ * @return TRUE o FALSE.
+*/
+extern int compresion_es_archivo_txt(char *nombre);
+
+/**
+ * @brief Descomprime el contenido dado y entrega el resultado a 'entregar' en bloques de a lo sumo
+ * COMPRESION_TAMANIO_BLOQUE bytes, en orden. Admite archivos con varios miembros (gzip) o tramas (zstd) concatenados.
+ * Como gzip -d, un contenido vacío se considera un archivo vacío y se ignoran los bytes nulos de relleno que sigan al
+ * último miembro o trama.
+ * @param contenido Puntero al contenido comprimido.
+ * @param n Cantidad de bytes del contenido.
+ * @param formato COMPRESION_GZIP o COMPRESION_ZSTD (debe estar disponible).
+ * @param entregar Función que recibe cada bloque, siempre en el hilo invocador.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'entregar'.
+ * @throw ERROR_COMPRESION_DATOS si el contenido no es válido o está truncado.
+ * @throw ERROR_COMPRESION_MEMORIA si no se pudo reservar memoria para los bloques.
+*/
+extern void compresion_descomprimir(char *contenido, unsigned long n, int formato, funcion_bloque_t entregar, void *contexto);
+
+/**
+ * @brief Crea el estado para descomprimir un contenido que se recibe por partes, por ejemplo un archivo que no se lee
+ * completo en memoria. Los bloques se entregan como en compresion_descomprimir, pero siempre desde el hilo invocador.
+ * @param formato COMPRESION_GZIP o COMPRESION_ZSTD (debe estar disponible).
+ * @param entregar Función que recibe cada bloque descomprimido.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'entregar'.
+ * @throw ERROR_COMPRESION_MEMORIA si no se pudo reservar memoria para el descompresor.
+ * @return Puntero al estado de la descompresión.
+*/
+extern descompresion_t *compresion_flujo_crear(int formato, funcion_bloque_t entregar, void *contexto);
+
+/**
+ * @brief Descomprime la parte siguiente del contenido, entregando los bloques que se completen con ella.
+ * @param D Puntero al estado de la descompresión.
+ * @param contenido Puntero a los bytes de la parte.
+ * @param n Cantidad de bytes de la parte.
+ * @throw ERROR_COMPRESION_DATOS si el contenido no es válido.
+*/
+extern void compresion_flujo_procesar(descompresion_t *D, char *contenido, unsigned long n);
+
+/**
+ * @brief Finaliza la descompresión y libera su estado.
+ * @param D Puntero al puntero del estado, que queda en NULL.
+ * @throw ERROR_COMPRESION_DATOS si el contenido quedó truncado.
+*/
+extern void compresion_flujo_finalizar(descompresion_t **D);
+
+/**
+ * @brief Crea el archivo de la ruta dada para escribir en él con las funciones de stdio, comprimiendo lo escrito en el
+ * formato dado. La compresión finaliza al cerrarlo con fclose. El manejador no tiene descriptor propio (fileno
+ * devuelve -1). Para formatos comprimidos requiere glibc; con COMPRESION_NINGUNA equivale a fopen(path, "w").
+ * @param path Ruta del archivo.
+ * @param formato Formato de compresión (debe estar disponible).
+ * @return Manejador del archivo, o NULL si no se pudo crear.
+*/
+extern FILE *compresion_abrir_salida(char *path, int formato);
+
+#endif // COMPRESION_H_INCLUDED
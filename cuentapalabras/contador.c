@@ -0,0 +1,185 @@
+/**
+* @file contador.c
+* @brief Implementación del TDA Contador.
+* La tabla auxiliar es una tabla hash de direccionamiento abierto (sondeo lineal) cuyas claves son las direcciones
+* de los campos desbordados. Solo los contadores que superan CONTADOR_MAXIMO ocupan lugar en ella.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "define.h"
+#include "contador.h"
+
+/**
+ * @struct entrada_contador
+ * @brief Modela una entrada de la tabla: la dirección del campo desbordado y su valor completo.
+*/
+struct entrada_contador {
+    contador_t *clave;
+    long long valor;
+};
+
+/**
+ * @struct tabla_contadores
+ * @brief Modela la tabla hash de contadores desbordados. La capacidad siempre es una potencia de 2.
+*/
+struct tabla_contadores {
+    struct entrada_contador *entradas;
+    unsigned long capacidad;
+    unsigned long cantidad;
+};
+
+/**
+ * @brief Calcula la posición inicial de la clave en una tabla de la capacidad dada.
+*/
+static unsigned long aux_posicion(contador_t *clave, unsigned long capacidad){
+    uintptr_t x = (uintptr_t) clave;
+    x = x ^ (x>>17);
+    x = x * 0x9E3779B1u;
+    return (unsigned long) (x ^ (x>>15)) & (capacidad-1);
+}
+
+/**
+ * @brief Devuelve la entrada correspondiente a la clave, o la entrada libre donde debería insertarse.
+*/
+static struct entrada_contador *aux_buscar(tabla_contadores_t *t, contador_t *clave){
+    unsigned long i = aux_posicion(clave, t->capacidad);
+
+    while (t->entradas[i].clave!=NULL && t->entradas[i].clave!=clave){
+        i = (i+1) & (t->capacidad-1);
+    }
+
+    return &(t->entradas[i]);
+}
+
+/**
+ * @brief Reserva las entradas de la tabla con la capacidad dada, vacías.
+ * @throw ERROR_CONTADOR_MEMORIA si no se pudo reservar memoria.
+*/
+static struct entrada_contador *aux_reservar_entradas(unsigned long capacidad){
+    struct entrada_contador *entradas = (struct entrada_contador*) calloc(capacidad, sizeof(struct entrada_contador));
+    if (entradas==NULL){
+        printf("Error %d: No se pudo reservar memoria para la tabla de contadores.\n", ERROR_CONTADOR_MEMORIA);
+        exit(ERROR_CONTADOR_MEMORIA);
+    }
+    return entradas;
+}
+
+/**
+ * @brief Duplica la capacidad de la tabla reubicando sus entradas.
+*/
+static void aux_ampliar(tabla_contadores_t *t){
+    struct entrada_contador *anteriores = t->entradas;
+    unsigned long capacidad_anterior = t->capacidad;
+
+    t->capacidad = 2*capacidad_anterior;
+    t->entradas = aux_reservar_entradas(t->capacidad);
+    for (unsigned long i=0; i<capacidad_anterior; i++){
+        if (anteriores[i].clave!=NULL){
+            *aux_buscar(t, anteriores[i].clave) = anteriores[i];
+        }
+    }
+    free(anteriores);
+}
+
+void contador_desbordar(tabla_contadores_t **t, contador_t *c, long long cantidad){
+    if (*t==NULL){
+        *t = (tabla_contadores_t*) malloc(sizeof(tabla_contadores_t));
+        if (*t==NULL){
+            printf("Error %d: No se pudo reservar memoria para la tabla de contadores.\n", ERROR_CONTADOR_MEMORIA);
+            exit(ERROR_CONTADOR_MEMORIA);
+        }
+        (*t)->capacidad = 16;
+        (*t)->cantidad = 0;
+        (*t)->entradas = aux_reservar_entradas(16);
+    }
+    //Se mantiene la tabla a lo sumo a la mitad de su capacidad.
+    if (2*((*t)->cantidad+1) > (*t)->capacidad){
+        aux_ampliar(*t);
+    }
+
+    struct entrada_contador *e = aux_buscar(*t, c);
+    if (e->clave==NULL){
+        //El contador desborda por primera vez: su valor actual se traslada a la tabla.
+        e->clave = c;
+        e->valor = *c;
+        (*t)->cantidad = (*t)->cantidad + 1;
+        *c = CONTADOR_DESBORDADO;
+    }
+    e->valor = e->valor + cantidad;
+}
+
+long long contador_valor_desbordado(tabla_contadores_t *t, contador_t *c){
+    long long to_return = *c;
+
+    if (t!=NULL){
+        to_return = aux_buscar(t, c)->valor;
+    }
+
+    return to_return;
+}
+
+void contador_quitar(tabla_contadores_t *t, contador_t *c){
+    if (*c==CONTADOR_DESBORDADO && t!=NULL){
+        struct entrada_contador *e = aux_buscar(t, c);
+        unsigned long libre = (unsigned long) (e - t->entradas);
+        unsigned long i = libre;
+
+        if (e->clave==c){
+            e->clave = NULL;
+            t->cantidad = t->cantidad - 1;
+            //Las entradas siguientes del mismo grupo se corren al lugar liberado si su posición inicial no queda
+            //entre dicho lugar y la entrada, de modo que aux_buscar las siga encontrando sin marcas de borrado.
+            i = (i+1) & (t->capacidad-1);
+            while (t->entradas[i].clave!=NULL){
+                unsigned long inicial = aux_posicion(t->entradas[i].clave, t->capacidad);
+                if (((i - inicial) & (t->capacidad-1)) >= ((i - libre) & (t->capacidad-1))){
+                    t->entradas[libre] = t->entradas[i];
+                    t->entradas[i].clave = NULL;
+                    libre = i;
+                }
+                i = (i+1) & (t->capacidad-1);
+            }
+        }
+    }
+}
+
+tabla_contadores_t *contador_copiar_tabla(tabla_contadores_t *t){
+    tabla_contadores_t *to_return = NULL;
+
+    if (t!=NULL){
+        to_return = (tabla_contadores_t*) malloc(sizeof(tabla_contadores_t));
+        if (to_return==NULL){
+            printf("Error %d: No se pudo reservar memoria para la tabla de contadores.\n", ERROR_CONTADOR_MEMORIA);
+            exit(ERROR_CONTADOR_MEMORIA);
+        }
+        to_return->capacidad = t->capacidad;
+        to_return->cantidad = t->cantidad;
+        to_return->entradas = aux_reservar_entradas(t->capacidad);
+        memcpy(to_return->entradas, t->entradas, t->capacidad*sizeof(struct entrada_contador));
+    }
+
+    return to_return;
+}
+
+unsigned long contador_memoria(tabla_contadores_t *t){
+    unsigned long to_return = 0;
+
+    if (t!=NULL){
+        to_return = sizeof(tabla_contadores_t) + t->capacidad*sizeof(struct entrada_contador);
+    }
+
+    return to_return;
+}
+
+void contador_eliminar_tabla(tabla_contadores_t **t){
+    if (*t!=NULL){
+        free((*t)->entradas);
+        free(*t);
+        *t = NULL;
+    }
+}
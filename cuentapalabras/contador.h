@@ -0,0 +1,105 @@
+/**
+* @file contador.h
+* @brief Archivo encabezado del TDA Contador.
+* Un contador se almacena dentro de cada nodo en un campo angosto de 16 bits (contador_t). Cuando su valor no entra en
+* dicho campo, el campo queda marcado como desbordado y el valor completo de 64 bits pasa a una tabla auxiliar, indexada
+* por la dirección del campo. De este modo las cantidades no se desbordan y el campo ocupa el relleno que deja el resto
+* del encabezado del nodo antes de sus punteros, en lugar de agregar una palabra de 8 bytes a cada nodo.
+* El incremento y la lectura de los contadores que entran en el campo se resuelven en línea; solo los desbordados
+* acceden a la tabla.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef CONTADOR_H_INCLUDED
+#define CONTADOR_H_INCLUDED
+
+#define ERROR_CONTADOR_MEMORIA -15
+
+//Mayor valor que se almacena dentro del nodo. Puede redefinirse al compilar para ejercitar la tabla auxiliar.
+#ifndef CONTADOR_MAXIMO
+#define CONTADOR_MAXIMO 0xFFFEu
+#endif
+//Marca de un contador cuyo valor se encuentra en la tabla auxiliar.
+#define CONTADOR_DESBORDADO (CONTADOR_MAXIMO + 1u)
+
+/**
+ * @typedef contador_t
+ * @brief Campo angosto de un contador dentro de un nodo.
+*/
+typedef unsigned short contador_t;
+
+struct tabla_contadores;
+typedef struct tabla_contadores tabla_contadores_t;
+
+/**
+ * @brief Incrementa en 'cantidad' el contador 'c' en la tabla '*t', trasladándolo a ella si aún no está desbordado.
+ * La tabla se crea la primera vez que es necesaria, por lo que '*t' puede ser NULL. Se invoca desde contador_sumar.
+ * @throw ERROR_CONTADOR_MEMORIA si no se pudo reservar memoria para la tabla.
+*/
+extern void contador_desbordar(tabla_contadores_t **t, contador_t *c, long long cantidad);
+
+/**
+ * @brief Devuelve el valor completo del contador desbordado 'c'. Se invoca desde contador_valor.
+*/
+extern long long contador_valor_desbordado(tabla_contadores_t *t, contador_t *c);
+
+/**
+ * @brief Incrementa en 'cantidad' el contador 'c', trasladándolo a la tabla '*t' si desborda su campo.
+ * La tabla se crea la primera vez que es necesaria, por lo que '*t' puede ser NULL.
+ * @param t Puntero al puntero de la tabla auxiliar.
+ * @param c Puntero al campo del contador.
+ * @param cantidad Entero positivo a sumar.
+ * @throw ERROR_CONTADOR_MEMORIA si no se pudo reservar memoria para la tabla.
+*/
+static inline void contador_sumar(tabla_contadores_t **t, contador_t *c, long long cantidad){
+    ///Caso común: el nuevo valor entra en el campo del nodo.
+    if (*c!=CONTADOR_DESBORDADO && cantidad <= (long long) (CONTADOR_MAXIMO - *c)){
+        *c = (contador_t) (*c + cantidad);
+    }
+    else{
+        contador_desbordar(t, c, cantidad);
+    }
+}
+
+/**
+ * @brief Devuelve el valor completo del contador 'c'.
+ * @param t Puntero a la tabla auxiliar (puede ser NULL).
+ * @param c Puntero al campo del contador.
+ * @return Entero mayor o igual a 0.
+*/
+static inline long long contador_valor(tabla_contadores_t *t, contador_t *c){
+    return (*c!=CONTADOR_DESBORDADO) ? (long long) *c : contador_valor_desbordado(t, c);
+}
+
+/**
+ * @brief Quita de la tabla el contador desbordado 'c', cuyo campo deja de usarse (por ejemplo, porque el nodo se copió
+ * a otra dirección). Si 'c' no está desbordado, no tiene efecto.
+ * @param t Puntero a la tabla auxiliar (puede ser NULL).
+ * @param c Puntero al campo del contador.
+*/
+extern void contador_quitar(tabla_contadores_t *t, contador_t *c);
+
+/**
+ * @brief Devuelve una copia de la tabla auxiliar, con las mismas claves y valores.
+ * @param t Puntero a la tabla auxiliar (puede ser NULL).
+ * @throw ERROR_CONTADOR_MEMORIA si no se pudo reservar memoria para la copia.
+ * @return Puntero a la copia, o NULL si 't' es NULL.
+*/
+extern tabla_contadores_t *contador_copiar_tabla(tabla_contadores_t *t);
+
+/**
+ * @brief Devuelve la cantidad de bytes reservados por la tabla auxiliar.
+ * @param t Puntero a la tabla auxiliar (puede ser NULL).
+ * @return Entero mayor o igual a 0.
+*/
+extern unsigned long contador_memoria(tabla_contadores_t *t);
+
+/**
+ * @brief Elimina la tabla auxiliar liberando su memoria. Luego de la invocación '*t' es NULL.
+ * Debe invocarse cuando se liberan los nodos cuyos contadores pudieran estar en ella.
+ * @param t Puntero al puntero de la tabla auxiliar.
+*/
+extern void contador_eliminar_tabla(tabla_contadores_t **t);
+
+#endif // CONTADOR_H_INCLUDED
@@ -0,0 +1,47 @@
+/**
+* @file conteo.c
+* @brief Implementación del TDA Conteo.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "define.h"
+#include "lector.h"
+#include "conteo.h"
+
+/**
+ * @struct conteo_bufer
+ * @brief Modela el multiset donde se cuentan las palabras de un búfer y la cantidad de palabras contadas.
+*/
+struct conteo_bufer {
+    multiset_t *m;
+    unsigned long cantidad;
+};
+
+/**
+ * @brief Función que recibe cada palabra del búfer y la inserta en el multiset del contexto.
+*/
+static void aux_contar_palabra(const char *palabra, unsigned long longitud, void *contexto){
+    struct conteo_bufer *C = (struct conteo_bufer*) contexto;
+
+    //El multiset solo lee la palabra, por lo que el tramo del búfer se recorre sin copiarlo.
+    multiset_insertar_longitud(C->m, (char*) palabra, longitud);
+    C->cantidad = C->cantidad + 1;
+}
+
+unsigned long conteo_contar_bufer(multiset_t *m, const char *bufer, unsigned long n){
+    struct conteo_bufer C = {m, 0};
+    //En el trie, las palabras se separan, pliegan e insertan en una sola pasada sobre el búfer.
+    long cantidad = multiset_insertar_texto(m, bufer, n);
+
+    if (cantidad>=0){
+        C.cantidad = cantidad;
+    }
+    else{
+        lector_separar_bufer(bufer, n, aux_contar_palabra, &C);
+    }
+
+    return C.cantidad;
+}
@@ -0,0 +1,28 @@
+/**
+* @file conteo.h
+* @brief Archivo encabezado del TDA Conteo.
+* Permite contar texto que ya está en memoria, sin pasar por archivos, para utilizar el programa como biblioteca
+* (ver los destinos 'Biblioteca estatica' y 'Biblioteca dinamica' de cuentapalabras.cbp). Las palabras se separan
+* con el mismo criterio que al leer archivos (ver lector.h) y se insertan en un multiset de cualquier modo.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef CONTEO_H_INCLUDED
+#define CONTEO_H_INCLUDED
+
+#include "multiset.h"
+
+/**
+ * @brief Separa en palabras el texto dado y suma una repetición de cada una al multiset. El texto no se modifica ni
+ * necesita terminar en '\0'; en un multiset en MULTISET_MODO_TRIE sin instantáneas, cada byte se lee una sola vez y las
+ * palabras se insertan a medida que se separan (ver multiset_insertar_texto).
+ * @param m Puntero al multiset donde se cuentan las palabras.
+ * @param bufer Puntero a los caracteres del texto.
+ * @param n Cantidad de caracteres del texto.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria en el multiset.
+ * @return Cantidad de palabras contadas.
+*/
+extern unsigned long conteo_contar_bufer(multiset_t *m, const char *bufer, unsigned long n);
+
+#endif // CONTEO_H_INCLUDED
@@ -14,12 +14,79 @@ información en archivos de salida.
 #include <dirent.h> //Utilizada para obtener los archivos de los directorios.
 #include "multiset.h"
 #include "lista.h"
+#include "mezcla.h"
+#include "lector.h"
+#include "lote.h"
+#include "ngrama.h"
+#include "servidor.h"
+#include "topologia.h"
+#include "exportacion.h"
+#include "compresion.h"
+#include "alfabeto.h"
+#include "traza.h"
+#include "invertido.h"
+
+#ifndef _WIN32
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#endif
 
 #define ERROR_CUENTAPALABRAS_CONTADOR                 -6
 #define ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO         -7
 #define ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA - 8
 #define ERROR_CUENTAPALABRAS_MEMORIA                  -9
 #define ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO      -10
+#define ERROR_CUENTAPALABRAS_OPCION_INVALIDA          -13
+
+//Tamaño de los bloques en que se lee la entrada estándar en el modo de flujo.
+#define TAMANIO_BLOQUE_FLUJO (1 << 20)
+//Milisegundos tras los cuales se reintenta una instantánea postergada porque la anterior no había terminado.
+#define ESPERA_REINTENTO_INSTANTANEA 100
+
+//Separador de directorios de acuerdo al sistema operativo.
+#ifdef _WIN32
+#define SEPARADOR_DIRECTORIO "\\"
+#else
+#define SEPARADOR_DIRECTORIO "/"
+#endif
+
+/**
+ * @struct opciones
+ * @brief Modela los parámetros opcionales con los que se invoca el programa.
+*/
+struct opciones {
+    unsigned long memoria_max; ///Cantidad de bytes que puede ocupar el multiset de totales en memoria (0 indica sin límite).
+    int modo_multiset; ///Implementación de los multisets (MULTISET_MODO_TRIE, MULTISET_MODO_COMPACTO, MULTISET_MODO_APROXIMADO o MULTISET_MODO_RAFAGA).
+    int capacidad_aproximado; ///En MULTISET_MODO_APROXIMADO, cantidad de palabras más repetidas que se conservan.
+    double error_aproximado; ///En MULTISET_MODO_APROXIMADO, error máximo de una cantidad como fracción del total de palabras.
+    int longitud_ngramas; ///Longitud de las secuencias de palabras a contar en ngramas.out (0 indica que no se cuentan).
+    int segundos_instantanea; ///En el modo de flujo, segundos entre instantáneas de totales.out (0 indica sin límite).
+    unsigned long bytes_instantanea; ///En el modo de flujo, bytes leidos entre instantáneas de totales.out (0 indica sin límite).
+    int cant_trabajadores; ///Con -h, cantidad de hilos que cuentan los archivos en paralelo (0 indica que se cuentan en el hilo principal).
+    int paginas_grandes; ///TRUE si los bloques compactados de los tries se respaldan con páginas grandes.
+    int compresion_salida; ///Formato de compresión de los archivos de salida de -h (COMPRESION_NINGUNA si no se comprimen).
+    int plegado; ///Tabla de plegado de los caracteres leidos (ver alfabeto.h).
+    char *path_traza; ///Archivo donde se escribe la traza de las fases del programa (NULL si no se traza).
+    int indice_invertido; ///Con -h, TRUE si las palabras se cuentan en un único índice invertido en lugar de un multiset por archivo.
+};
+typedef struct opciones opciones_t;
+
+/**
+ * @struct acumulador_total
+ * @brief Modela el multiset de totales junto a las corridas que se volcaron a disco al superar la memoria disponible.
+*/
+struct acumulador_total {
+    multiset_t *multiset; ///Multiset con las palabras acumuladas desde el último volcado.
+    unsigned long memoria_max; ///Cantidad de bytes que puede ocupar el multiset (0 indica sin límite).
+    char *directorio; ///Directorio donde se escriben las corridas.
+    char **corridas; ///Rutas de las corridas volcadas.
+    int cant_corridas; ///Cantidad de corridas volcadas.
+};
+typedef struct acumulador_total acumulador_total_t;
 
 //---FUNCIONES PRINCIPALES-----
 
@@ -31,8 +98,8 @@ información en archivos de salida.
 */
 static comparacion_resultado_t funcion_comparacion(elemento_t * elem1, elemento_t * elem2){
     int to_return;
-    int valor_elem_1 = elem1->a;
-    int valor_elem_2 = elem2->a;
+    long long valor_elem_1 = elem1->a;
+    long long valor_elem_2 = elem2->a;
 
     //Si la cantidad de repeticiones de ELEM1 es mayor a ELEM2
     if (valor_elem_1>valor_elem_2){
@@ -100,6 +167,32 @@ static void mostrar_mensaje_opciones(){
     printf("[-h] [directorio de entrada]: Dado el directorio de archivos de texto, se procesa cada archivo contabilizando las palabras de cada uno de los archivos.\n");
     printf("  -Genera un archivo 'cadauno.out' que contiene la cantidad de veces que aparece cada palabra en en cada uno de los archivos.\n");
     printf("  -Genera un archivo 'totales.out' que contiene la cantidad de veces que aparece cada palabra entre todos los archivos.\n");
+    printf("[-s] [socket]: Inicia un servidor que mantiene los conteos en memoria y atiende ingestas y consultas en el socket local dado.\n");
+    printf("[-e] [directorio de salida]: Lee palabras de la entrada estandar hasta su fin y escribe periodicamente 'totales.out' en el directorio dado.\n");
+    printf("[-d] [directorio o indice anterior] [directorio actual]: Compara los totales del directorio actual con los de otro directorio o de un 'totales.out' guardado.\n");
+    printf("  -Genera en el directorio actual un archivo 'diferencias.out' con las palabras agregadas, removidas o cuya cantidad cambio, y su variacion.\n");
+    printf("Parametros adicionales:\n");
+    printf("[-c]: Utiliza un trie con compresion de caminos, que reduce la cantidad de nodos para palabras largas.\n");
+    printf("[-r]: Utiliza un trie de rafagas, que guarda los finales de las palabras en cubetas que se dividen en nodos al crecer.\n");
+    printf("[-a] [K]: Cuenta de forma aproximada con memoria acotada, conservando solo las K palabras mas repetidas.\n");
+    printf("  -Las cantidades informadas nunca son menores a las reales y, con probabilidad 0.99, las exceden en a lo sumo el error por el total de palabras.\n");
+    printf("  -Toda palabra que represente mas de 1/K del total de palabras aparece en la salida.\n");
+    printf("[-p] [error]: Con -a, error maximo como fraccion del total de palabras (por defecto, 0.0001). Cada multiset ocupa unos 40/error bytes mas K palabras.\n");
+    printf("[-n] [2 o 3]: Con -h, cuenta ademas las secuencias de 2 o 3 palabras consecutivas de cada archivo en 'ngramas.out'.\n");
+    printf("[-m] [megabytes]: Limita la memoria del conteo de totales. Al superarla, las palabras se vuelcan a disco y se combinan al finalizar. No puede combinarse con -e.\n");
+    printf("  -Incluye los archivos en lectura: se leen a la vez tantos como entren en la cuarta parte del limite (al menos uno), y los de mas de 256 KB se leen por partes.\n");
+    printf("[-t] [segundos]: Con -e, segundos entre instantaneas de 'totales.out' (por defecto, 10; 0 las desactiva).\n");
+    printf("[-b] [megabytes]: Con -e, megabytes leidos entre instantaneas de 'totales.out'.\n");
+    printf("[-j] [N]: Con -h, cuenta los archivos con N hilos fijados a procesadores y repartidos entre los nodos NUMA, combinando los totales primero dentro de cada nodo.\n");
+    printf("  -Informa, para cada hilo, cuantas paginas de sus totales residen en su nodo y cuantas en otros. No puede combinarse con -a, -m ni -n.\n");
+    printf("  -Con N mayor a 1, 'totales.out' tambien se ordena, formatea y escribe con N hilos.\n");
+    printf("[-g]: Respalda los tries compactados de mas de 2 MB con paginas grandes (transparent huge pages).\n");
+    printf("[-z] [gz o zst]: Con -h, escribe los archivos de salida comprimidos ('cadauno.out.gz', 'totales.out.gz', etc.).\n");
+    printf("[-u] [mayusculas o latino]: Pasa las mayusculas a minusculas antes de contar las palabras y, con 'latino', tambien las letras acentuadas (UTF-8) a su letra base.\n");
+    printf("[-i]: Con -h, cuenta las palabras de todos los archivos en un unico indice invertido, que guarda para cada palabra los archivos donde aparece y cuantas veces.\n");
+    printf("  -Escribe 'cadauno.out' y 'totales.out' a partir del indice e informa su memoria. No puede combinarse con -c, -r, -a, -m ni -j.\n");
+    printf("[-x] [archivo]: Registra cuando comienza y termina cada fase (lectura, conteo, escritura, etc.) en cada hilo y al finalizar las escribe en el archivo dado, en formato JSON para Perfetto o chrome://tracing.\n");
+    printf("Los archivos '.txt.gz' y '.txt.zst' del directorio se cuentan sin descomprimirlos a disco, si la compilacion incluye el formato.\n");
 }
 
 /**
@@ -135,27 +228,6 @@ static DIR* cuentapalabras_abrir_directorio(char *path){
     return d;
 }
 
-/**
- * @brief Comprueba si un puntero a una cadena de caracteres es un el nombre de un archivo con extensión .txt.
- * @param name Puntero a cadena de caracteres.
- * @return TRUE si es un archivo .txt y FALSE en caso contrario.
-*/
-static int aux_es_archivo_txt(char *name){
-    //Inicialización de variables.
-    int to_return = FALSE;
-    int longitud_name = strlen(name);
-
-    //Si el nombre del archivo tiene mas de 3 caractes (incluyendo extension)
-    if (longitud_name>3){
-        //Compruebo si dicho nombre finaliza con ".txt"
-        if (name[longitud_name-3]=='t' && name[longitud_name-2]=='x' && name[longitud_name-1]=='t'){
-            to_return=TRUE;
-        }
-    }
-
-    return to_return;
-}
-
 /**
 * @brief Dado un controlador del directorio, se recopila todos los archivos de textos existentes en dicho directorio y se retorna un puntero a punteros de cadenas de caracteres.
 * @param d Puntero al controlador de directorio.
@@ -171,7 +243,7 @@ static char** cuentapalabras_recopilar_nombres_archivos_txt(DIR *d, int*cant_fil
 
     //Recupera la cantidad de repeticiones a realizar.
     while(dir!=NULL){
-        if (aux_es_archivo_txt(dir->d_name)==TRUE){
+        if (compresion_es_archivo_txt(dir->d_name)==TRUE){
             cant = cant + 1;
         }
         dir = readdir(d);
@@ -190,7 +262,7 @@ static char** cuentapalabras_recopilar_nombres_archivos_txt(DIR *d, int*cant_fil
     //Mientras que dir no sea nulo
     while(dir!=NULL){
         //El nombre recuperado del elemento es un archivo de texto, entonces copiar el nombre al arreglo.
-        if (aux_es_archivo_txt(dir->d_name)==TRUE){
+        if (compresion_es_archivo_txt(dir->d_name)==TRUE){
             int longitud_cadena = strlen(dir->d_name);
             arreglo_nombre[cursor] = malloc(longitud_cadena*sizeof(char)+1);
 
@@ -227,112 +299,298 @@ static void cuentapalabras_liberar_memoria_nombres_archivos(char** C, int cant_f
 }
 
 /**
- * @brief Comprueba si es una palabra sin caracteres especiales, esto es, solo está compuesta por letras del alfabeto.
- * @param ch Puntero a cadena de caracteres.
- * @return TRUE si es una cadena sin caracteres especiales, de lo contrario, retorna FALSE.
+* @brief Construye la ruta de cada archivo uniendo el directorio con su nombre.
+* @param directorio Puntero a cadena de caracteres que representa el directorio.
+* @param nombre_archivo Puntero a punteros de cadenas de caracteres con los nombres de los archivos.
+* @param cant_filas Cantidad de archivos.
+* @throw ERROR_CUENTAPALABRAS_MEMORIA si no se pudo reservar memoria para las rutas.
+* @return Arreglo de rutas, que se libera con cuentapalabras_liberar_memoria_nombres_archivos.
 */
-static int aux_es_palabra_sin_caracteres_especiales(char* ch){
-    //Asumo que la cadena es válida.
-    int to_return = TRUE;
-
-    //Si la cadena es distinto a una cadena vacía.
-    if ((*ch)!='\0'){
-        //Mientras el caracter recuperado no sea el fin de cadena y se mantenga la condicion de que es palabra.
-        while(*ch!='\0' && to_return==TRUE){
-            //Si es un caracter alfabetico en MAYUSCULAS o minusculas.
-            if ((*ch)>=97 && (*ch)<=122){
-                //Apuntar al siguiente char.
-                ch++;
-            }
-            else{
-                //Puesto que se encontró un caracter especial, entonces la cadena no es valida.
-                to_return = FALSE;
-            }
+static char** cuentapalabras_construir_rutas(char *directorio, char **nombre_archivo, int cant_filas){
+    char **rutas = (char**) malloc(cant_filas*sizeof(char*));
+    if (rutas==NULL){
+        printf("Error %d: No se pudo reservar memoria para las rutas de los archivos.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+        exit(ERROR_CUENTAPALABRAS_MEMORIA);
+    }
+    for (int i=0; i<cant_filas; i++){
+        rutas[i] = (char*) malloc(strlen(directorio) + strlen(SEPARADOR_DIRECTORIO) + strlen(nombre_archivo[i]) + 1);
+        if (rutas[i]==NULL){
+            printf("Error %d: No se pudo reservar memoria para las rutas de los archivos.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+            exit(ERROR_CUENTAPALABRAS_MEMORIA);
         }
+        strcpy(rutas[i], directorio);
+        strcat(rutas[i], SEPARADOR_DIRECTORIO);
+        strcat(rutas[i], nombre_archivo[i]);
     }
-    else{
-        //es una cadena vacia, por lo tanto, no es una cadena válida.
-        to_return = FALSE;
+
+    return rutas;
+}
+
+/**
+ * @brief Vuelca el multiset de totales a disco como una corrida ordenada y lo vacía.
+ * @param total Puntero al acumulador de totales.
+ * @throw ERROR_CUENTAPALABRAS_MEMORIA si no se pudo reservar memoria para la ruta de la corrida.
+*/
+static void aux_volcar_total(acumulador_total_t *total){
+    char **corridas = (char**) realloc(total->corridas, (total->cant_corridas+1)*sizeof(char*));
+    char *path = (char*) malloc(strlen(total->directorio) + 32);
+    if (corridas==NULL || path==NULL){
+        printf("Error %d: No se pudo reservar memoria para la corrida.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+        exit(ERROR_CUENTAPALABRAS_MEMORIA);
     }
+    sprintf(path, "%s%stotales.corrida.%d", total->directorio, SEPARADOR_DIRECTORIO, total->cant_corridas);
 
-    return to_return;
+    traza_comenzar("volcar corrida", NULL);
+    mezcla_volcar_corrida(total->multiset, path);
+    multiset_vaciar(total->multiset);
+    traza_terminar("volcar corrida");
+
+    corridas[total->cant_corridas] = path;
+    total->corridas = corridas;
+    total->cant_corridas = total->cant_corridas + 1;
+}
+
+/**
+ * @brief Si el multiset de totales supera la memoria disponible, se vuelca a disco.
+ * @param total Puntero al acumulador de totales.
+*/
+static void aux_controlar_memoria_total(acumulador_total_t *total){
+    if ((total->memoria_max>0) && (multiset_memoria(total->multiset)>total->memoria_max)){
+        aux_volcar_total(total);
+    }
 }
 
 /**
-* @brief Recorre recursivamente la próxima cadena a recuperar por del archivo y la devuelve.
-* @param f Puntero a archivo.
-* @param longitud_cadena Longitud de la cadena a leer.
-* @throw ERROR_CUENTAPALABRAS_MEMORIA Si no se logró reservar memoria para la cadena.
-* @return Puntero a cadena creada o NULL si la cadena en cuestión en un caracter separador de palabras.
+ * @struct carga_archivo
+ * @brief Modela los multisets en donde se contabilizan las palabras de un archivo.
 */
-static char * aux_recuperar_cadena(FILE *f, int longitud_cadena){
-    //Recupero el caracter a leer.
-    char ch_actual = fgetc(f);
+struct carga_archivo {
+    multiset_t *archivo; ///Multiset con las palabras del archivo (NULL si se cuentan en el índice invertido).
+    acumulador_total_t *total; ///Acumulador de totales.
+    tabla_ngramas_t *ngramas; ///Tabla de secuencias de palabras, o NULL si no se cuentan.
+    invertido_t *invertido; ///Índice invertido cuyo diccionario son los totales, o NULL si no se utiliza.
+    int indice; ///Número del archivo en el índice invertido.
+};
 
-    //Si ch_actual es algun caracter que indique fin de cadena a considerar.
-    if ((feof(f)) || (ch_actual==' ') || (ch_actual=='\n') || (ch_actual=='.') || (ch_actual==':') || (ch_actual==';') || (ch_actual==',') || (ch_actual=='\0')){
-        //CB: Si la longitud es 0, entonces no hay cadena que crear.
-        if (longitud_cadena==0){
-            return NULL;
+/**
+ * @brief Función que recibe cada palabra del archivo y la inserta en los multisets de la carga.
+ * @param palabra Puntero a la palabra leida.
+ * @param contexto Puntero a la carga del archivo.
+*/
+static void aux_procesar_palabra(char *palabra, void *contexto){
+    struct carga_archivo *carga = (struct carga_archivo*) contexto;
+
+    if (carga->invertido!=NULL){
+        //El índice suma la palabra en su archivo y en los totales, y devuelve su identificador en estos.
+        unsigned int id = invertido_insertar(carga->invertido, palabra, carga->indice);
+        if (carga->ngramas!=NULL){
+            ngrama_agregar_palabra(carga->ngramas, id);
+        }
+    }
+    else{
+        multiset_insertar(carga->archivo, palabra);
+        if (carga->ngramas!=NULL){
+            //El identificador de la palabra en los totales es la clave de las secuencias.
+            ngrama_agregar_palabra(carga->ngramas, multiset_insertar_id(carga->total->multiset, palabra));
         }
         else{
-            //CB: Si la longitud es mayor a 1, entonces hay una palabra de por lo menos un char.
-            char * cadena = (char*) malloc((longitud_cadena+1)*sizeof(char));
-            if (cadena==NULL){
-                printf("Error %d: No se pudo reservar memoria para la cadena.\n", ERROR_CUENTAPALABRAS_MEMORIA);
-                exit(ERROR_CUENTAPALABRAS_MEMORIA);
-            }
-            cadena[longitud_cadena] = '\0';
-
-            return cadena;
+            multiset_insertar(carga->total->multiset, palabra);
         }
     }
+    aux_controlar_memoria_total(carga->total);
+}
+
+/**
+ * @brief Función que recibe cada palabra de un archivo y la inserta en el multiset dado como contexto.
+*/
+static void aux_insertar_palabra(char *palabra, void *contexto){
+    multiset_insertar((multiset_t*) contexto, palabra);
+}
+
+/**
+ * @struct descompresion_archivo
+ * @brief Modela la separación en palabras de un archivo comprimido, cuyos bloques descomprimidos se leen como un flujo.
+*/
+struct descompresion_archivo {
+    lector_flujo_t lector; ///Lector del flujo de bloques descomprimidos.
+    funcion_palabra_t *procesar; ///Función que recibe cada palabra.
+    void *contexto; ///Contexto de 'procesar'.
+};
+
+/**
+ * @brief Función que recibe cada bloque descomprimido de un archivo y lo separa en palabras.
+*/
+static void aux_procesar_bloque_descomprimido(char *bloque, unsigned long n, void *contexto){
+    struct descompresion_archivo *D = (struct descompresion_archivo*) contexto;
+    lector_flujo_procesar(&(D->lector), bloque, n, D->procesar, D->contexto);
+}
+
+/**
+ * @brief Separa en palabras el contenido de un archivo e invoca a 'procesar' con cada una. Si el archivo está comprimido,
+ * se descomprime por bloques (ver compresion.h), sin descomprimirlo completo en memoria ni a disco.
+ * @param contenido Puntero a los caracteres del archivo, con capacidad para uno más (ver lote.h).
+ * @param n Cantidad de caracteres del contenido.
+ * @param formato Formato de compresión del archivo.
+ * @param procesar Función que recibe cada palabra.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+*/
+static void aux_separar_palabras(char *contenido, unsigned long n, int formato, funcion_palabra_t procesar, void *contexto){
+    if (formato==COMPRESION_NINGUNA){
+        lector_procesar_contenido(contenido, n, procesar, contexto);
+    }
+    else{
+        struct descompresion_archivo D;
+        lector_flujo_iniciar(&(D.lector));
+        D.procesar = procesar;
+        D.contexto = contexto;
+        compresion_descomprimir(contenido, n, formato, aux_procesar_bloque_descomprimido, &D);
+        lector_flujo_finalizar(&(D.lector), procesar, contexto);
+    }
+}
+
+/**
+ * @struct archivo_por_partes
+ * @brief Modela la separación en palabras de un archivo que el lote entrega por partes (ver lote.h), donde una palabra
+ * puede quedar cortada entre una parte y la siguiente.
+*/
+struct archivo_por_partes {
+    lector_flujo_t lector; ///Lector de las palabras cortadas entre partes o, si el archivo está comprimido, de sus bloques descomprimidos.
+    descompresion_t *descompresion; ///Descompresor del archivo, o NULL si no está comprimido.
+    multiset_t *en_una_pasada; ///Multiset donde se insertan en una pasada las palabras enteras de cada parte, o NULL si todas pasan por 'procesar'.
+    funcion_palabra_t *procesar; ///Función que recibe cada palabra que no se inserta en una pasada.
+    void *contexto; ///Contexto de 'procesar'.
+};
+
+/**
+ * @brief Función que recibe cada bloque descomprimido de un archivo leido por partes y lo separa en palabras.
+*/
+static void aux_procesar_bloque_de_partes(char *bloque, unsigned long n, void *contexto){
+    struct archivo_por_partes *P = (struct archivo_por_partes*) contexto;
+    lector_flujo_procesar(&(P->lector), bloque, n, P->procesar, P->contexto);
+}
+
+/**
+ * @brief Prepara la separación en palabras de un archivo que se recibe por partes.
+ * @param P Puntero al estado de la separación.
+ * @param formato Formato de compresión del archivo.
+ * @param en_una_pasada Multiset donde insertar en una pasada las palabras enteras de cada parte (solo si el archivo no
+ * está comprimido y el multiset admite multiset_insertar_texto), o NULL.
+ * @param procesar Función que recibe las demás palabras.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+*/
+static void aux_iniciar_partes(struct archivo_por_partes *P, int formato, multiset_t *en_una_pasada, funcion_palabra_t procesar, void *contexto){
+    lector_flujo_iniciar(&(P->lector));
+    P->descompresion = (formato==COMPRESION_NINGUNA) ? NULL : compresion_flujo_crear(formato, aux_procesar_bloque_de_partes, P);
+    P->en_una_pasada = en_una_pasada;
+    P->procesar = procesar;
+    P->contexto = contexto;
+}
+
+/**
+ * @brief Separa en palabras la parte siguiente del archivo. Sin compresión y con un multiset para insertar en una pasada,
+ * las palabras entre el primer y el último separador de la parte están enteras y se insertan con multiset_insertar_texto;
+ * solo las de los extremos, que pueden continuar en la parte vecina, pasan por el lector.
+*/
+static void aux_procesar_parte(struct archivo_por_partes *P, char *contenido, unsigned long n){
+    if (P->descompresion!=NULL){
+        compresion_flujo_procesar(P->descompresion, contenido, n);
+    }
+    else if (P->en_una_pasada==NULL){
+        lector_flujo_procesar(&(P->lector), contenido, n, P->procesar, P->contexto);
+    }
     else{
-        //CR: Bloque de caracteres dentro de la cadena.
-        char * cadena = aux_recuperar_cadena(f, longitud_cadena+1);
-        cadena[longitud_cadena] = ch_actual;
+        const signed char *clases = alfabeto_plegado()->clases;
+        unsigned long primero = 0; //Posición del primer separador.
+        unsigned long ultimo = n; //Posición siguiente al último separador.
 
-        return cadena;
+        while (primero<n && clases[(unsigned char) contenido[primero]]!=ALFABETO_CLASE_SEPARADOR){
+            primero++;
+        }
+        while (ultimo>primero && clases[(unsigned char) contenido[ultimo-1]]!=ALFABETO_CLASE_SEPARADOR){
+            ultimo--;
+        }
+        if (primero==n){
+            lector_flujo_procesar(&(P->lector), contenido, n, P->procesar, P->contexto);
+        }
+        else{
+            //El separador cierra en el lector la palabra que venía de la parte anterior.
+            lector_flujo_procesar(&(P->lector), contenido, primero+1, P->procesar, P->contexto);
+            multiset_insertar_texto(P->en_una_pasada, contenido+primero+1, ultimo-primero-1);
+            lector_flujo_procesar(&(P->lector), contenido+ultimo, n-ultimo, P->procesar, P->contexto);
+        }
     }
 }
 
 /**
- * @brief De acuerdo a la ruta al archivo dada, se procede a leer el archivo de texto y se recopila cada palabra y se las contabiliza.
- * @param path Puntero a cadena de caracteres que conforma la ruta hacia el archivo a leer.
- * @param m_total Multiset donde se cargarán las palabras leidas en el documento.
- * @throw ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO si no se pudo abrir el archivo.
- * @return Multiset con las palabras contadas pertenecientes al archivo dado.
+ * @brief Finaliza la separación en palabras del archivo, procesando la palabra que haya quedado abierta.
 */
-static multiset_t* aux_cargar_multiset(char*path, multiset_t *m_total){
-    //Crea el multiset a retornar con las palabras contabilizadas del archivo dado.
-    multiset_t *m_return = multiset_crear();
-    //Abro el archivo en modo de lectura.
-    FILE* f = fopen(path, "r");
-    //Si no se abre el archivo, entonces ha ocurrido un error.
-    if (f==NULL){
-        printf("Error -7: Error en apertura de archivo\n");
-        exit(ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO);
+static void aux_finalizar_partes(struct archivo_por_partes *P){
+    if (P->descompresion!=NULL){
+        compresion_flujo_finalizar(&(P->descompresion));
     }
+    lector_flujo_finalizar(&(P->lector), P->procesar, P->contexto);
+}
+
+/**
+ * @brief Dado el contenido de un archivo de texto, se recopila cada palabra y se las contabiliza.
+ * @param contenido Puntero a los caracteres del archivo, con capacidad para uno más (ver lote.h).
+ * @param n Cantidad de caracteres del contenido.
+ * @param formato Formato de compresión del archivo.
+ * @param total Acumulador de totales donde se cargarán las palabras leidas en el documento.
+ * @param archivo Multiset vacío donde se cuentan las palabras del archivo, o NULL si se cuentan en el índice invertido.
+ * @param ngramas Tabla donde se cuentan las secuencias de palabras del documento, o NULL si no se cuentan.
+ * @param invertido Índice invertido donde se cuentan las palabras, o NULL si se cuentan en 'archivo'.
+ * @param indice Número del archivo en el índice invertido.
+ * @return TRUE si las palabras se contaron solo en 'archivo' y resta sumarlas a los totales, FALSE si no.
+*/
+static int aux_cargar_multiset(char *contenido, unsigned long n, int formato, acumulador_total_t *total, multiset_t *archivo, tabla_ngramas_t *ngramas, invertido_t *invertido, int indice){
+    struct carga_archivo carga = {archivo, total, ngramas, invertido, indice};
 
-    //Mientras que exista algo que leer en el archivo.
-    while (!feof(f)) {
-        //Recupero un puntero a la cadena de caracteres a analizar.
-        char * cadena = aux_recuperar_cadena(f, 0);
+    //Las secuencias no cruzan el límite entre documentos.
+    if (ngramas!=NULL){
+        ngrama_reiniciar_ventana(ngramas);
+    }
 
-        //Si el puntero no es NULO y ademas es una palabra sin caracteres especiales, entonces se inserta en los multiset's.
-        if ((cadena!=NULL) && (aux_es_palabra_sin_caracteres_especiales(cadena)==TRUE)){
-            multiset_insertar(m_return, cadena);
-            multiset_insertar(m_total, cadena);
-        }
+    int to_return = FALSE;
 
-        //Finalmente libero la memoria reservada para la cadena.
-        free(cadena);
+    //Si solo se cuentan palabras, el archivo se cuenta en una pasada y sus palabras distintas se suman a los totales al
+    //exportarlo, con una inserción por palabra distinta en lugar de una por repetición.
+    if (formato==COMPRESION_NINGUNA && archivo!=NULL && ngramas==NULL && multiset_insertar_texto(archivo, contenido, n)>=0){
+        to_return = TRUE;
+    }
+    else{
+        //Separa el contenido en palabras y procesa cada una.
+        aux_separar_palabras(contenido, n, formato, aux_procesar_palabra, &carga);
     }
 
-    //Cierro el archivo
-    fclose(f);
+    return to_return;
+}
+
+/**
+ * @brief Prepara la carga de las palabras de un archivo que se recibe por partes, con el mismo criterio que
+ * aux_cargar_multiset.
+ * @param P Puntero al estado de la separación en palabras del archivo.
+ * @param carga Puntero a la carga del archivo, que debe conservarse hasta finalizar la separación.
+ * @param formato Formato de compresión del archivo.
+ * @return TRUE si las palabras se cuentan solo en el multiset del archivo y resta sumarlas a los totales, FALSE si no.
+*/
+static int aux_iniciar_carga_por_partes(struct archivo_por_partes *P, struct carga_archivo *carga, int formato){
+    int to_return = FALSE;
+
+    if (carga->ngramas!=NULL){
+        ngrama_reiniciar_ventana(carga->ngramas);
+    }
+    //Un texto vacío no inserta palabras: solo indica si el multiset admite la inserción en una pasada.
+    if (formato==COMPRESION_NINGUNA && carga->archivo!=NULL && carga->ngramas==NULL && multiset_insertar_texto(carga->archivo, "", 0)>=0){
+        //Las palabras cortadas entre partes también se cuentan solo en el archivo.
+        aux_iniciar_partes(P, formato, carga->archivo, aux_insertar_palabra, carga->archivo);
+        to_return = TRUE;
+    }
+    else{
+        aux_iniciar_partes(P, formato, NULL, aux_procesar_palabra, carga);
+    }
 
-    return m_return;
+    return to_return;
 }
 
 /**
@@ -340,44 +598,342 @@ static multiset_t* aux_cargar_multiset(char*path, multiset_t *m_total){
  * @param file Puntero al manejador de archivo. Requiere que esté abierto el archivo para poder ser escrito.
  * @param nombre_archivo Puntero a cadena de caracteres que conforman el nombre del archivo.
  * @param multiset_archivo Puntero a multiset de palabras ordenadas.
+ * @param total Acumulador de totales al que se suman las palabras a medida que se escriben, o NULL si no se suman.
 */
-static void aux_exportar_multiset_a_archivo(FILE *file, char* nombre_archivo, multiset_t* multiset_archivo){
+static void aux_exportar_multiset_a_archivo(FILE *file, char* nombre_archivo, multiset_t* multiset_archivo, acumulador_total_t *total){
     //Si la cadena recibida es distinta de una cadena vacía.
     if (nombre_archivo!=NULL){
         fprintf(file, "%s\n", nombre_archivo);
     }
 
-    //Recupera la lista de elementos del multiset.
-    lista_t L = multiset_elementos(multiset_archivo, NULL);
-    //Se ordena a la ruta recuperada.
-    lista_ordenar(&L, funcion_comparacion);
+    //Recupera la lista de elementos del multiset, ya ordenada según el criterio de funcion_comparacion.
+    traza_comenzar("ordenar", NULL);
+    lista_t L = multiset_elementos_por_frecuencia(multiset_archivo);
+    traza_terminar("ordenar");
+
+    //Se recorre la lista con un cursor, eliminando cada elemento una vez escrito.
+    cursor_lista_t cursor = lista_cursor(&L);
+    while (lista_cursor_valido(&cursor)==TRUE){
+        elemento_t * elem = lista_cursor_eliminar(&cursor);
+        fprintf(file, "%lld   %s\n", elem->a, elem->b);
+        if (total!=NULL){
+            multiset_insertar_cantidad(total->multiset, elem->b, elem->a);
+            aux_controlar_memoria_total(total);
+        }
+        aux_liberar_memoria_elemento(elem);
+    }
+}
+
+/**
+ * @struct salida_archivos
+ * @brief Modela el estado con el que se procesa el contenido de cada archivo de entrada.
+*/
+struct salida_archivos {
+    char **nombre_archivo; ///Nombres de los archivos, en el orden en que se leen.
+    FILE *f_cadauno; ///Archivo cadauno.out.
+    acumulador_total_t *total; ///Acumulador de totales.
+    int modo; ///Implementación de los multisets.
+    tabla_ngramas_t *ngramas; ///Tabla de secuencias de palabras, o NULL si no se cuentan.
+    invertido_t *invertido; ///Índice invertido donde se cuentan las palabras, o NULL si cada archivo tiene su multiset.
+    multiset_t *archivo; ///Multiset del archivo actual, que se reinicia para el siguiente (NULL hasta el primer archivo).
+    struct carga_archivo carga; ///Carga del archivo actual, si se recibe por partes.
+    struct archivo_por_partes partes; ///Separación en palabras del archivo actual, si se recibe por partes.
+    int sumar_a_total; ///TRUE si las palabras del archivo actual se contaron solo en su multiset.
+};
+
+/**
+ * @brief Función que recibe el contenido del archivo i-ésimo, completo o por partes, lo contabiliza y escribe su
+ * multiset en cadauno.out. Con el índice invertido, cadauno.out se escribe a partir del índice luego de contar todos
+ * los archivos.
+ * @throw ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO si no se pudo abrir o leer el archivo.
+*/
+static void aux_procesar_archivo_leido(int indice, char *contenido, unsigned long n, int parte, void *contexto){
+    struct salida_archivos *salida = (struct salida_archivos*) contexto;
 
-    //Si la lista no está vacia, entonces se procede a recorrerla para obtener los elementos.
-    if (lista_vacia(L)==FALSE){
-        int size_lista = lista_cantidad(&L);
+    if (contenido==NULL){
+        printf("Error -7: Error en apertura de archivo\n");
+        exit(ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO);
+    }
 
-        //Elimino todos los elementos de la lista L.
-        for (int i=0; i<size_lista; i++){
-            elemento_t * elem = lista_eliminar(&L, 0);
-            fprintf(file, "%d   %s\n", elem->a, elem->b);
-            aux_liberar_memoria_elemento(elem);
+    int formato = compresion_formato_de_nombre(salida->nombre_archivo[indice]);
+    //Separar las palabras e insertarlas ocurre en la misma pasada, por lo que ambas se trazan como una sola fase.
+    if (parte==LOTE_ARCHIVO_COMPLETO || parte==LOTE_PARTE_INICIAL){
+        if (salida->invertido==NULL && salida->archivo==NULL){
+            salida->archivo = multiset_crear_modo(salida->modo);
+        }
+        traza_comenzar("contar", salida->nombre_archivo[indice]);
+    }
+    if (parte==LOTE_ARCHIVO_COMPLETO){
+        salida->sumar_a_total = aux_cargar_multiset(contenido, n, formato, salida->total, salida->archivo, salida->ngramas, salida->invertido, indice);
+    }
+    else{
+        if (parte==LOTE_PARTE_INICIAL){
+            struct carga_archivo carga = {salida->archivo, salida->total, salida->ngramas, salida->invertido, indice};
+            salida->carga = carga;
+            salida->sumar_a_total = aux_iniciar_carga_por_partes(&(salida->partes), &(salida->carga), formato);
         }
+        aux_procesar_parte(&(salida->partes), contenido, n);
+        if (parte==LOTE_PARTE_FINAL){
+            aux_finalizar_partes(&(salida->partes));
+        }
+    }
+    if (parte==LOTE_ARCHIVO_COMPLETO || parte==LOTE_PARTE_FINAL){
+        traza_terminar("contar");
+    }
+    if (salida->archivo!=NULL && (parte==LOTE_ARCHIVO_COMPLETO || parte==LOTE_PARTE_FINAL)){
+        //Escribir el contenido del multiset_archivo en el archivo de salida.
+        traza_comenzar("escribir cadauno", salida->nombre_archivo[indice]);
+        aux_exportar_multiset_a_archivo(salida->f_cadauno, salida->nombre_archivo[indice], salida->archivo, (salida->sumar_a_total==TRUE) ? salida->total : NULL);
+        traza_terminar("escribir cadauno");
+        //Los nodos del archivo se conservan para contar el siguiente sin volver a reservarlos.
+        multiset_reiniciar(salida->archivo);
+    }
+}
+
+//----MODO DE TRABAJADORES----
+
+#ifndef _WIN32
+
+/**
+ * @struct trabajador
+ * @brief Modela un hilo que cuenta un rango contiguo de los archivos de entrada en sus propios multisets.
+*/
+struct trabajador {
+    int indice; ///Número del trabajador.
+    int nodo; ///Nodo NUMA donde se ubica.
+    int cpu; ///Procesador al que se fija.
+    int fijado; ///TRUE si el hilo quedó fijado a su procesador.
+    char **rutas; ///Rutas de los archivos del rango.
+    char **nombres; ///Nombres de los archivos del rango.
+    int cant_archivos; ///Cantidad de archivos del rango.
+    char *directorio; ///Directorio de entrada, donde se escribe la parte de cadauno.out del rango.
+    char *path_parte; ///Ruta de la parte de cadauno.out del rango.
+    int modo; ///Implementación de los multisets.
+    multiset_t *total; ///Totales del rango; al combinar, el primer trabajador de cada nodo acumula los de su nodo.
+    struct trabajador **companieros; ///Al combinar, los demás trabajadores del nodo (solo en el primero de cada nodo).
+    int cant_companieros; ///Cantidad de compañeros.
+    unsigned long paginas_locales; ///Páginas del bloque compactado de los totales que residen en el nodo del trabajador.
+    unsigned long paginas_remotas; ///Páginas del bloque compactado de los totales que residen en otro nodo.
+    pthread_t hilo; ///Hilo del trabajador.
+};
+
+/**
+ * @brief Función que recibe cada palabra de un multiset y la suma al multiset dado como contexto.
+*/
+static void aux_sumar_palabra(char *palabra, long long cantidad, void *contexto){
+    multiset_insertar_cantidad((multiset_t*) contexto, palabra, cantidad);
+}
+
+/**
+ * @brief Compacta los totales del trabajador y cuenta cuantas de sus páginas residen en su nodo.
+ * Como el bloque compactado se reserva y escribe en el hilo del trabajador, queda en la memoria de su nodo.
+*/
+static void aux_compactar_totales(struct trabajador *T){
+    void *inicio;
+    unsigned long bytes;
+
+    traza_comenzar("compactar", NULL);
+    multiset_compactar(T->total);
+    traza_terminar("compactar");
+    if (multiset_region_compacta(T->total, &inicio, &bytes)==TRUE){
+        topologia_contar_paginas(inicio, bytes, T->nodo, &(T->paginas_locales), &(T->paginas_remotas));
+    }
+}
+
+/**
+ * @brief Función que ejecuta cada trabajador: se fija a su procesador, cuenta los archivos de su rango escribiendo su
+ * parte de cadauno.out y compacta sus totales.
+ * @throw ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA si no se pudo crear la parte de cadauno.out.
+*/
+static void *aux_ejecutar_trabajador(void *contexto){
+    struct trabajador *T = (struct trabajador*) contexto;
+
+    //Fijado el hilo, glibc le asigna su propia arena y el núcleo ubica cada página en el nodo del primer hilo que la
+    //escribe, por lo que los nodos del trie del trabajador quedan en la memoria de su nodo.
+    T->fijado = topologia_fijar_cpu(T->cpu);
+    T->total = multiset_crear_modo(T->modo);
+
+    FILE *f_parte = fopen(T->path_parte, "w");
+    if (f_parte==NULL){
+        printf("Error %d: Error en creacion de archivo: %s\n", ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA, T->path_parte);
+        exit(ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA);
+    }
+    acumulador_total_t total = {T->total, 0, T->directorio, NULL, 0};
+    struct salida_archivos salida = {T->nombres, f_parte, &total, T->modo, NULL, NULL, NULL};
+    lote_leer_archivos(T->rutas, T->cant_archivos, aux_procesar_archivo_leido, &salida);
+    if (salida.archivo!=NULL){
+        multiset_eliminar(&(salida.archivo));
+    }
+    fclose(f_parte);
+
+    aux_compactar_totales(T);
+
+    return NULL;
+}
+
+/**
+ * @brief Función que ejecuta el primer trabajador de cada nodo para combinar los totales de los demás trabajadores del
+ * nodo con los suyos. Se fija al procesador del trabajador, de modo que la combinación solo lee memoria de su nodo.
+*/
+static void *aux_combinar_nodo(void *contexto){
+    struct trabajador *T = (struct trabajador*) contexto;
+
+    topologia_fijar_cpu(T->cpu);
+    traza_comenzar("combinar", NULL);
+    for (int i=0; i<T->cant_companieros; i++){
+        multiset_recorrer(T->companieros[i]->total, aux_sumar_palabra, T->total);
+        multiset_eliminar(&(T->companieros[i]->total));
+    }
+    traza_terminar("combinar");
+    if (T->cant_companieros>0){
+        aux_compactar_totales(T);
     }
 
-    L.cantidad = 0;
-    L.primera = NULL;
+    return NULL;
+}
+
+/**
+ * @brief Copia el contenido de la parte de cadauno.out de un trabajador al archivo dado y la elimina.
+ * @throw ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO si no se pudo abrir la parte.
+*/
+static void aux_agregar_parte(FILE *f_cadauno, char *path_parte){
+    char bloque[1 << 16];
+    unsigned long leidos;
+    FILE *f_parte = fopen(path_parte, "r");
+
+    if (f_parte==NULL){
+        printf("Error %d: Error en apertura de archivo: %s\n", ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO, path_parte);
+        exit(ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO);
+    }
+    leidos = fread(bloque, 1, sizeof(bloque), f_parte);
+    while (leidos>0){
+        fwrite(bloque, 1, leidos, f_cadauno);
+        leidos = fread(bloque, 1, sizeof(bloque), f_parte);
+    }
+    fclose(f_parte);
+    remove(path_parte);
 }
 
+/**
+ * @brief Cuenta los archivos dados con 'cant_trabajadores' hilos, cada uno sobre un rango contiguo de archivos y fijado a
+ * un procesador según la topología NUMA de la máquina, y combina sus totales en dos etapas: primero dentro de cada nodo,
+ * en un hilo de dicho nodo, y luego entre los nodos, de modo que solo los totales ya combinados de cada nodo crucen de uno
+ * a otro. Escribe en 'f_cadauno' las partes de cada trabajador en el orden de los archivos e informa, para cada trabajador,
+ * en qué nodo residen las páginas de sus totales.
+ * @param directorio Directorio de entrada.
+ * @param nombre_archivo Nombres de los archivos.
+ * @param rutas Rutas de los archivos.
+ * @param cant_filas Cantidad de archivos.
+ * @param opciones Opciones con las que se invocó el programa.
+ * @param f_cadauno Archivo cadauno.out.
+ * @throw ERROR_CUENTAPALABRAS_MEMORIA si no se pudo reservar memoria para los trabajadores.
+ * @return Multiset con los totales de todos los archivos.
+*/
+static multiset_t *aux_contar_con_trabajadores(char *directorio, char **nombre_archivo, char **rutas, int cant_filas, opciones_t *opciones, FILE *f_cadauno){
+    topologia_t *topologia = topologia_detectar();
+    int cant_trabajadores = (opciones->cant_trabajadores<cant_filas) ? opciones->cant_trabajadores : cant_filas;
+    struct trabajador *trabajadores = (struct trabajador*) malloc(cant_trabajadores*sizeof(struct trabajador));
+    multiset_t *to_return;
+
+    if (trabajadores==NULL){
+        printf("Error %d: No se pudo reservar memoria para los trabajadores.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+        exit(ERROR_CUENTAPALABRAS_MEMORIA);
+    }
+    printf("\nCONTEO EN PARALELO\n");
+    printf("%d trabajadores en %d nodos NUMA.\n", cant_trabajadores, topologia_cantidad_nodos(topologia));
+
+    //Cada trabajador recibe un rango contiguo de archivos, de modo que sus partes de cadauno.out se concatenen en orden.
+    for (int i=0; i<cant_trabajadores; i++){
+        struct trabajador *T = &(trabajadores[i]);
+        int desde = (int) (((long) i * cant_filas) / cant_trabajadores);
+        int hasta = (int) (((long) (i+1) * cant_filas) / cant_trabajadores);
+
+        T->indice = i;
+        T->nodo = topologia_ubicar_trabajador(topologia, i, cant_trabajadores, &(T->cpu));
+        T->rutas = rutas + desde;
+        T->nombres = nombre_archivo + desde;
+        T->cant_archivos = hasta - desde;
+        T->directorio = directorio;
+        T->path_parte = (char*) malloc(strlen(directorio) + 32);
+        if (T->path_parte==NULL){
+            printf("Error %d: No se pudo reservar memoria para los trabajadores.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+            exit(ERROR_CUENTAPALABRAS_MEMORIA);
+        }
+        sprintf(T->path_parte, "%s%scadauno.parte.%d", directorio, SEPARADOR_DIRECTORIO, i);
+        T->modo = opciones->modo_multiset;
+        T->companieros = NULL;
+        T->cant_companieros = 0;
+        T->paginas_locales = 0;
+        T->paginas_remotas = 0;
+        pthread_create(&(T->hilo), NULL, aux_ejecutar_trabajador, T);
+    }
+    for (int i=0; i<cant_trabajadores; i++){
+        pthread_join(trabajadores[i].hilo, NULL);
+    }
+    for (int i=0; i<cant_trabajadores; i++){
+        struct trabajador *T = &(trabajadores[i]);
+
+        printf("  -Trabajador %d: nodo %d, procesador %d%s, %d archivos, paginas de sus totales en su nodo: %lu, en otros nodos: %lu.\n",
+               T->indice, T->nodo, T->cpu, (T->fijado==TRUE) ? "" : " (sin fijar)", T->cant_archivos, T->paginas_locales, T->paginas_remotas);
+        aux_agregar_parte(f_cadauno, T->path_parte);
+        free(T->path_parte);
+    }
+
+    //Primera etapa: el primer trabajador de cada nodo combina los totales de los demás trabajadores de su nodo.
+    //Como los trabajadores de un nodo tienen índices consecutivos, el primero de cada nodo es el que cambia de nodo.
+    for (int i=0; i<cant_trabajadores; i++){
+        struct trabajador *T = &(trabajadores[i]);
+        if (i==0 || T->nodo!=trabajadores[i-1].nodo){
+            T->companieros = (struct trabajador**) malloc(cant_trabajadores*sizeof(struct trabajador*));
+            if (T->companieros==NULL){
+                printf("Error %d: No se pudo reservar memoria para los trabajadores.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+                exit(ERROR_CUENTAPALABRAS_MEMORIA);
+            }
+            for (int j=i+1; j<cant_trabajadores && trabajadores[j].nodo==T->nodo; j++){
+                T->companieros[T->cant_companieros] = &(trabajadores[j]);
+                T->cant_companieros = T->cant_companieros + 1;
+            }
+            pthread_create(&(T->hilo), NULL, aux_combinar_nodo, T);
+        }
+    }
+    for (int i=0; i<cant_trabajadores; i++){
+        struct trabajador *T = &(trabajadores[i]);
+        if (T->companieros!=NULL){
+            pthread_join(T->hilo, NULL);
+            printf("  -Totales del nodo %d (trabajador %d): paginas en su nodo: %lu, en otros nodos: %lu.\n", T->nodo, T->indice, T->paginas_locales, T->paginas_remotas);
+        }
+    }
+
+    //Segunda etapa: los totales de cada nodo se suman a los del primer nodo; es el único tramo que cruza entre nodos.
+    to_return = trabajadores[0].total;
+    for (int i=1; i<cant_trabajadores; i++){
+        if (trabajadores[i].companieros!=NULL){
+            multiset_recorrer(trabajadores[i].total, aux_sumar_palabra, to_return);
+            multiset_eliminar(&(trabajadores[i].total));
+        }
+    }
+    for (int i=0; i<cant_trabajadores; i++){
+        free(trabajadores[i].companieros);
+    }
+    free(trabajadores);
+    topologia_eliminar(&topologia);
+
+    return to_return;
+}
+
+#endif
+
 /**
 * @brief Realiza la construcción de los archivos cadauno.out y totales.out en base a los archivos de textos encontrados en el directorio dado.
 * Importante: Los mencionados archivos a construir se escribirán en el directorio dado.
 * @param directorio Puntero a cadena de caracteres que representa el directorio.
 * @param nombre_archivo Puntero a punteros de cadenas de caracteres que representan los nombres de los archivos.
 * @param cant_filas Entero que indica la cantidad de archivos de textos a leer.
+* @param opciones Puntero a las opciones con las que se invocó el programa.
 * @throw ERROR_CUENTAPALABRAS_MEMORIA Si no es reservada memoria para la creación del puntero al puntero de un multiset.
 * @throe ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA Si no se pudo crear los archivos cadauno.out o totales.out.
 */
-static void cuentapalabras_construir_archivos_salida(char* directorio, char** nombre_archivo, int cant_filas){
+static void cuentapalabras_construir_archivos_salida(char* directorio, char** nombre_archivo, int cant_filas, opciones_t *opciones){
     //Reservo memoria para un puntero a puntero de multiset con el fin de emplear multiset_eliminar.
     multiset_t **m = (multiset_t**) malloc(sizeof(multiset_t*));
     if (m==NULL){
@@ -385,7 +941,16 @@ static void cuentapalabras_construir_archivos_salida(char* directorio, char** no
         exit(ERROR_CUENTAPALABRAS_MEMORIA);
     }
     //Se construye el multiset donde se acumularan todas las palabras de todos los archivos.
-    multiset_t* multiset_total = multiset_crear();
+    multiset_t* multiset_total = multiset_crear_modo(opciones->modo_multiset);
+    unsigned long memoria_total = opciones->memoria_max;
+    //Con memoria limitada, hasta la cuarta parte del límite se destina a los contenidos de los archivos en lectura, que
+    //se descuentan del límite de los totales.
+    if (opciones->memoria_max>0){
+        lote_configurar_memoria(opciones->memoria_max/4);
+        memoria_total = opciones->memoria_max - lote_memoria_maxima();
+    }
+    acumulador_total_t total = {multiset_total, memoria_total, directorio, NULL, 0};
+    tabla_ngramas_t *ngramas = (opciones->longitud_ngramas>0) ? ngrama_crear(opciones->longitud_ngramas) : NULL;
 
     /*
     * Tanto el path_cadauno como el path_totales se obtienen al realizar el siguientes procedimiento, el cual se realiza de
@@ -396,45 +961,112 @@ static void cuentapalabras_construir_archivos_salida(char* directorio, char** no
     *   2. Al contenido de path, se le suma \archivo.out, donde archivo en el nombre del archivo en cuestion.
     */
 
-    //Ruta hacia los archivos cadauno.out y otro para totales.out.
+    //Ruta hacia los archivos cadauno.out y otro para totales.out (con la extensión de la compresión, si la hay).
     char path_cadauno[100];
     strcpy(path_cadauno, directorio);
-    strcat(path_cadauno, "\\cadauno.out");
+    strcat(path_cadauno, SEPARADOR_DIRECTORIO "cadauno.out");
+    strcat(path_cadauno, compresion_extension(opciones->compresion_salida));
 
     char path_totales[100];
     strcpy(path_totales, directorio);
-    strcat(path_totales, "\\totales.out");
+    strcat(path_totales, SEPARADOR_DIRECTORIO "totales.out");
+    strcat(path_totales, compresion_extension(opciones->compresion_salida));
 
     //Crea dos punteros a archivos, uno para el archivo cadauno.out y otro para totales.out.
-    FILE * f_cadauno = fopen(path_cadauno, "w"); //Solo escribe.
+    FILE * f_cadauno = compresion_abrir_salida(path_cadauno, opciones->compresion_salida); //Solo escribe.
     if (f_cadauno==NULL){
         printf("Error -8: Error en creacion de archivo: cadauno.out\n");
         exit(ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA);
     }
-    FILE * f_totales = fopen(path_totales, "w"); //Solo escribe.
+    FILE * f_totales = compresion_abrir_salida(path_totales, opciones->compresion_salida); //Solo escribe.
     if (f_totales==NULL){
         printf("Error -8: Error en creacion de archivo: totales.out\n");
         exit(ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA);
     }
 
-    //Para cada archivo_i.
-    for (int i=0; i<cant_filas; i++){
-        //Creo el path para la ruta del archivo.
-        char path[260];
-        strcpy(path, directorio);
-        strcat(path, "\\");
-        strcat(path, nombre_archivo[i]);
-
-        //Lee el archivo i y carga las palabras en el multiset_total, devolviendo un multiset cargado con las palabras leidas en la iteración I.
-        m[0] = aux_cargar_multiset(path, multiset_total);
-        //Escribir el contenido del multiset_archivo en el archivo de salida.
-        aux_exportar_multiset_a_archivo(f_cadauno,  nombre_archivo[i], m[0]);
-        //Elimina el multiset i
-        multiset_eliminar(m);
+    //Ruta de cada archivo_i, que se leen en lote (ver lote.h) y se procesan en orden.
+    char **rutas = cuentapalabras_construir_rutas(directorio, nombre_archivo, cant_filas);
+
+#ifndef _WIN32
+    if (opciones->cant_trabajadores>0){
+        //Los trabajadores construyen sus propios totales, que reemplazan al multiset de totales.
+        multiset_eliminar(&multiset_total);
+        multiset_total = aux_contar_con_trabajadores(directorio, nombre_archivo, rutas, cant_filas, opciones, f_cadauno);
+        total.multiset = multiset_total;
+    }
+    else
+#endif
+    {
+        invertido_t *invertido = (opciones->indice_invertido==TRUE) ? invertido_crear(multiset_total) : NULL;
+        struct salida_archivos salida = {nombre_archivo, f_cadauno, &total, opciones->modo_multiset, ngramas, invertido, NULL};
+        lote_leer_archivos(rutas, cant_filas, aux_procesar_archivo_leido, &salida);
+        if (salida.archivo!=NULL){
+            multiset_eliminar(&(salida.archivo));
+        }
+
+        //Con el índice invertido, cadauno.out se escribe recién ahora, recorriendo las listas de todas las palabras.
+        if (invertido!=NULL){
+            unsigned long long cant_apariciones;
+            unsigned long bytes;
+
+            traza_comenzar("escribir cadauno", NULL);
+            invertido_exportar_por_archivo(invertido, nombre_archivo, cant_filas, f_cadauno);
+            traza_terminar("escribir cadauno");
+            invertido_estadisticas(invertido, &cant_apariciones, &bytes);
+            printf("Indice invertido: %u palabras distintas en %llu pares (palabra, archivo); listas: %.1f MB, diccionario: %.1f MB.\n",
+                   multiset_cantidad_palabras(multiset_total), cant_apariciones, bytes / (1024.0*1024.0), multiset_memoria(multiset_total) / (1024.0*1024.0));
+            invertido_eliminar(&invertido);
+        }
     }
+    cuentapalabras_liberar_memoria_nombres_archivos(rutas, cant_filas);
 
     //Finalmente, para el multiset_total es cargado en el archivo totales.out
-    aux_exportar_multiset_a_archivo(f_totales, NULL, multiset_total);
+    traza_comenzar("escribir totales", NULL);
+    if (total.cant_corridas==0 && opciones->cant_trabajadores>1){
+        //Con varios trabajadores, totales.out también se ordena y escribe en paralelo.
+        exportacion_escribir_por_frecuencia(multiset_total, f_totales, opciones->cant_trabajadores);
+    }
+    else if (total.cant_corridas==0){
+        aux_exportar_multiset_a_archivo(f_totales, NULL, multiset_total, NULL);
+    }
+    else{
+        //Si hubo volcados a disco, lo que resta en memoria se vuelca como última corrida y se combinan todas ellas.
+        aux_volcar_total(&total);
+
+        char path_tramos[260];
+        strcpy(path_tramos, directorio);
+        strcat(path_tramos, SEPARADOR_DIRECTORIO "totales.tramo");
+        traza_comenzar("mezclar corridas", NULL);
+        mezcla_k_vias(total.corridas, total.cant_corridas, funcion_comparacion, opciones->memoria_max, path_tramos, f_totales);
+        traza_terminar("mezclar corridas");
+
+        //Elimina las corridas volcadas.
+        for (int i=0; i<total.cant_corridas; i++){
+            mezcla_eliminar_corrida(total.corridas[i]);
+            free(total.corridas[i]);
+        }
+        free(total.corridas);
+    }
+    traza_terminar("escribir totales");
+
+    //Las secuencias de palabras se escriben en ngramas.out.
+    if (ngramas!=NULL){
+        char path_ngramas[260];
+        strcpy(path_ngramas, directorio);
+        strcat(path_ngramas, SEPARADOR_DIRECTORIO "ngramas.out");
+        strcat(path_ngramas, compresion_extension(opciones->compresion_salida));
+
+        FILE *f_ngramas = compresion_abrir_salida(path_ngramas, opciones->compresion_salida);
+        if (f_ngramas==NULL){
+            printf("Error -8: Error en creacion de archivo: ngramas.out\n");
+            exit(ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA);
+        }
+        traza_comenzar("escribir ngramas", NULL);
+        ngrama_exportar(ngramas, multiset_total, f_ngramas);
+        traza_terminar("escribir ngramas");
+        fclose(f_ngramas);
+        ngrama_eliminar(&ngramas);
+    }
 
     //Cerrar archivos iniciales.
     fclose(f_cadauno);
@@ -449,6 +1081,519 @@ static void cuentapalabras_construir_archivos_salida(char* directorio, char** no
     m = NULL;
 }
 
+//----MODO DE FLUJO----
+
+/**
+ * @brief Escribe el multiset en 'path_temporal' y luego lo renombra a 'path_final', de modo que quien lea 'path_final'
+ * nunca encuentre un archivo a medio escribir.
+ * @throw ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA si no se pudo crear el archivo.
+*/
+static void aux_escribir_totales(multiset_t *m, char *path_temporal, char *path_final){
+    FILE *f = fopen(path_temporal, "w");
+    if (f==NULL){
+        printf("Error %d: Error en creacion de archivo: %s\n", ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA, path_temporal);
+        exit(ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA);
+    }
+    aux_exportar_multiset_a_archivo(f, NULL, m, NULL);
+    fclose(f);
+
+#ifdef _WIN32
+    //En Windows rename no reemplaza un archivo existente.
+    remove(path_final);
+#endif
+    rename(path_temporal, path_final);
+}
+
+/**
+ * @struct flujo
+ * @brief Modela el estado del modo de flujo: el multiset de totales y la instantánea en curso.
+*/
+struct flujo {
+    multiset_t *total; ///Multiset con las palabras leidas.
+    char *path_temporal; ///Ruta donde se escribe cada instantánea antes de renombrarla.
+    char *path_totales; ///Ruta del archivo totales.out.
+#ifndef _WIN32
+    pid_t escritor; ///Proceso que escribe la instantánea en curso, o 0 si no hay ninguna.
+#endif
+};
+
+/**
+ * @brief Función que recibe cada palabra del flujo y la inserta en el multiset de totales.
+*/
+static void aux_procesar_palabra_flujo(char *palabra, void *contexto){
+    multiset_insertar(((struct flujo*) contexto)->total, palabra);
+}
+
+/**
+ * @brief Escribe una instantánea del multiset de totales sin detener la lectura del flujo.
+ * En sistemas POSIX la escritura la realiza un proceso hijo, que comparte las páginas del multiset con el proceso
+ * lector hasta que este las modifica (copy-on-write), por lo que el multiset no se copia ni se bloquea.
+ * @param F Puntero al estado del flujo.
+ * @return TRUE si se inició la instantánea, FALSE si la anterior aún no terminó (debe reintentarse luego).
+*/
+static int aux_escribir_instantanea(struct flujo *F){
+    int to_return = TRUE;
+
+#ifndef _WIN32
+    if (F->escritor>0 && waitpid(F->escritor, NULL, WNOHANG)==0){
+        to_return = FALSE;
+    }
+    else{
+        //Se vacía stdout para que el hijo no repita la salida pendiente del padre.
+        fflush(stdout);
+        F->escritor = fork();
+        if (F->escritor==0){
+            aux_escribir_totales(F->total, F->path_temporal, F->path_totales);
+            _exit(0);
+        }
+        else if (F->escritor<0){
+            //Sin un proceso hijo, la instantánea se escribe deteniendo la lectura.
+            F->escritor = 0;
+            aux_escribir_totales(F->total, F->path_temporal, F->path_totales);
+        }
+    }
+#else
+    aux_escribir_totales(F->total, F->path_temporal, F->path_totales);
+#endif
+
+    return to_return;
+}
+
+/**
+ * @brief Lee un bloque de la entrada estándar, esperando a lo sumo 'espera_ms' milisegundos (negativo espera sin límite).
+ * @return Cantidad de bytes leidos, 0 al finalizar la entrada o -1 si se agotó la espera sin datos.
+*/
+static long aux_leer_bloque(char *bloque, int espera_ms){
+    long to_return = -1;
+
+#ifndef _WIN32
+    struct pollfd entrada = {STDIN_FILENO, POLLIN, 0};
+    int listo = poll(&entrada, 1, espera_ms);
+
+    if (listo>0){
+        to_return = read(STDIN_FILENO, bloque, TAMANIO_BLOQUE_FLUJO);
+        if (to_return<0){
+            //Una interrupción por señal se trata como una espera sin datos; cualquier otro error finaliza la entrada.
+            to_return = (errno==EINTR) ? -1 : 0;
+        }
+    }
+#else
+    to_return = fread(bloque, 1, TAMANIO_BLOQUE_FLUJO, stdin);
+#endif
+
+    return to_return;
+}
+
+/**
+ * @brief Devuelve el tiempo transcurrido en milisegundos desde un instante fijo.
+*/
+static long long aux_milisegundos(){
+#ifndef _WIN32
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((long long) t.tv_sec)*1000 + t.tv_nsec/1000000;
+#else
+    return ((long long) clock())*1000/CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * @brief Lee palabras de la entrada estándar hasta su fin, escribiendo instantáneas de totales.out en el directorio dado
+ * cada 'segundos_instantanea' segundos o 'bytes_instantanea' bytes leidos, y una última al finalizar.
+ * @param directorio Puntero a cadena de caracteres que representa el directorio de salida.
+ * @param opciones Puntero a las opciones con las que se invocó el programa.
+ * @throw ERROR_CUENTAPALABRAS_MEMORIA si no se pudo reservar memoria para el bloque de lectura.
+*/
+static void cuentapalabras_procesar_flujo(char *directorio, opciones_t *opciones){
+    char path_totales[260];
+    char path_temporal[260];
+    lector_flujo_t lector;
+    struct flujo F;
+    char *bloque = (char*) malloc(TAMANIO_BLOQUE_FLUJO);
+    long long intervalo_ms = ((long long) opciones->segundos_instantanea)*1000;
+    long long proxima = aux_milisegundos() + intervalo_ms;
+    unsigned long bytes_desde_instantanea = 0;
+    int cant_instantaneas = 0;
+    long leidos = -1;
+
+    if (bloque==NULL){
+        printf("Error %d: No se pudo reservar memoria para el bloque de lectura.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+        exit(ERROR_CUENTAPALABRAS_MEMORIA);
+    }
+    strcpy(path_totales, directorio);
+    strcat(path_totales, SEPARADOR_DIRECTORIO "totales.out");
+    strcpy(path_temporal, path_totales);
+    strcat(path_temporal, ".tmp");
+
+    F.total = multiset_crear_modo(opciones->modo_multiset);
+    F.path_temporal = path_temporal;
+    F.path_totales = path_totales;
+#ifndef _WIN32
+    F.escritor = 0;
+#endif
+    lector_flujo_iniciar(&lector);
+
+    while (leidos!=0){
+        //Sin límite de tiempo entre instantáneas, se espera sin límite a que lleguen datos.
+        long long espera = (intervalo_ms>0) ? proxima - aux_milisegundos() : -1;
+        leidos = aux_leer_bloque(bloque, (intervalo_ms>0 && espera<0) ? 0 : (int) espera);
+
+        if (leidos>0){
+            lector_flujo_procesar(&lector, bloque, leidos, aux_procesar_palabra_flujo, &F);
+            bytes_desde_instantanea = bytes_desde_instantanea + leidos;
+        }
+        if (leidos!=0){
+            int vencido = (intervalo_ms>0) && (aux_milisegundos()>=proxima);
+            int excedido = (opciones->bytes_instantanea>0) && (bytes_desde_instantanea>=opciones->bytes_instantanea);
+
+            if (vencido || excedido){
+                if (aux_escribir_instantanea(&F)==TRUE){
+                    proxima = aux_milisegundos() + intervalo_ms;
+                    bytes_desde_instantanea = 0;
+                    cant_instantaneas = cant_instantaneas + 1;
+                }
+                else{
+                    //La instantánea anterior aún se está escribiendo: se reintenta en breve.
+                    proxima = aux_milisegundos() + ESPERA_REINTENTO_INSTANTANEA;
+                }
+            }
+        }
+    }
+    lector_flujo_finalizar(&lector, aux_procesar_palabra_flujo, &F);
+
+    //La última instantánea se escribe luego de que termine la anterior, para que esta no la reemplace.
+#ifndef _WIN32
+    if (F.escritor>0){
+        waitpid(F.escritor, NULL, 0);
+    }
+#endif
+    aux_escribir_totales(F.total, path_temporal, path_totales);
+    printf("Entrada finalizada. Se escribieron %d instantaneas intermedias y el archivo final '%s'.\n", cant_instantaneas, path_totales);
+
+    multiset_eliminar(&(F.total));
+    free(bloque);
+}
+
+//----MODO DE COMPARACION----
+
+/**
+ * @struct conteo_directorio
+ * @brief Modela el multiset donde se suman las palabras de los archivos de un directorio.
+*/
+struct conteo_directorio {
+    multiset_t *total; ///Multiset de totales.
+    char **nombre_archivo; ///Nombres de los archivos, en el orden en que se leen.
+    struct archivo_por_partes partes; ///Separación en palabras del archivo actual, si se recibe por partes.
+};
+
+/**
+ * @brief Función que recibe el contenido de cada archivo de un directorio, completo o por partes, y suma sus palabras
+ * a los totales.
+ * @throw ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO si no se pudo abrir o leer el archivo.
+*/
+static void aux_contar_archivo_leido(int indice, char *contenido, unsigned long n, int parte, void *contexto){
+    struct conteo_directorio *conteo = (struct conteo_directorio*) contexto;
+    int formato = compresion_formato_de_nombre(conteo->nombre_archivo[indice]);
+
+    if (contenido==NULL){
+        printf("Error -7: Error en apertura de archivo\n");
+        exit(ERROR_CUENTAPALABRAS_APERTURA_ARCHIVO);
+    }
+    if (parte==LOTE_ARCHIVO_COMPLETO){
+        aux_separar_palabras(contenido, n, formato, aux_insertar_palabra, conteo->total);
+    }
+    else{
+        if (parte==LOTE_PARTE_INICIAL){
+            aux_iniciar_partes(&(conteo->partes), formato, NULL, aux_insertar_palabra, conteo->total);
+        }
+        aux_procesar_parte(&(conteo->partes), contenido, n);
+        if (parte==LOTE_PARTE_FINAL){
+            aux_finalizar_partes(&(conteo->partes));
+        }
+    }
+}
+
+/**
+ * @brief Cuenta las palabras de todos los archivos de texto del directorio dado, sin escribir archivos de salida.
+ * @param d Puntero al controlador del directorio.
+ * @param directorio Ruta del directorio.
+ * @param modo Implementación del multiset a construir.
+ * @return Multiset con los totales del directorio.
+*/
+static multiset_t *aux_contar_directorio(DIR *d, char *directorio, int modo){
+    int cant_filas = 0;
+    char **nombre_archivo = cuentapalabras_recopilar_nombres_archivos_txt(d, &cant_filas);
+    char **rutas = cuentapalabras_construir_rutas(directorio, nombre_archivo, cant_filas);
+    multiset_t *to_return = multiset_crear_modo(modo);
+    struct conteo_directorio conteo = {to_return, nombre_archivo};
+
+    lote_leer_archivos(rutas, cant_filas, aux_contar_archivo_leido, &conteo);
+    cuentapalabras_liberar_memoria_nombres_archivos(rutas, cant_filas);
+    cuentapalabras_liberar_memoria_nombres_archivos(nombre_archivo, cant_filas);
+
+    return to_return;
+}
+
+/**
+ * @brief Carga en un multiset un índice guardado, esto es, un archivo con el formato de totales.out ("cantidad   palabra"
+ * por linea), como el que genera una ejecución anterior con -h.
+ * @param f Puntero al archivo del índice, abierto para lectura.
+ * @param modo Implementación del multiset a construir.
+ * @throw ERROR_CUENTAPALABRAS_MEMORIA si no se pudo reservar memoria para las palabras.
+ * @return Multiset con las palabras del índice.
+*/
+static multiset_t *aux_cargar_indice(FILE *f, int modo){
+    multiset_t *to_return = multiset_crear_modo(modo);
+    unsigned long capacidad = 64;
+    char *palabra = (char*) malloc(capacidad);
+    long long cantidad;
+
+    if (palabra==NULL){
+        printf("Error %d: No se pudo reservar memoria para el indice.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+        exit(ERROR_CUENTAPALABRAS_MEMORIA);
+    }
+    while (fscanf(f, "%lld", &cantidad)==1){
+        unsigned long longitud = 0;
+        int ch = fgetc(f);
+        //Se descartan los espacios que separan la cantidad de la palabra, que llega hasta el fin de linea.
+        while (ch==' '){
+            ch = fgetc(f);
+        }
+        while (ch!='\n' && ch!=EOF){
+            if (longitud+1==capacidad){
+                capacidad = 2*capacidad;
+                palabra = (char*) realloc(palabra, capacidad);
+                if (palabra==NULL){
+                    printf("Error %d: No se pudo reservar memoria para el indice.\n", ERROR_CUENTAPALABRAS_MEMORIA);
+                    exit(ERROR_CUENTAPALABRAS_MEMORIA);
+                }
+            }
+            palabra[longitud] = (char) ch;
+            longitud = longitud + 1;
+            ch = fgetc(f);
+        }
+        palabra[longitud] = '\0';
+        if (cantidad>0 && longitud>0){
+            multiset_insertar_cantidad(to_return, palabra, cantidad);
+        }
+    }
+    free(palabra);
+
+    return to_return;
+}
+
+/**
+ * @brief Construye el multiset de la ruta dada, que puede ser un directorio de archivos de texto o un índice guardado.
+ * @throw ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO si la ruta no es un directorio ni un archivo legible.
+*/
+static multiset_t *aux_construir_multiset_de_ruta(char *path, int modo){
+    multiset_t *to_return = NULL;
+    DIR *d = cuentapalabras_abrir_directorio(path);
+
+    if (d!=NULL){
+        to_return = aux_contar_directorio(d, path, modo);
+        closedir(d);
+    }
+    else{
+        FILE *f = fopen(path, "r");
+        if (f==NULL){
+            printf("\nError %d: Ruta invalida '%s'. Indique un directorio o un indice (totales.out) existente.\n", ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO, path);
+            exit(ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO);
+        }
+        to_return = aux_cargar_indice(f, modo);
+        fclose(f);
+    }
+
+    return to_return;
+}
+
+/**
+ * @struct comparacion
+ * @brief Modela el archivo de diferencias y la cantidad de palabras de cada tipo que se escribieron en él.
+*/
+struct comparacion {
+    FILE *f_diferencias; ///Archivo diferencias.out.
+    unsigned long agregadas; ///Palabras que solo están en el actual.
+    unsigned long removidas; ///Palabras que solo están en el anterior.
+    unsigned long modificadas; ///Palabras cuya cantidad de repeticiones cambió.
+};
+
+/**
+ * @brief Función que escribe en diferencias.out cada palabra que difiere, con su variación y sus cantidades anterior y actual.
+*/
+static void aux_escribir_diferencia(char *palabra, long long cantidad_anterior, long long cantidad_actual, void *contexto){
+    struct comparacion *C = (struct comparacion*) contexto;
+
+    fprintf(C->f_diferencias, "%+lld   %s   (%lld -> %lld)\n", cantidad_actual - cantidad_anterior, palabra, cantidad_anterior, cantidad_actual);
+    if (cantidad_anterior==0){
+        C->agregadas = C->agregadas + 1;
+    }
+    else if (cantidad_actual==0){
+        C->removidas = C->removidas + 1;
+    }
+    else{
+        C->modificadas = C->modificadas + 1;
+    }
+}
+
+/**
+ * @brief Compara los totales de 'anterior' (un directorio o un índice guardado) con los del directorio 'actual' y escribe
+ * en 'actual' el archivo diferencias.out, con las palabras agregadas, removidas o cuya cantidad cambió en orden lexicográfico.
+ * @param anterior Ruta del directorio o índice de referencia.
+ * @param actual Ruta del directorio a comparar.
+ * @param opciones Puntero a las opciones con las que se invocó el programa.
+ * @throw ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO si 'actual' no es un directorio, su ruta es demasiado larga o
+ * 'anterior' no es válido.
+ * @throw ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA si no se pudo crear diferencias.out.
+*/
+static void cuentapalabras_comparar(char *anterior, char *actual, opciones_t *opciones){
+    char path_diferencias[260];
+    //La ruta de diferencias.out se arma antes de contar, rechazando la que no entre en el arreglo.
+    int longitud = snprintf(path_diferencias, sizeof(path_diferencias), "%s" SEPARADOR_DIRECTORIO "diferencias.out", actual);
+    DIR *d = (longitud>=0 && longitud<(int) sizeof(path_diferencias)) ? cuentapalabras_abrir_directorio(actual) : NULL;
+
+    if (d==NULL){
+        mostrar_mensaje_ruta_invalida();
+        exit(ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO);
+    }
+    multiset_t *m_actual = aux_contar_directorio(d, actual, opciones->modo_multiset);
+    closedir(d);
+    multiset_t *m_anterior = aux_construir_multiset_de_ruta(anterior, opciones->modo_multiset);
+
+    struct comparacion C = {fopen(path_diferencias, "w"), 0, 0, 0};
+    if (C.f_diferencias==NULL){
+        printf("Error -8: Error en creacion de archivo: diferencias.out\n");
+        exit(ERROR_CUENTAPALABRAS_CREACION_ARCHIVO_SALIDA);
+    }
+    multiset_diferencia(m_anterior, m_actual, aux_escribir_diferencia, &C);
+    fclose(C.f_diferencias);
+
+    printf("Comparacion de '%s' respecto de '%s': %lu palabras agregadas, %lu removidas y %lu con otra cantidad.\n", actual, anterior, C.agregadas, C.removidas, C.modificadas);
+    printf("Archivo 'diferencias.out' creado con exito en el directorio '%s'.\n", actual);
+
+    multiset_eliminar(&m_anterior);
+    multiset_eliminar(&m_actual);
+}
+
+/**
+ * @brief Recupera los parámetros opcionales que siguen a las rutas de entrada (a partir de argv[primero]).
+ * @param argc Cantidad de parámetros.
+ * @param argv Puntero a punteros de cadenas de caracteres con los parámetros.
+ * @param primero Posición del primer parámetro opcional.
+ * @param opciones Puntero a las opciones a completar.
+ * @throw ERROR_CUENTAPALABRAS_OPCION_INVALIDA si algún parámetro no es válido.
+*/
+static void cuentapalabras_leer_opciones(int argc, char *argv[], int primero, opciones_t *opciones){
+    //Valores por defecto.
+    opciones->memoria_max = 0;
+    opciones->modo_multiset = MULTISET_MODO_TRIE;
+    opciones->capacidad_aproximado = MULTISET_APROXIMADO_CAPACIDAD;
+    opciones->error_aproximado = MULTISET_APROXIMADO_ERROR;
+    opciones->longitud_ngramas = 0;
+    opciones->segundos_instantanea = 10;
+    opciones->bytes_instantanea = 0;
+    opciones->cant_trabajadores = 0;
+    opciones->paginas_grandes = FALSE;
+    opciones->compresion_salida = COMPRESION_NINGUNA;
+    opciones->plegado = ALFABETO_PLEGADO_NINGUNO;
+    opciones->path_traza = NULL;
+    opciones->indice_invertido = FALSE;
+
+    for (int i=primero; i<argc; i++){
+        if ((strcmp(argv[i], "-m")==0) && (i+1<argc) && (atol(argv[i+1])>0)){
+            opciones->memoria_max = ((unsigned long) atol(argv[i+1])) * 1024 * 1024;
+            i = i + 1;
+        }
+        else if (strcmp(argv[i], "-c")==0){
+            opciones->modo_multiset = MULTISET_MODO_COMPACTO;
+        }
+        else if (strcmp(argv[i], "-r")==0){
+            opciones->modo_multiset = MULTISET_MODO_RAFAGA;
+        }
+        else if ((strcmp(argv[i], "-a")==0) && (i+1<argc) && (atoi(argv[i+1])>0)){
+            opciones->modo_multiset = MULTISET_MODO_APROXIMADO;
+            opciones->capacidad_aproximado = atoi(argv[i+1]);
+            i = i + 1;
+        }
+        else if ((strcmp(argv[i], "-p")==0) && (i+1<argc) && (atof(argv[i+1])>0) && (atof(argv[i+1])<1)){
+            opciones->error_aproximado = atof(argv[i+1]);
+            i = i + 1;
+        }
+        else if ((strcmp(argv[i], "-n")==0) && (i+1<argc) && (atoi(argv[i+1])>=2) && (atoi(argv[i+1])<=NGRAMA_MAXIMO)){
+            opciones->longitud_ngramas = atoi(argv[i+1]);
+            i = i + 1;
+        }
+        else if ((strcmp(argv[i], "-t")==0) && (i+1<argc) && (atoi(argv[i+1])>=0)){
+            opciones->segundos_instantanea = atoi(argv[i+1]);
+            i = i + 1;
+        }
+        else if ((strcmp(argv[i], "-b")==0) && (i+1<argc) && (atol(argv[i+1])>0)){
+            opciones->bytes_instantanea = ((unsigned long) atol(argv[i+1])) * 1024 * 1024;
+            i = i + 1;
+        }
+#ifndef _WIN32
+        else if ((strcmp(argv[i], "-j")==0) && (i+1<argc) && (atoi(argv[i+1])>0)){
+            opciones->cant_trabajadores = atoi(argv[i+1]);
+            i = i + 1;
+        }
+#endif
+        else if (strcmp(argv[i], "-g")==0){
+            opciones->paginas_grandes = TRUE;
+        }
+        else if ((strcmp(argv[i], "-z")==0) && (i+1<argc) && ((strcmp(argv[i+1], "gz")==0) || (strcmp(argv[i+1], "zst")==0))){
+            opciones->compresion_salida = (strcmp(argv[i+1], "gz")==0) ? COMPRESION_GZIP : COMPRESION_ZSTD;
+            if (compresion_disponible(opciones->compresion_salida)==FALSE){
+                printf("Error %d: La compresion '%s' no esta disponible en esta compilacion.\n", ERROR_CUENTAPALABRAS_OPCION_INVALIDA, argv[i+1]);
+                exit(ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+            }
+            i = i + 1;
+        }
+        else if ((strcmp(argv[i], "-u")==0) && (i+1<argc) && ((strcmp(argv[i+1], "mayusculas")==0) || (strcmp(argv[i+1], "latino")==0))){
+            opciones->plegado = (strcmp(argv[i+1], "mayusculas")==0) ? ALFABETO_PLEGADO_MAYUSCULAS : ALFABETO_PLEGADO_LATINO;
+            i = i + 1;
+        }
+        else if (strcmp(argv[i], "-i")==0){
+            opciones->indice_invertido = TRUE;
+        }
+        else if ((strcmp(argv[i], "-x")==0) && (i+1<argc)){
+            opciones->path_traza = argv[i+1];
+            i = i + 1;
+        }
+        else{
+            printf("Error %d: Parametro invalido '%s'.\n", ERROR_CUENTAPALABRAS_OPCION_INVALIDA, argv[i]);
+            mostrar_mensaje_opciones();
+            exit(ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+        }
+    }
+
+    //Las secuencias se identifican por los identificadores de los totales, que solo asigna el trie y que un volcado descartaría.
+    if (opciones->longitud_ngramas>0 && (opciones->modo_multiset!=MULTISET_MODO_TRIE || opciones->memoria_max>0)){
+        printf("Error %d: El parametro -n no puede combinarse con -c, -r, -a ni -m.\n", ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+        exit(ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+    }
+
+    //Los totales de cada trabajador se combinan sumando sus palabras: el conteo aproximado solo conserva las más
+    //repetidas, los identificadores de las secuencias dependen del orden de inserción y un volcado no puede combinarse.
+    if (opciones->cant_trabajadores>0 && (opciones->modo_multiset==MULTISET_MODO_APROXIMADO || opciones->memoria_max>0 || opciones->longitud_ngramas>0)){
+        printf("Error %d: El parametro -j no puede combinarse con -a, -m ni -n.\n", ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+        exit(ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+    }
+
+    //El índice invertido indexa sus listas con los identificadores del trie de totales, que un volcado descartaría, y
+    //reemplaza a los multisets por archivo, que son los que construyen los trabajadores.
+    if (opciones->indice_invertido==TRUE && (opciones->modo_multiset!=MULTISET_MODO_TRIE || opciones->memoria_max>0 || opciones->cant_trabajadores>0)){
+        printf("Error %d: El parametro -i no puede combinarse con -c, -r, -a, -m ni -j.\n", ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+        exit(ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+    }
+
+    multiset_configurar_aproximado(opciones->error_aproximado, opciones->capacidad_aproximado);
+    multiset_configurar_paginas_grandes(opciones->paginas_grandes);
+    alfabeto_configurar_plegado(opciones->plegado);
+    if (opciones->path_traza!=NULL){
+        traza_iniciar(opciones->path_traza);
+    }
+}
+
 //----MAIN----
 
 int main(int argc, char *argv[]){
@@ -460,6 +1605,10 @@ int main(int argc, char *argv[]){
     else{
         //Si la comparacion devuelve 0, entonces se tiene que ambas cadenas son iguales.
         if (strcmp(argv[1], "-h")==0){
+            //Recupero los parámetros opcionales que siguen al directorio.
+            opciones_t opciones;
+            cuentapalabras_leer_opciones(argc, argv, 3, &opciones);
+
             mostrar_mensaje_bienvenida();
             //Abre el directorio y recupera el puntero al manejador de archivos.
             DIR* dir = cuentapalabras_abrir_directorio(argv[2]);
@@ -478,7 +1627,9 @@ int main(int argc, char *argv[]){
                 (*p_cant_filas) = 0;
 
                 //Recupero todos los nombres de archivos de texto.
+                traza_comenzar("explorar directorio", argv[2]);
                 char** nombre_archivo = cuentapalabras_recopilar_nombres_archivos_txt(dir, p_cant_filas);
+                traza_terminar("explorar directorio");
                 int cant_filas = *p_cant_filas;
 
                 //Si hay archivos de texto a leer.
@@ -486,7 +1637,7 @@ int main(int argc, char *argv[]){
                     //Muestra los archivos de texto del directorio.
                     mostrar_mensaje_archivos_a_analizar(argv[2], nombre_archivo, *p_cant_filas);
                     //Realizar la construcción de los archivos de salida.
-                    cuentapalabras_construir_archivos_salida(argv[2], nombre_archivo, cant_filas);
+                    cuentapalabras_construir_archivos_salida(argv[2], nombre_archivo, cant_filas, &opciones);
                     //Libera la memoria utilizada por nombre_archivo y su respectivo contador.
                     cuentapalabras_liberar_memoria_nombres_archivos(nombre_archivo, cant_filas);
 
@@ -510,8 +1661,31 @@ int main(int argc, char *argv[]){
                 exit(ERROR_CUENTAPALABRAS_APERTURA_DIRECTORIO);
             }
         }
+        else if ((strcmp(argv[1], "-e")==0) && (argc>2)){
+            //Modo de flujo: las palabras se leen de la entrada estándar en lugar de un directorio.
+            opciones_t opciones;
+            cuentapalabras_leer_opciones(argc, argv, 3, &opciones);
+            //Cada instantánea escribe los totales sin detener la lectura, lo que un volcado a disco impediría.
+            if (opciones.memoria_max>0){
+                printf("Error %d: El parametro -m no puede combinarse con -e.\n", ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+                exit(ERROR_CUENTAPALABRAS_OPCION_INVALIDA);
+            }
+            cuentapalabras_procesar_flujo(argv[2], &opciones);
+        }
+        else if ((strcmp(argv[1], "-s")==0) && (argc>2)){
+            //Modo servidor: los multisets quedan residentes y se consultan a través del socket dado.
+            opciones_t opciones;
+            cuentapalabras_leer_opciones(argc, argv, 3, &opciones);
+            servidor_ejecutar(argv[2], opciones.modo_multiset);
+        }
+        else if ((strcmp(argv[1], "-d")==0) && (argc>3)){
+            //Modo de comparación: se informan las diferencias entre los totales de dos directorios, o de un índice y un directorio.
+            opciones_t opciones;
+            cuentapalabras_leer_opciones(argc, argv, 4, &opciones);
+            cuentapalabras_comparar(argv[2], argv[3], &opciones);
+        }
         else{
-            //Si la cadena es distinta a "-h", entonces mostrar mensaje con opciones.
+            //Si la cadena es distinta a "-h", "-e", "-s" y "-d", entonces mostrar mensaje con opciones.
             mostrar_mensaje_opciones();
         }
     }
@@ -0,0 +1,393 @@
+/**
+* @file exportacion.c
+* @brief Implementación del TDA Exportacion.
+* Las palabras se dividen en una parte por caracter inicial. Como las partes abarcan rangos consecutivos del alfabeto, a igual
+* cantidad de repeticiones las palabras de una parte preceden a las de las partes siguientes, por lo que el orden de la
+* salida queda determinado por la cantidad y el número de parte, sin comparar cadenas.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "exportacion.h"
+#include "alfabeto.h"
+#include "traza.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+#endif
+
+//Cantidad de partes en que se divide el vocabulario (una por caracter inicial del alfabeto).
+#define EXPORTACION_PARTES ALFABETO_TAMANIO
+//Capacidad inicial del búfer de cada hilo.
+#define EXPORTACION_BUFER_INICIAL (1 << 16)
+
+/**
+ * @struct parte
+ * @brief Modela las palabras de una letra inicial, ordenadas por cantidad de repeticiones.
+*/
+struct parte {
+    elemento_t *elementos; //Arreglo de elementos ordenados.
+    int cantidad; //Cantidad de elementos.
+};
+
+/**
+ * @struct exportacion
+ * @brief Modela el estado compartido por los hilos de una exportación.
+*/
+struct exportacion {
+    multiset_t *m; //Multiset a exportar.
+    int cant_hilos; //Cantidad de hilos.
+    struct parte partes[EXPORTACION_PARTES]; //Partes del vocabulario.
+    int siguiente_parte; //Próxima parte a recopilar.
+#ifndef _WIN32
+    pthread_mutex_t mutex; //Protege a 'siguiente_parte'.
+#endif
+    int **cortes; //cortes[t][q] es la posición de la parte q donde comienza el tramo del hilo t (t entre 0 y cant_hilos).
+    char **buferes; //Búfer con el tramo formateado de cada hilo.
+    unsigned long *longitudes; //Cantidad de bytes del búfer de cada hilo.
+    unsigned long *desplazamientos; //Posición del archivo, relativa al inicio de la salida, donde se escribe cada tramo.
+#ifndef _WIN32
+    int descriptor; //Descriptor del archivo de salida.
+    off_t inicio; //Posición del archivo donde comienza la salida.
+#endif
+};
+
+/**
+ * @typedef void(fase_t)
+ * @brief Plantilla de las funciones que ejecuta cada hilo en una fase de la exportación.
+*/
+typedef void (fase_t)(struct exportacion *E, int hilo);
+
+/**
+ * @struct hilo_exportacion
+ * @brief Modela los parámetros de un hilo de una fase.
+*/
+struct hilo_exportacion {
+    struct exportacion *E; //Estado de la exportación.
+    fase_t *fase; //Función a ejecutar.
+    const char *nombre; //Nombre de la fase en la traza (ver traza.h).
+    int indice; //Número del hilo.
+};
+
+/**
+ * @brief Operación Reserva 'bytes' bytes de memoria.
+ * @throw ERROR_EXPORTACION_MEMORIA si no se pudo reservar la memoria.
+*/
+static void *aux_reservar(unsigned long bytes){
+    void *to_return = malloc(bytes);
+    if (to_return==NULL){
+        printf("Error %d: No se pudo reservar memoria para la exportacion.\n", ERROR_EXPORTACION_MEMORIA);
+        exit(ERROR_EXPORTACION_MEMORIA);
+    }
+    return to_return;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Operación Función que ejecuta cada hilo de una fase.
+*/
+static void *aux_ejecutar_hilo(void *contexto){
+    struct hilo_exportacion *H = (struct hilo_exportacion*) contexto;
+    traza_comenzar(H->nombre, NULL);
+    H->fase(H->E, H->indice);
+    traza_terminar(H->nombre);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Operación Ejecuta la fase dada en cada uno de los hilos de la exportación y espera a que todos terminen.
+*/
+static void aux_ejecutar_fase(struct exportacion *E, fase_t fase, const char *nombre){
+#ifndef _WIN32
+    pthread_t hilos[E->cant_hilos];
+    struct hilo_exportacion parametros[E->cant_hilos];
+
+    //El primer tramo lo ejecuta el hilo invocador.
+    for (int i=1; i<E->cant_hilos; i++){
+        parametros[i].E = E;
+        parametros[i].fase = fase;
+        parametros[i].nombre = nombre;
+        parametros[i].indice = i;
+        pthread_create(&(hilos[i]), NULL, aux_ejecutar_hilo, &(parametros[i]));
+    }
+    traza_comenzar(nombre, NULL);
+    fase(E, 0);
+    traza_terminar(nombre);
+    for (int i=1; i<E->cant_hilos; i++){
+        pthread_join(hilos[i], NULL);
+    }
+#else
+    traza_comenzar(nombre, NULL);
+    for (int i=0; i<E->cant_hilos; i++){
+        fase(E, i);
+    }
+    traza_terminar(nombre);
+#endif
+}
+
+/**
+ * @brief Operación Fase 1: el hilo recopila y ordena las partes que aún no tomó otro hilo.
+*/
+static void aux_fase_recopilar(struct exportacion *E, int hilo){
+    int parte = 0;
+    (void) hilo;
+
+    while (parte<EXPORTACION_PARTES){
+#ifndef _WIN32
+        pthread_mutex_lock(&(E->mutex));
+#endif
+        parte = E->siguiente_parte;
+        E->siguiente_parte = E->siguiente_parte + 1;
+#ifndef _WIN32
+        pthread_mutex_unlock(&(E->mutex));
+#endif
+        if (parte<EXPORTACION_PARTES){
+            char prefijo[2] = {ALFABETO_CARACTER(parte), '\0'};
+            E->partes[parte].elementos = multiset_arreglo_por_frecuencia(E->m, prefijo, &(E->partes[parte].cantidad));
+        }
+    }
+}
+
+/**
+ * @brief Operación Devuelve la posición del primer elemento de la parte P con una cantidad de repeticiones mayor o igual a 'cantidad'.
+*/
+static int aux_primera_posicion(struct parte *P, long long cantidad){
+    int desde = 0;
+    int hasta = P->cantidad;
+
+    while (desde<hasta){
+        int medio = desde + (hasta - desde) / 2;
+        if (P->elementos[medio].a<cantidad){
+            desde = medio + 1;
+        }
+        else{
+            hasta = medio;
+        }
+    }
+
+    return desde;
+}
+
+/**
+ * @brief Operación Devuelve cuantos elementos de todas las partes tienen una cantidad de repeticiones menor a 'cantidad'.
+*/
+static long long aux_cantidad_menores(struct exportacion *E, long long cantidad){
+    long long to_return = 0;
+    for (int q=0; q<EXPORTACION_PARTES; q++){
+        to_return = to_return + aux_primera_posicion(&(E->partes[q]), cantidad);
+    }
+    return to_return;
+}
+
+/**
+ * @brief Operación Calcula, para cada parte, cuantos de sus elementos preceden al elemento de posición 'rango' de la salida.
+ * Primero se busca la cantidad de repeticiones de dicho elemento y luego, entre los elementos con esa cantidad, se toman
+ * los primeros de cada parte en orden de parte.
+ * @param E Puntero al estado de la exportación.
+ * @param rango Posición de la salida, entre 0 y la cantidad total de elementos.
+ * @param cortes Arreglo donde se almacena la posición de cada parte.
+*/
+static void aux_calcular_corte(struct exportacion *E, long long rango, int *cortes){
+    long long menor = 0;
+    long long mayor = 1;
+
+    //Se busca la mayor cantidad 'menor' tal que los elementos con menos repeticiones no superen al rango.
+    for (int q=0; q<EXPORTACION_PARTES; q++){
+        if (E->partes[q].cantidad>0 && E->partes[q].elementos[E->partes[q].cantidad-1].a>=mayor){
+            mayor = E->partes[q].elementos[E->partes[q].cantidad-1].a + 1;
+        }
+    }
+    while (mayor-menor>1){
+        long long medio = menor + (mayor - menor) / 2;
+        if (aux_cantidad_menores(E, medio)<=rango){
+            menor = medio;
+        }
+        else{
+            mayor = medio;
+        }
+    }
+
+    long long restantes = rango - aux_cantidad_menores(E, menor);
+    for (int q=0; q<EXPORTACION_PARTES; q++){
+        int desde = aux_primera_posicion(&(E->partes[q]), menor);
+        int hasta = aux_primera_posicion(&(E->partes[q]), menor + 1);
+        long long tomados = (restantes<hasta-desde) ? restantes : hasta-desde;
+        cortes[q] = desde + (int) tomados;
+        restantes = restantes - tomados;
+    }
+}
+
+/**
+ * @brief Operación Agrega al búfer del hilo la linea "cantidad   palabra" del elemento dado.
+*/
+static void aux_formatear_elemento(struct exportacion *E, int hilo, unsigned long *capacidad, elemento_t *elem){
+    char digitos[24];
+    int cant_digitos = 0;
+    unsigned long long valor = (elem->a<0) ? (unsigned long long) -elem->a : (unsigned long long) elem->a;
+    unsigned long longitud_palabra = strlen(elem->b);
+    unsigned long longitud_linea = 1 + 20 + 3 + longitud_palabra + 1;
+
+    if (E->longitudes[hilo] + longitud_linea > *capacidad){
+        while (E->longitudes[hilo] + longitud_linea > *capacidad){
+            *capacidad = 2 * (*capacidad);
+        }
+        E->buferes[hilo] = (char*) realloc(E->buferes[hilo], *capacidad);
+        if (E->buferes[hilo]==NULL){
+            printf("Error %d: No se pudo reservar memoria para la exportacion.\n", ERROR_EXPORTACION_MEMORIA);
+            exit(ERROR_EXPORTACION_MEMORIA);
+        }
+    }
+
+    char *destino = E->buferes[hilo] + E->longitudes[hilo];
+    do{
+        digitos[cant_digitos] = (char) ('0' + valor % 10);
+        cant_digitos = cant_digitos + 1;
+        valor = valor / 10;
+    } while (valor>0);
+    if (elem->a<0){
+        *destino = '-';
+        destino = destino + 1;
+    }
+    while (cant_digitos>0){
+        cant_digitos = cant_digitos - 1;
+        *destino = digitos[cant_digitos];
+        destino = destino + 1;
+    }
+    memcpy(destino, "   ", 3);
+    memcpy(destino + 3, elem->b, longitud_palabra);
+    destino[3 + longitud_palabra] = '\n';
+    E->longitudes[hilo] = (destino + 3 + longitud_palabra + 1) - E->buferes[hilo];
+}
+
+/**
+ * @brief Operación Fase 2: el hilo combina los elementos de su tramo de cada parte y los formatea en su búfer.
+ * Se toma siempre el elemento de menor cantidad y, a igual cantidad, el de la parte de menor número.
+*/
+static void aux_fase_formatear(struct exportacion *E, int hilo){
+    int posiciones[EXPORTACION_PARTES];
+    unsigned long capacidad = EXPORTACION_BUFER_INICIAL;
+    int quedan = TRUE;
+
+    E->buferes[hilo] = (char*) aux_reservar(capacidad);
+    E->longitudes[hilo] = 0;
+    for (int q=0; q<EXPORTACION_PARTES; q++){
+        posiciones[q] = E->cortes[hilo][q];
+    }
+
+    while (quedan==TRUE){
+        int elegida = -1;
+        for (int q=0; q<EXPORTACION_PARTES; q++){
+            if (posiciones[q]<E->cortes[hilo+1][q]){
+                if (elegida==-1 || E->partes[q].elementos[posiciones[q]].a < E->partes[elegida].elementos[posiciones[elegida]].a){
+                    elegida = q;
+                }
+            }
+        }
+        if (elegida==-1){
+            quedan = FALSE;
+        }
+        else{
+            elemento_t *elem = &(E->partes[elegida].elementos[posiciones[elegida]]);
+            aux_formatear_elemento(E, hilo, &capacidad, elem);
+            free(elem->b);
+            posiciones[elegida] = posiciones[elegida] + 1;
+        }
+    }
+}
+
+#ifndef _WIN32
+/**
+ * @brief Operación Fase 3: el hilo escribe su búfer en la posición del archivo que le corresponde.
+ * @throw ERROR_EXPORTACION_ESCRITURA si no se pudo escribir en el archivo.
+*/
+static void aux_fase_escribir(struct exportacion *E, int hilo){
+    unsigned long escritos = 0;
+
+    while (escritos<E->longitudes[hilo]){
+        ssize_t n = pwrite(E->descriptor, E->buferes[hilo] + escritos, E->longitudes[hilo] - escritos, E->inicio + (off_t) (E->desplazamientos[hilo] + escritos));
+        if (n<=0){
+            printf("Error %d: No se pudo escribir la exportacion en el archivo.\n", ERROR_EXPORTACION_ESCRITURA);
+            exit(ERROR_EXPORTACION_ESCRITURA);
+        }
+        escritos = escritos + (unsigned long) n;
+    }
+}
+#endif
+
+void exportacion_escribir_por_frecuencia(multiset_t *m, FILE *salida, int cant_hilos){
+    struct exportacion E;
+    long long total = 0;
+    unsigned long bytes = 0;
+
+    E.m = m;
+    E.cant_hilos = (cant_hilos<1) ? 1 : cant_hilos;
+    E.siguiente_parte = 0;
+#ifndef _WIN32
+    pthread_mutex_init(&(E.mutex), NULL);
+#endif
+    E.cortes = (int**) aux_reservar((E.cant_hilos+1)*sizeof(int*));
+    E.buferes = (char**) aux_reservar(E.cant_hilos*sizeof(char*));
+    E.longitudes = (unsigned long*) aux_reservar(E.cant_hilos*sizeof(unsigned long));
+    E.desplazamientos = (unsigned long*) aux_reservar(E.cant_hilos*sizeof(unsigned long));
+
+    aux_ejecutar_fase(&E, aux_fase_recopilar, "recopilar y ordenar");
+
+    //Cada hilo recibe un tramo de la salida con la misma cantidad de elementos.
+    for (int q=0; q<EXPORTACION_PARTES; q++){
+        total = total + E.partes[q].cantidad;
+    }
+    for (int t=0; t<=E.cant_hilos; t++){
+        E.cortes[t] = (int*) aux_reservar(EXPORTACION_PARTES*sizeof(int));
+        aux_calcular_corte(&E, (total * t) / E.cant_hilos, E.cortes[t]);
+    }
+    aux_ejecutar_fase(&E, aux_fase_formatear, "formatear");
+
+    //Conocida la longitud de cada tramo, cada uno se escribe a continuación del anterior.
+    for (int t=0; t<E.cant_hilos; t++){
+        E.desplazamientos[t] = bytes;
+        bytes = bytes + E.longitudes[t];
+    }
+    fflush(salida);
+#ifndef _WIN32
+    E.descriptor = fileno(salida);
+    if (E.descriptor>=0){
+        E.inicio = ftello(salida);
+        aux_ejecutar_fase(&E, aux_fase_escribir, "escribir");
+        fseeko(salida, E.inicio + (off_t) bytes, SEEK_SET);
+    }
+    else
+#endif
+    {
+        //Sin descriptor (por ejemplo, un archivo comprimido, ver compresion.h), los tramos se escriben en orden.
+        for (int t=0; t<E.cant_hilos; t++){
+            if (fwrite(E.buferes[t], 1, E.longitudes[t], salida)!=E.longitudes[t]){
+                printf("Error %d: No se pudo escribir la exportacion en el archivo.\n", ERROR_EXPORTACION_ESCRITURA);
+                exit(ERROR_EXPORTACION_ESCRITURA);
+            }
+        }
+    }
+
+    for (int q=0; q<EXPORTACION_PARTES; q++){
+        free(E.partes[q].elementos);
+    }
+    for (int t=0; t<=E.cant_hilos; t++){
+        free(E.cortes[t]);
+    }
+    for (int t=0; t<E.cant_hilos; t++){
+        free(E.buferes[t]);
+    }
+    free(E.cortes);
+    free(E.buferes);
+    free(E.longitudes);
+    free(E.desplazamientos);
+#ifndef _WIN32
+    pthread_mutex_destroy(&(E.mutex));
+#endif
+}
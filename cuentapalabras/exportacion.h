@@ -0,0 +1,35 @@
+/**
+* @file exportacion.h
+* @brief Archivo encabezado del TDA Exportacion.
+* Escribe el contenido de un multiset ordenado por cantidad de repeticiones (el formato de totales.out) repartiendo el
+* trabajo entre varios hilos: cada hilo recopila y ordena las palabras de algunas letras iniciales, luego cada uno
+* combina y formatea un tramo de la salida en su propio búfer, y finalmente escribe su tramo en la posición del archivo
+* que le corresponde. En sistemas sin hilos POSIX, la exportación se realiza en un único hilo.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef EXPORTACION_H_INCLUDED
+#define EXPORTACION_H_INCLUDED
+
+#include <stdio.h>
+#include "multiset.h"
+
+#define ERROR_EXPORTACION_MEMORIA -25
+#define ERROR_EXPORTACION_ESCRITURA -26
+
+/**
+ * @brief Escribe en 'salida' todas las palabras del multiset 'm' con el formato "cantidad   palabra" por linea, de menor a
+ * mayor cantidad de repeticiones y, a igual cantidad, en orden lexicográfico (el mismo orden que
+ * multiset_elementos_por_frecuencia).
+ * @param m Puntero al multiset. No debe modificarse durante la exportación.
+ * @param salida Puntero al manejador del archivo de salida, abierto para escritura. La salida se escribe a partir de su
+ * posición actual, que al finalizar queda al final de lo escrito. Si el manejador no tiene descriptor propio (por
+ * ejemplo, un archivo comprimido, ver compresion.h), los tramos se escriben en orden con fwrite.
+ * @param cant_hilos Cantidad de hilos a utilizar (al menos 1).
+ * @throw ERROR_EXPORTACION_MEMORIA si no se pudo reservar memoria para los búferes.
+ * @throw ERROR_EXPORTACION_ESCRITURA si no se pudo escribir en el archivo.
+*/
+extern void exportacion_escribir_por_frecuencia(multiset_t *m, FILE *salida, int cant_hilos);
+
+#endif // EXPORTACION_H_INCLUDED
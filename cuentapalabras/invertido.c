@@ -0,0 +1,354 @@
+/**
+* @file invertido.c
+* @brief Implementación del TDA Invertido.
+* La lista de cada palabra se indexa por su identificador en el diccionario. La aparición en el último archivo se
+* acumula sin codificar, ya que su cantidad puede seguir creciendo, y se codifica al comenzar la de un archivo posterior.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "invertido.h"
+
+//Capacidad inicial del arreglo de listas y de los bytes de cada lista.
+#define INVERTIDO_LISTAS_INICIAL 1024
+#define INVERTIDO_BYTES_INICIAL 8
+//Bytes que ocupa, a lo sumo, un entero de 64 bits codificado.
+#define INVERTIDO_BYTES_ENTERO 10
+
+/**
+ * @struct apariciones
+ * @brief Modela la lista de archivos donde aparece una palabra. Cada aparición se codifica como la diferencia entre su
+ * archivo y el de la aparición codificada anterior (o el archivo más 1, en la primera), seguida de la cantidad.
+*/
+struct apariciones {
+    unsigned char *bytes; //Apariciones codificadas.
+    unsigned int longitud; //Cantidad de bytes en uso.
+    unsigned int capacidad; //Cantidad de bytes reservados.
+    int ultimo_archivo; //Archivo de la aparición sin codificar (-1 si la palabra no apareció).
+    int archivo_codificado; //Archivo de la última aparición codificada (-1 si no hay).
+    long long pendiente; //Cantidad de la aparición sin codificar.
+};
+
+/**
+ * @struct invertido
+ * @brief Modela el índice: el diccionario con los totales y la lista de apariciones de cada una de sus palabras.
+*/
+struct invertido {
+    multiset_t *diccionario; //Trie del invocador, que asigna el identificador de cada palabra.
+    struct apariciones *listas; //Listas indexadas por el identificador de la palabra.
+    unsigned int capacidad; //Cantidad de listas reservadas.
+    unsigned long long cant_apariciones; //Cantidad de pares (palabra, archivo).
+    unsigned long bytes_listas; //Bytes reservados por las listas.
+};
+
+/**
+ * @struct cursor_apariciones
+ * @brief Modela el recorrido de una lista de apariciones: la posición del próximo byte, el archivo de la última
+ * aparición leída y si ya se leyó la aparición sin codificar.
+*/
+struct cursor_apariciones {
+    unsigned int posicion;
+    int archivo;
+    int pendiente_leida;
+};
+
+/**
+ * @brief Operación Reserva 'bytes' bytes de memoria, o amplía a 'bytes' la reserva dada.
+ * @throw ERROR_INVERTIDO_MEMORIA si no se pudo reservar la memoria.
+*/
+static void *aux_reservar(void *anterior, unsigned long bytes){
+    void *to_return = realloc(anterior, bytes);
+    if (to_return==NULL){
+        printf("Error %d: No se pudo reservar memoria para el indice invertido.\n", ERROR_INVERTIDO_MEMORIA);
+        exit(ERROR_INVERTIDO_MEMORIA);
+    }
+    return to_return;
+}
+
+/**
+ * @brief Operación Agrega a la lista el entero dado, en grupos de 7 bits desde los menos significativos. El bit más
+ * alto de cada byte indica si siguen más grupos.
+*/
+static void aux_codificar_entero(struct apariciones *A, unsigned long long valor){
+    while (valor>=0x80){
+        A->bytes[A->longitud] = (unsigned char) (valor | 0x80);
+        A->longitud = A->longitud + 1;
+        valor = valor >> 7;
+    }
+    A->bytes[A->longitud] = (unsigned char) valor;
+    A->longitud = A->longitud + 1;
+}
+
+/**
+ * @brief Operación Lee el entero que comienza en la posición dada de la lista y avanza la posición.
+*/
+static unsigned long long aux_decodificar_entero(struct apariciones *A, unsigned int *posicion){
+    unsigned long long to_return = 0;
+    int desplazamiento = 0;
+    unsigned char byte;
+
+    do{
+        byte = A->bytes[*posicion];
+        to_return = to_return | (((unsigned long long) (byte & 0x7F)) << desplazamiento);
+        desplazamiento = desplazamiento + 7;
+        *posicion = *posicion + 1;
+    } while ((byte & 0x80)!=0);
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Codifica la aparición pendiente de la lista.
+ * @throw ERROR_INVERTIDO_MEMORIA si no se pudo ampliar la lista.
+*/
+static void aux_codificar_pendiente(invertido_t *I, struct apariciones *A){
+    if (A->longitud + 2*INVERTIDO_BYTES_ENTERO > A->capacidad){
+        unsigned int capacidad = (A->capacidad==0) ? INVERTIDO_BYTES_INICIAL : 2*A->capacidad;
+        while (A->longitud + 2*INVERTIDO_BYTES_ENTERO > capacidad){
+            capacidad = 2*capacidad;
+        }
+        A->bytes = (unsigned char*) aux_reservar(A->bytes, capacidad);
+        I->bytes_listas = I->bytes_listas + (capacidad - A->capacidad);
+        A->capacidad = capacidad;
+    }
+    aux_codificar_entero(A, (unsigned long long) (A->ultimo_archivo - A->archivo_codificado));
+    aux_codificar_entero(A, (unsigned long long) A->pendiente);
+    A->archivo_codificado = A->ultimo_archivo;
+    A->pendiente = 0;
+}
+
+/**
+ * @brief Operación Lee la próxima aparición de la lista, en orden creciente de archivo.
+ * @return TRUE si había una aparición más, y FALSE en caso contrario.
+*/
+static int aux_siguiente_aparicion(struct apariciones *A, struct cursor_apariciones *c, long long *cantidad){
+    int to_return = TRUE;
+
+    if (c->posicion<A->longitud){
+        c->archivo = c->archivo + (int) aux_decodificar_entero(A, &(c->posicion));
+        *cantidad = (long long) aux_decodificar_entero(A, &(c->posicion));
+    }
+    else if (A->pendiente>0 && c->pendiente_leida==FALSE){
+        c->archivo = A->ultimo_archivo;
+        c->pendiente_leida = TRUE;
+        *cantidad = A->pendiente;
+    }
+    else{
+        to_return = FALSE;
+    }
+
+    return to_return;
+}
+
+invertido_t *invertido_crear(multiset_t *diccionario){
+    //Solo el trie asigna a cada palabra el identificador que indexa su lista.
+    if (multiset_modo(diccionario)!=MULTISET_MODO_TRIE){
+        printf("Error %d: El diccionario del indice invertido debe ser un trie.\n", ERROR_INVERTIDO_MODO);
+        exit(ERROR_INVERTIDO_MODO);
+    }
+
+    invertido_t *to_return = (invertido_t*) aux_reservar(NULL, sizeof(invertido_t));
+    to_return->diccionario = diccionario;
+    to_return->listas = NULL;
+    to_return->capacidad = 0;
+    to_return->cant_apariciones = 0;
+    to_return->bytes_listas = 0;
+
+    return to_return;
+}
+
+unsigned int invertido_insertar(invertido_t *I, char *palabra, int archivo){
+    unsigned int to_return = (unsigned int) multiset_insertar_id(I->diccionario, palabra);
+
+    if (to_return>=I->capacidad){
+        unsigned int capacidad = (I->capacidad==0) ? INVERTIDO_LISTAS_INICIAL : I->capacidad;
+        while (to_return>=capacidad){
+            capacidad = 2*capacidad;
+        }
+        I->listas = (struct apariciones*) aux_reservar(I->listas, capacidad*sizeof(struct apariciones));
+        for (unsigned int i=I->capacidad; i<capacidad; i++){
+            struct apariciones vacia = {NULL, 0, 0, -1, -1, 0};
+            I->listas[i] = vacia;
+        }
+        I->capacidad = capacidad;
+    }
+
+    struct apariciones *A = &(I->listas[to_return]);
+    if (A->ultimo_archivo!=archivo){
+        if (A->pendiente>0){
+            aux_codificar_pendiente(I, A);
+        }
+        A->ultimo_archivo = archivo;
+        I->cant_apariciones = I->cant_apariciones + 1;
+    }
+    A->pendiente = A->pendiente + 1;
+
+    return to_return;
+}
+
+int invertido_distribucion(invertido_t *I, char *palabra, funcion_distribucion_t visitar, void *contexto){
+    int to_return = 0;
+    long id = multiset_buscar_id(I->diccionario, palabra);
+
+    if (id>=0 && (unsigned long) id<I->capacidad){
+        struct cursor_apariciones c = {0, -1, FALSE};
+        long long cantidad;
+        while (aux_siguiente_aparicion(&(I->listas[id]), &c, &cantidad)==TRUE){
+            visitar(c.archivo, cantidad, contexto);
+            to_return = to_return + 1;
+        }
+    }
+
+    return to_return;
+}
+
+//----EXPORTACION POR ARCHIVO----
+
+/**
+ * @struct vocabulario
+ * @brief Modela las palabras del diccionario en orden lexicográfico: el rango de cada palabra es su posición en dicho
+ * orden, y sus caracteres se almacenan consecutivos en un único arreglo.
+*/
+struct vocabulario {
+    unsigned int *ids; //Identificador de la palabra de cada rango.
+    unsigned long *textos; //Posición de los caracteres de la palabra de cada rango.
+    char *caracteres; //Caracteres de todas las palabras, cada una terminada en '\0'.
+    unsigned long longitud; //Cantidad de caracteres en uso.
+    unsigned long capacidad; //Cantidad de caracteres reservados.
+    unsigned int cantidad; //Cantidad de palabras.
+};
+
+/**
+ * @struct aparicion_rango
+ * @brief Modela la cantidad de repeticiones, en un archivo, de la palabra de un rango.
+*/
+struct aparicion_rango {
+    long long cantidad;
+    unsigned int rango;
+};
+
+/**
+ * @brief Operación Función de visita que agrega cada palabra del diccionario al vocabulario recibido como contexto.
+*/
+static void aux_visitar_vocabulario(char *palabra, long long cantidad, unsigned int id, void *contexto){
+    struct vocabulario *V = (struct vocabulario*) contexto;
+    unsigned long longitud = strlen(palabra) + 1;
+    (void) cantidad;
+
+    if (V->longitud + longitud > V->capacidad){
+        while (V->longitud + longitud > V->capacidad){
+            V->capacidad = 2*V->capacidad;
+        }
+        V->caracteres = (char*) aux_reservar(V->caracteres, V->capacidad);
+    }
+    memcpy(V->caracteres + V->longitud, palabra, longitud);
+    V->ids[V->cantidad] = id;
+    V->textos[V->cantidad] = V->longitud;
+    V->longitud = V->longitud + longitud;
+    V->cantidad = V->cantidad + 1;
+}
+
+/**
+ * @brief Operación Compara dos apariciones por cantidad y, a igual cantidad, por rango (orden lexicográfico).
+*/
+static int aux_comparar_apariciones(const void *a, const void *b){
+    const struct aparicion_rango *x = (const struct aparicion_rango*) a;
+    const struct aparicion_rango *y = (const struct aparicion_rango*) b;
+    int to_return;
+
+    if (x->cantidad!=y->cantidad){
+        to_return = (x->cantidad<y->cantidad) ? -1 : 1;
+    }
+    else{
+        to_return = (x->rango<y->rango) ? -1 : ((x->rango>y->rango) ? 1 : 0);
+    }
+
+    return to_return;
+}
+
+void invertido_exportar_por_archivo(invertido_t *I, char **nombres, int cant_archivos, FILE *salida){
+    unsigned int cant_palabras = multiset_cantidad_palabras(I->diccionario);
+    struct vocabulario V;
+
+    //Se recopila el vocabulario en orden lexicográfico, de modo que el rango desempate a igual cantidad.
+    V.ids = (unsigned int*) aux_reservar(NULL, (cant_palabras+1)*sizeof(unsigned int));
+    V.textos = (unsigned long*) aux_reservar(NULL, (cant_palabras+1)*sizeof(unsigned long));
+    V.capacidad = 1024;
+    V.caracteres = (char*) aux_reservar(NULL, V.capacidad);
+    V.longitud = 0;
+    V.cantidad = 0;
+    multiset_recorrer_ids(I->diccionario, aux_visitar_vocabulario, &V);
+
+    /*
+    * Cada palabra espera en la cola del archivo de su próxima aparición. Al escribir un archivo, se toman las palabras
+    * de su cola, se ordenan, y cada una pasa a la cola del archivo de su aparición siguiente. Así cada lista se
+    * recorre una sola vez, y solo las palabras del archivo en curso se ordenan.
+    */
+    struct cursor_apariciones *cursores = (struct cursor_apariciones*) aux_reservar(NULL, (V.cantidad+1)*sizeof(struct cursor_apariciones));
+    long long *cantidades = (long long*) aux_reservar(NULL, (V.cantidad+1)*sizeof(long long));
+    int *siguiente = (int*) aux_reservar(NULL, (V.cantidad+1)*sizeof(int));
+    int *colas = (int*) aux_reservar(NULL, (cant_archivos+1)*sizeof(int));
+    struct aparicion_rango *archivo = (struct aparicion_rango*) aux_reservar(NULL, (V.cantidad+1)*sizeof(struct aparicion_rango));
+
+    for (int f=0; f<cant_archivos; f++){
+        colas[f] = -1;
+    }
+    for (unsigned int r=0; r<V.cantidad; r++){
+        struct cursor_apariciones c = {0, -1, FALSE};
+        cursores[r] = c;
+        if (aux_siguiente_aparicion(&(I->listas[V.ids[r]]), &(cursores[r]), &(cantidades[r]))==TRUE && cursores[r].archivo<cant_archivos){
+            siguiente[r] = colas[cursores[r].archivo];
+            colas[cursores[r].archivo] = (int) r;
+        }
+    }
+
+    for (int f=0; f<cant_archivos; f++){
+        unsigned int cantidad = 0;
+        int r = colas[f];
+
+        while (r!=-1){
+            int proximo = siguiente[r];
+            archivo[cantidad].cantidad = cantidades[r];
+            archivo[cantidad].rango = (unsigned int) r;
+            cantidad = cantidad + 1;
+            if (aux_siguiente_aparicion(&(I->listas[V.ids[r]]), &(cursores[r]), &(cantidades[r]))==TRUE && cursores[r].archivo<cant_archivos){
+                siguiente[r] = colas[cursores[r].archivo];
+                colas[cursores[r].archivo] = r;
+            }
+            r = proximo;
+        }
+        qsort(archivo, cantidad, sizeof(struct aparicion_rango), aux_comparar_apariciones);
+
+        fprintf(salida, "%s\n", nombres[f]);
+        for (unsigned int i=0; i<cantidad; i++){
+            fprintf(salida, "%lld   %s\n", archivo[i].cantidad, V.caracteres + V.textos[archivo[i].rango]);
+        }
+    }
+
+    free(V.ids);
+    free(V.textos);
+    free(V.caracteres);
+    free(cursores);
+    free(cantidades);
+    free(siguiente);
+    free(colas);
+    free(archivo);
+}
+
+void invertido_estadisticas(invertido_t *I, unsigned long long *cant_apariciones, unsigned long *bytes){
+    *cant_apariciones = I->cant_apariciones;
+    *bytes = sizeof(invertido_t) + I->capacidad*sizeof(struct apariciones) + I->bytes_listas;
+}
+
+void invertido_eliminar(invertido_t **I){
+    for (unsigned int i=0; i<(*I)->capacidad; i++){
+        free((*I)->listas[i].bytes);
+    }
+    free((*I)->listas);
+    free(*I);
+    *I = NULL;
+}
@@ -0,0 +1,88 @@
+/**
+* @file invertido.h
+* @brief Archivo encabezado del TDA Invertido.
+* Un índice invertido cuenta las palabras de varios archivos en un único diccionario: un multiset en MULTISET_MODO_TRIE,
+* cuyas cantidades son los totales, y, por cada palabra, la lista de los archivos donde aparece junto a su cantidad en
+* cada uno. Las listas se codifican como enteros de longitud variable (7 bits por byte), con el número de cada archivo
+* como diferencia respecto del anterior, por lo que una aparición suele ocupar dos bytes. Así la memoria crece con la
+* cantidad de pares (palabra, archivo) distintos y no con un trie por archivo.
+* Los archivos deben contarse en orden: cada inserción corresponde al mismo archivo que la anterior o a uno posterior.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef INVERTIDO_H_INCLUDED
+#define INVERTIDO_H_INCLUDED
+
+#include <stdio.h>
+#include "multiset.h"
+
+#define ERROR_INVERTIDO_MEMORIA -32
+#define ERROR_INVERTIDO_MODO -33
+
+struct invertido;
+typedef struct invertido invertido_t;
+
+/**
+ * @typedef void(funcion_distribucion_t)
+ * @brief Plantilla de función que recibe cada archivo donde aparece una palabra junto a su cantidad en él.
+*/
+typedef void (funcion_distribucion_t)(int archivo, long long cantidad, void *contexto);
+
+/**
+ * @brief Crea un índice vacío sobre el diccionario dado y lo devuelve. El diccionario sigue perteneciendo al invocador,
+ * que no debe vaciarlo ni insertar en él por fuera del índice mientras lo utilice.
+ * @param diccionario Puntero a un multiset vacío en MULTISET_MODO_TRIE, donde se acumulan los totales.
+ * @throw ERROR_INVERTIDO_MODO si el diccionario no asigna identificadores a sus palabras.
+ * @throw ERROR_INVERTIDO_MEMORIA si no se logra reservar memoria.
+ * @return Puntero al índice construido.
+*/
+extern invertido_t *invertido_crear(multiset_t *diccionario);
+
+/**
+ * @brief Suma una repetición de la palabra en el archivo dado y en los totales.
+ * @param I Puntero al índice.
+ * @param palabra Puntero a la palabra.
+ * @param archivo Número del archivo, mayor o igual al de la inserción anterior.
+ * @throw ERROR_INVERTIDO_MEMORIA si no se logra reservar memoria.
+ * @return Identificador de la palabra en el diccionario (ver multiset_insertar_id).
+*/
+extern unsigned int invertido_insertar(invertido_t *I, char *palabra, int archivo);
+
+/**
+ * @brief Invoca a 'visitar' con cada archivo donde aparece la palabra, en orden creciente, y su cantidad en él.
+ * @param I Puntero al índice.
+ * @param palabra Puntero a la palabra.
+ * @param visitar Función que recibe cada archivo, la cantidad y el contexto dado.
+ * @param contexto Puntero a datos del invocador.
+ * @return Cantidad de archivos donde aparece la palabra (0 si no aparece).
+*/
+extern int invertido_distribucion(invertido_t *I, char *palabra, funcion_distribucion_t visitar, void *contexto);
+
+/**
+ * @brief Escribe, para cada archivo, su nombre seguido de sus palabras ordenadas por cantidad (y, a igual cantidad,
+ * lexicográficamente), con el formato de cadauno.out.
+ * @param I Puntero al índice.
+ * @param nombres Nombres de los archivos, indexados por su número.
+ * @param cant_archivos Cantidad de archivos a escribir (los números 0 a cant_archivos-1).
+ * @param salida Archivo abierto para escritura.
+ * @throw ERROR_INVERTIDO_MEMORIA si no se logra reservar memoria.
+*/
+extern void invertido_exportar_por_archivo(invertido_t *I, char **nombres, int cant_archivos, FILE *salida);
+
+/**
+ * @brief Devuelve la cantidad de pares (palabra, archivo) registrados y los bytes que ocupan las listas y sus cabeceras.
+ * La memoria del diccionario se consulta con multiset_memoria.
+ * @param I Puntero al índice.
+ * @param cant_apariciones Puntero donde se almacena la cantidad de pares (palabra, archivo).
+ * @param bytes Puntero donde se almacena la cantidad de bytes reservados por el índice.
+*/
+extern void invertido_estadisticas(invertido_t *I, unsigned long long *cant_apariciones, unsigned long *bytes);
+
+/**
+ * @brief Elimina el índice liberando su memoria, sin eliminar el diccionario. Luego de la invocacion 'I' es NULL.
+ * @param I Puntero al puntero del índice.
+*/
+extern void invertido_eliminar(invertido_t **I);
+
+#endif // INVERTIDO_H_INCLUDED
@@ -0,0 +1,342 @@
+/**
+* @file lector.c
+* @brief Implementación del TDA Lector.
+* Las palabras se delimitan por espacios, saltos de linea y los signos de puntuación '.', ':', ';' y ','.
+* Sus caracteres se pliegan con la tabla establecida en alfabeto.h; si la tabla no reemplaza ningún caracter, solo se
+* comprueba que pertenezcan al alfabeto, sin copiarlos.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "lector.h"
+#include "alfabeto.h"
+
+int lector_es_archivo_txt(char *name){
+    //Inicialización de variables.
+    int to_return = FALSE;
+    int longitud_name = strlen(name);
+
+    //Si el nombre del archivo tiene mas de 3 caractes (incluyendo extension)
+    if (longitud_name>3){
+        //Compruebo si dicho nombre finaliza con ".txt"
+        if (name[longitud_name-3]=='t' && name[longitud_name-2]=='x' && name[longitud_name-1]=='t'){
+            to_return=TRUE;
+        }
+    }
+
+    return to_return;
+}
+
+/**
+* @brief Recorre recursivamente la próxima cadena a recuperar por del archivo y la devuelve.
+* @param f Puntero a archivo.
+* @param longitud_cadena Longitud de la cadena a leer.
+* @throw ERROR_LECTOR_MEMORIA Si no se logró reservar memoria para la cadena.
+* @return Puntero a cadena creada o NULL si la cadena en cuestión en un caracter separador de palabras.
+*/
+static char * aux_recuperar_cadena(FILE *f, int longitud_cadena){
+    //Recupero el caracter a leer.
+    char ch_actual = fgetc(f);
+
+    //Si ch_actual es algun caracter que indique fin de cadena a considerar.
+    if ((feof(f)) || (ch_actual==' ') || (ch_actual=='\n') || (ch_actual=='.') || (ch_actual==':') || (ch_actual==';') || (ch_actual==',') || (ch_actual=='\0')){
+        //CB: Si la longitud es 0, entonces no hay cadena que crear.
+        if (longitud_cadena==0){
+            return NULL;
+        }
+        else{
+            //CB: Si la longitud es mayor a 1, entonces hay una palabra de por lo menos un char.
+            char * cadena = (char*) malloc((longitud_cadena+1)*sizeof(char));
+            if (cadena==NULL){
+                printf("Error %d: No se pudo reservar memoria para la cadena.\n", ERROR_LECTOR_MEMORIA);
+                exit(ERROR_LECTOR_MEMORIA);
+            }
+            cadena[longitud_cadena] = '\0';
+
+            return cadena;
+        }
+    }
+    else{
+        //CR: Bloque de caracteres dentro de la cadena.
+        char * cadena = aux_recuperar_cadena(f, longitud_cadena+1);
+        cadena[longitud_cadena] = ch_actual;
+
+        return cadena;
+    }
+}
+
+int lector_leer_archivo(char *path, funcion_palabra_t procesar, void *contexto){
+    //Abro el archivo en modo de lectura.
+    FILE* f = fopen(path, "r");
+    int to_return = FALSE;
+
+    if (f!=NULL){
+        //Mientras que exista algo que leer en el archivo.
+        while (!feof(f)) {
+            //Recupero un puntero a la cadena de caracteres a analizar.
+            char * cadena = aux_recuperar_cadena(f, 0);
+
+            //Si el puntero no es NULO y ademas la palabra plegada no tiene caracteres especiales, entonces se procesa.
+            if ((cadena!=NULL) && (alfabeto_plegar(cadena)==TRUE)){
+                procesar(cadena, contexto);
+            }
+
+            //Finalmente libero la memoria reservada para la cadena.
+            free(cadena);
+        }
+
+        //Cierro el archivo
+        fclose(f);
+        to_return = TRUE;
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Comprueba si el caracter delimita palabras, con el mismo criterio que aux_recuperar_cadena.
+*/
+static int aux_es_separador(char ch){
+    return (ch==' ') || (ch=='\n') || (ch=='.') || (ch==':') || (ch==';') || (ch==',') || (ch=='\0');
+}
+
+void lector_procesar_contenido(char *contenido, unsigned long n, funcion_palabra_t procesar, void *contexto){
+    const alfabeto_plegado_t *P = alfabeto_plegado();
+    unsigned long inicio = 0;
+    int valida = TRUE;
+
+    //Se agrega un separador al final, de modo que la última palabra se cierre en el mismo recorrido.
+    contenido[n] = '\0';
+    if (P->identidad==TRUE){
+        //Sin reemplazos, las palabras se terminan en el lugar sin mover sus caracteres.
+        for (unsigned long i=0; i<=n; i++){
+            char ch = contenido[i];
+
+            if (aux_es_separador(ch)){
+                if (i>inicio && valida==TRUE){
+                    contenido[i] = '\0';
+                    procesar(contenido+inicio, contexto);
+                }
+                inicio = i+1;
+                valida = TRUE;
+            }
+            else if (ALFABETO_POSICION(ch)<0){
+                valida = FALSE;
+            }
+        }
+    }
+    else{
+        //Cada palabra se pliega sobre sí misma: 'escritura' nunca supera a la posición leída.
+        unsigned long escritura = 0;
+        for (unsigned long i=0; i<=n; i++){
+            char ch = contenido[i];
+
+            if (aux_es_separador(ch)){
+                if (escritura>inicio && valida==TRUE){
+                    contenido[escritura] = '\0';
+                    procesar(contenido+inicio, contexto);
+                }
+                inicio = i+1;
+                escritura = i+1;
+                valida = TRUE;
+            }
+            else{
+                unsigned char reemplazo = P->simples[(unsigned char) ch];
+                if (reemplazo==ALFABETO_LATINO){
+                    //El contenido termina en '\0', por lo que siempre hay un byte siguiente.
+                    unsigned char siguiente = (unsigned char) contenido[i+1];
+                    if ((siguiente & 0xC0)!=0x80 || P->latinos[siguiente - 0x80][0]=='\0'){
+                        valida = FALSE;
+                    }
+                    else{
+                        for (const char *c=P->latinos[siguiente - 0x80]; *c!='\0'; c++){
+                            contenido[escritura] = *c;
+                            escritura++;
+                        }
+                        i++;
+                    }
+                }
+                else if (reemplazo==0){
+                    valida = FALSE;
+                }
+                else{
+                    contenido[escritura] = (char) reemplazo;
+                    escritura++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @struct separacion_plegada
+ * @brief Modela la función y el contexto que reciben las palabras plegadas de lector_separar_bufer.
+*/
+struct separacion_plegada {
+    funcion_palabra_longitud_t *procesar;
+    void *contexto;
+};
+
+/**
+ * @brief Función que recibe cada palabra plegada por el lector de flujo y la entrega con su longitud.
+*/
+static void aux_entregar_plegada(char *palabra, void *contexto){
+    struct separacion_plegada *S = (struct separacion_plegada*) contexto;
+    S->procesar(palabra, strlen(palabra), S->contexto);
+}
+
+void lector_separar_bufer(const char *bufer, unsigned long n, funcion_palabra_longitud_t procesar, void *contexto){
+    const alfabeto_plegado_t *P = alfabeto_plegado();
+
+    if (P->identidad==TRUE){
+        unsigned long inicio = 0;
+        int valida = TRUE;
+
+        //Sin reemplazos, cada palabra válida es el tramo del búfer entre dos separadores (o sus extremos).
+        for (unsigned long i=0; i<=n; i++){
+            if (i==n || aux_es_separador(bufer[i])){
+                if (i>inicio && valida==TRUE){
+                    procesar(bufer+inicio, i-inicio, contexto);
+                }
+                inicio = i+1;
+                valida = TRUE;
+            }
+            else if (ALFABETO_POSICION(bufer[i])<0){
+                valida = FALSE;
+            }
+        }
+    }
+    else{
+        //Plegar una palabra puede alargarla, por lo que se arma en el arreglo del lector de flujo.
+        lector_flujo_t l;
+        struct separacion_plegada S = {procesar, contexto};
+        lector_flujo_iniciar(&l);
+        lector_flujo_procesar(&l, (char*) bufer, n, aux_entregar_plegada, &S);
+        lector_flujo_finalizar(&l, aux_entregar_plegada, &S);
+    }
+}
+
+/**
+ * @brief Procesa la palabra en curso si es válida y reinicia el lector para la palabra siguiente.
+*/
+static void aux_cerrar_palabra(lector_flujo_t *l, funcion_palabra_t procesar, void *contexto){
+    if (l->longitud>0 && l->valida==TRUE){
+        l->palabra[l->longitud] = '\0';
+        procesar(l->palabra, contexto);
+    }
+    l->longitud = 0;
+    l->valida = TRUE;
+    l->latino = FALSE;
+}
+
+void lector_flujo_iniciar(lector_flujo_t *l){
+    l->palabra = l->inicial;
+    l->capacidad = LECTOR_LONGITUD_INICIAL;
+    l->longitud = 0;
+    l->valida = TRUE;
+    l->latino = FALSE;
+}
+
+/**
+ * @brief Duplica la capacidad de la palabra en curso, pasándola a un arreglo reservado si estaba en el arreglo propio.
+ * @throw ERROR_LECTOR_MEMORIA si no se pudo reservar memoria para la palabra.
+*/
+static void aux_ampliar_palabra(lector_flujo_t *l){
+    unsigned long capacidad = 2*l->capacidad;
+    char *palabra = (l->palabra==l->inicial) ? (char*) malloc(capacidad+1) : (char*) realloc(l->palabra, capacidad+1);
+
+    if (palabra==NULL){
+        printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_LECTOR_MEMORIA);
+        exit(ERROR_LECTOR_MEMORIA);
+    }
+    if (l->palabra==l->inicial){
+        memcpy(palabra, l->inicial, l->longitud);
+    }
+    l->palabra = palabra;
+    l->capacidad = capacidad;
+}
+
+/**
+ * @brief Agrega el caracter a la palabra en curso, ampliándola si no entra.
+*/
+static void aux_agregar_caracter(lector_flujo_t *l, char ch){
+    if (l->longitud==l->capacidad){
+        aux_ampliar_palabra(l);
+    }
+    l->palabra[l->longitud] = ch;
+    l->longitud = l->longitud + 1;
+}
+
+/**
+ * @brief Agrega a la palabra en curso los caracteres de 'reemplazo'.
+*/
+static void aux_agregar_reemplazo(lector_flujo_t *l, const char *reemplazo){
+    while (*reemplazo!='\0'){
+        aux_agregar_caracter(l, *reemplazo);
+        reemplazo++;
+    }
+}
+
+void lector_flujo_procesar(lector_flujo_t *l, char *bloque, unsigned long n, funcion_palabra_t procesar, void *contexto){
+    const alfabeto_plegado_t *P = alfabeto_plegado();
+
+    for (unsigned long i=0; i<n; i++){
+        char ch = bloque[i];
+
+        if (aux_es_separador(ch)){
+            //Una letra de Latin-1 incompleta invalida la palabra.
+            if (l->latino==TRUE){
+                l->valida = FALSE;
+            }
+            aux_cerrar_palabra(l, procesar, contexto);
+        }
+        else if (P->identidad==TRUE){
+            //Una palabra inválida solo se recorre hasta el próximo separador, sin almacenar sus caracteres.
+            if (ALFABETO_POSICION(ch)<0){
+                l->valida = FALSE;
+            }
+            if (l->valida==TRUE){
+                aux_agregar_caracter(l, ch);
+            }
+        }
+        else if (l->latino==TRUE){
+            //El primer byte de la letra pudo haber quedado al final del bloque anterior.
+            unsigned char siguiente = (unsigned char) ch;
+            l->latino = FALSE;
+            if ((siguiente & 0xC0)!=0x80 || P->latinos[siguiente - 0x80][0]=='\0'){
+                l->valida = FALSE;
+            }
+            else if (l->valida==TRUE){
+                aux_agregar_reemplazo(l, P->latinos[siguiente - 0x80]);
+            }
+        }
+        else{
+            unsigned char reemplazo = P->simples[(unsigned char) ch];
+            if (reemplazo==ALFABETO_LATINO){
+                l->latino = TRUE;
+            }
+            else if (reemplazo==0){
+                l->valida = FALSE;
+            }
+            else if (l->valida==TRUE){
+                aux_agregar_caracter(l, (char) reemplazo);
+            }
+        }
+    }
+}
+
+void lector_flujo_finalizar(lector_flujo_t *l, funcion_palabra_t procesar, void *contexto){
+    if (l->latino==TRUE){
+        l->valida = FALSE;
+    }
+    aux_cerrar_palabra(l, procesar, contexto);
+    if (l->palabra!=l->inicial){
+        free(l->palabra);
+        l->palabra = l->inicial;
+        l->capacidad = LECTOR_LONGITUD_INICIAL;
+    }
+}
@@ -0,0 +1,117 @@
+/**
+* @file lector.h
+* @brief Archivo encabezado del TDA Lector.
+* Modela la lectura de archivos de texto, separándolos en palabras compuestas solo por caracteres del alfabeto, luego
+* de plegarlas con la tabla de plegado establecida (ver alfabeto.h).
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef LECTOR_H_INCLUDED
+#define LECTOR_H_INCLUDED
+
+#include "define.h"
+
+#define ERROR_LECTOR_MEMORIA -16
+
+//Longitud de las palabras de un flujo que entran en el arreglo propio del lector. Las más largas se arman en un arreglo
+//reservado que crece con ellas, por lo que se cuentan igual que al leer el contenido completo.
+#define LECTOR_LONGITUD_INICIAL 1024
+
+/**
+ * @typedef void(funcion_palabra_t)
+ * @brief Plantilla de función que recibe cada palabra válida leida.
+ * La cadena 'palabra' solo es válida durante la invocación, por lo que debe copiarse si se desea conservarla.
+*/
+typedef void (funcion_palabra_t)(char *palabra, void *contexto);
+
+/**
+ * @typedef void(funcion_palabra_longitud_t)
+ * @brief Plantilla de función que recibe cada palabra válida leida como un tramo de 'longitud' caracteres, que no
+ * termina en '\0'. Al igual que en funcion_palabra_t, el tramo solo es válido durante la invocación.
+*/
+typedef void (funcion_palabra_longitud_t)(const char *palabra, unsigned long longitud, void *contexto);
+
+/**
+ * @brief Comprueba si un puntero a una cadena de caracteres es un el nombre de un archivo con extensión .txt.
+ * @param name Puntero a cadena de caracteres.
+ * @return TRUE si es un archivo .txt y FALSE en caso contrario.
+*/
+extern int lector_es_archivo_txt(char *name);
+
+/**
+ * @brief Lee el archivo de texto de la ruta dada e invoca a 'procesar' con cada palabra sin caracteres especiales.
+ * @param path Puntero a cadena de caracteres que conforma la ruta hacia el archivo a leer.
+ * @param procesar Función que recibe cada palabra.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+ * @throw ERROR_LECTOR_MEMORIA si no se logró reservar memoria para una palabra.
+ * @return TRUE si se leyó el archivo, FALSE si no se pudo abrir.
+*/
+extern int lector_leer_archivo(char *path, funcion_palabra_t procesar, void *contexto);
+
+/**
+ * @brief Separa en palabras el contenido completo de un archivo, con el mismo criterio que lector_leer_archivo, e invoca
+ * a 'procesar' con cada palabra válida. Las palabras se terminan dentro del mismo contenido, sin copiarlas, por lo que
+ * el contenido se modifica y debe tener capacidad para n+1 caracteres.
+ * @param contenido Puntero a los caracteres del archivo.
+ * @param n Cantidad de caracteres del contenido.
+ * @param procesar Función que recibe cada palabra.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+*/
+extern void lector_procesar_contenido(char *contenido, unsigned long n, funcion_palabra_t procesar, void *contexto);
+
+/**
+ * @brief Separa en palabras el búfer dado, con el mismo criterio que lector_procesar_contenido, e invoca a 'procesar'
+ * con cada palabra válida, sin modificar el búfer. Si la tabla de plegado no reemplaza caracteres, cada palabra es un
+ * tramo del propio búfer; si no, se pliega con el lector de flujo.
+ * @param bufer Puntero a los caracteres del texto, que no necesita terminar en '\0'.
+ * @param n Cantidad de caracteres del búfer.
+ * @param procesar Función que recibe cada palabra y su longitud.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+*/
+extern void lector_separar_bufer(const char *bufer, unsigned long n, funcion_palabra_longitud_t procesar, void *contexto);
+
+/**
+ * @struct lector_flujo
+ * @brief Modela el estado de la lectura de un flujo por bloques: la palabra que quedó incompleta al final del último bloque.
+ * A diferencia de lector_leer_archivo, no reserva memoria por palabra: solo reserva un arreglo, que conserva hasta
+ * finalizar, si alguna palabra supera LECTOR_LONGITUD_INICIAL caracteres.
+*/
+struct lector_flujo {
+    char inicial[LECTOR_LONGITUD_INICIAL+1]; ///Arreglo propio para las palabras de hasta LECTOR_LONGITUD_INICIAL caracteres.
+    char *palabra; ///Caracteres de la palabra en curso: 'inicial' o el arreglo reservado para una palabra más larga.
+    unsigned long capacidad; ///Cantidad de caracteres que entran en 'palabra', sin contar el '\0'.
+    unsigned long longitud; ///Cantidad de caracteres de la palabra en curso.
+    int valida; ///FALSE si la palabra en curso contiene un caracter especial.
+    int latino; ///TRUE si el último byte leido es el primero de una letra de Latin-1 en UTF-8 (ver alfabeto.h).
+};
+typedef struct lector_flujo lector_flujo_t;
+
+/**
+ * @brief Inicializa la lectura de un flujo.
+ * @param l Puntero al lector a inicializar.
+*/
+extern void lector_flujo_iniciar(lector_flujo_t *l);
+
+/**
+ * @brief Separa en palabras el bloque dado e invoca a 'procesar' con cada palabra válida completa.
+ * La palabra que queda abierta al final del bloque se completa con el bloque siguiente.
+ * @throw ERROR_LECTOR_MEMORIA si no se pudo reservar memoria para una palabra larga.
+ * @param l Puntero al lector.
+ * @param bloque Puntero a los caracteres leidos.
+ * @param n Cantidad de caracteres del bloque.
+ * @param procesar Función que recibe cada palabra.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+*/
+extern void lector_flujo_procesar(lector_flujo_t *l, char *bloque, unsigned long n, funcion_palabra_t procesar, void *contexto);
+
+/**
+ * @brief Finaliza la lectura del flujo, procesando la palabra que haya quedado abierta, y libera la memoria reservada
+ * por el lector.
+ * @param l Puntero al lector.
+ * @param procesar Función que recibe la palabra.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'procesar'.
+*/
+extern void lector_flujo_finalizar(lector_flujo_t *l, funcion_palabra_t procesar, void *contexto);
+
+#endif // LECTOR_H_INCLUDED
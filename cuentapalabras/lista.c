@@ -31,6 +31,7 @@ lista_t *lista_crear(){
     }
     //Actualiza los atributos de la lista para modelar una lista vacía.
     L->primera = NULL;
+    L->ultima = NULL;
     L->cantidad = 0;
 
     return L;
@@ -83,6 +84,7 @@ int lista_insertar(lista_t *l, elemento_t elem, unsigned int pos){
         ///Caso 1: Lista vacía
         if (long_list==0){
             l->primera = celda_nueva;
+            l->ultima = celda_nueva;
         }
         else{
             ///Caso 2: Lista con elementos y posicion=0 (al inicio de la lista)
@@ -94,13 +96,10 @@ int lista_insertar(lista_t *l, elemento_t elem, unsigned int pos){
             else{
                 celda_actual = l->primera;
 
-                ///Caso 3: Insertar al final de la lista
+                ///Caso 3: Insertar al final de la lista (sin recorrerla, a partir de la última celda).
                 if (pos==long_list){
-                    //Recorro hasta el final de la lista.
-                    while(celda_actual->siguiente!=NULL){
-                        celda_actual = celda_actual->siguiente;
-                    }
-                    celda_actual->siguiente = celda_nueva;
+                    l->ultima->siguiente = celda_nueva;
+                    l->ultima = celda_nueva;
                 }
                 else{
                     ///Caso 4: Otra posicion tal que 0<=pos<long_lista
@@ -139,6 +138,9 @@ elemento_t *lista_eliminar(lista_t *l, unsigned int pos){
             celda_siguiente = celda_actual->siguiente;
             celda_eliminar = celda_actual;
             l->primera = celda_siguiente;
+            if (celda_siguiente==NULL){
+                l->ultima = NULL;
+            }
         }
         else{
             for (int i=1; i<pos; i++){
@@ -150,6 +152,9 @@ elemento_t *lista_eliminar(lista_t *l, unsigned int pos){
             celda_siguiente = celda_eliminar->siguiente;
             //Finalmente, se procede a hacer los cambios de asignaciones.
             celda_actual->siguiente = celda_siguiente;
+            if (celda_siguiente==NULL){
+                l->ultima = celda_actual;
+            }
         }
         celda_eliminar->siguiente = NULL;
         //Recupero el valor a remover de la lista y quito la referencia de la celda.
@@ -164,6 +169,23 @@ elemento_t *lista_eliminar(lista_t *l, unsigned int pos){
     return to_return;
 }
 
+void lista_concatenar(lista_t *l1, lista_t *l2){
+    if (l2->cantidad>0){
+        if (l1->cantidad==0){
+            l1->primera = l2->primera;
+        }
+        else{
+            l1->ultima->siguiente = l2->primera;
+        }
+        l1->ultima = l2->ultima;
+        l1->cantidad = l1->cantidad + l2->cantidad;
+
+        l2->primera = NULL;
+        l2->ultima = NULL;
+        l2->cantidad = 0;
+    }
+}
+
 elemento_t *lista_elemento(lista_t *l, unsigned int pos){
     elemento_t * to_return = NULL;
     int long_list = l->cantidad;
@@ -187,6 +209,57 @@ elemento_t *lista_elemento(lista_t *l, unsigned int pos){
     return to_return;
 }
 
+cursor_lista_t lista_cursor(lista_t *l){
+    cursor_lista_t to_return;
+
+    to_return.lista = l;
+    to_return.anterior = NULL;
+    to_return.actual = l->primera;
+
+    return to_return;
+}
+
+int lista_cursor_valido(cursor_lista_t *c){
+    return (c->actual!=NULL) ? TRUE : FALSE;
+}
+
+void lista_cursor_siguiente(cursor_lista_t *c){
+    if (c->actual!=NULL){
+        c->anterior = c->actual;
+        c->actual = c->actual->siguiente;
+    }
+}
+
+elemento_t *lista_cursor_elemento(cursor_lista_t *c){
+    return (c->actual!=NULL) ? c->actual->elem : NULL;
+}
+
+elemento_t *lista_cursor_eliminar(cursor_lista_t *c){
+    elemento_t *to_return = NULL;
+    celda_t *celda_eliminar = c->actual;
+
+    if (celda_eliminar!=NULL){
+        //Se desengancha la celda actual, enlazando la anterior (o el inicio de la lista) con la siguiente.
+        if (c->anterior==NULL){
+            c->lista->primera = celda_eliminar->siguiente;
+        }
+        else{
+            c->anterior->siguiente = celda_eliminar->siguiente;
+        }
+        if (c->lista->ultima==celda_eliminar){
+            c->lista->ultima = c->anterior;
+        }
+        c->actual = celda_eliminar->siguiente;
+        c->lista->cantidad = c->lista->cantidad - 1;
+
+        //Recupero el valor a remover de la lista y libero la celda.
+        to_return = celda_eliminar->elem;
+        free(celda_eliminar);
+    }
+
+    return to_return;
+}
+
 /**
 * @brief Realiza el procedimiento de ordenar la lista recursivamente.
 * @param celda_actual Puntero a la celda actual.
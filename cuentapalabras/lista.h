@@ -33,7 +33,7 @@ typedef enum{
  * y el valor b será un puntero a la palabra en cuestión.
 */
 struct elemento {
-    int a;
+    long long a;
     char *b;
 };
 typedef struct elemento elemento_t;
@@ -55,10 +55,23 @@ typedef struct celda celda_t;
 */
 struct lista {
     celda_t *primera; ///Puntero a la primera celda de la lista.
+    celda_t *ultima; ///Puntero a la última celda de la lista, que permite insertar al final en tiempo constante.
     int cantidad; ///Cantidad de elementos de la lista.
 };
 typedef struct lista lista_t;
 
+/**
+ * @struct cursor_lista
+ * @brief Modela un cursor que recorre una lista celda a celda, de modo que recorrer toda la lista sea lineal
+ * (a diferencia de invocar a lista_elemento con cada posición).
+*/
+struct cursor_lista {
+    lista_t *lista; ///Lista recorrida.
+    celda_t *anterior; ///Celda previa a la actual, o NULL si la actual es la primera.
+    celda_t *actual; ///Celda actual, o NULL si el cursor llegó al final de la lista.
+};
+typedef struct cursor_lista cursor_lista_t;
+
 /**
 * @brief Crea una lista vacía y la devuelve.
 * @throw ERROR_LISTA_MEMORIA si no se logra reservar memoria para la lista.
@@ -77,6 +90,13 @@ extern lista_t *lista_crear();
 */
 extern int lista_insertar(lista_t *l, elemento_t elem, unsigned int pos);
 
+/**
+* @brief Mueve al final de la lista 'l1' todos los elementos de la lista 'l2', en tiempo constante. Luego de la invocación 'l2' queda vacía.
+* @param l1 Puntero a la lista que recibe los elementos.
+* @param l2 Puntero a la lista cuyos elementos se mueven.
+*/
+extern void lista_concatenar(lista_t *l1, lista_t *l2);
+
 /**
 * @brief Elimina el elemento de la posición 'pos' de la lista y lo retorna.
 * @param l Puntero a la lista de elementos.
@@ -95,6 +115,41 @@ de lo contrario, retorna NULL.
 */
 extern elemento_t *lista_elemento(lista_t *l, unsigned int pos);
 
+/**
+* @brief Devuelve un cursor ubicado en el primer elemento de la lista 'l'.
+* El cursor queda invalidado si la lista se modifica por otro medio que no sea lista_cursor_eliminar.
+* @param l Puntero a la lista de elementos.
+* @return Cursor de la lista.
+*/
+extern cursor_lista_t lista_cursor(lista_t *l);
+
+/**
+* @brief Indica si el cursor 'c' está ubicado en un elemento, esto es, si no llegó al final de la lista.
+* @param c Puntero al cursor.
+* @return TRUE si el cursor está en un elemento, de lo contrario, FALSE.
+*/
+extern int lista_cursor_valido(cursor_lista_t *c);
+
+/**
+* @brief Avanza el cursor 'c' al elemento siguiente. No tiene efecto si el cursor llegó al final de la lista.
+* @param c Puntero al cursor.
+*/
+extern void lista_cursor_siguiente(cursor_lista_t *c);
+
+/**
+* @brief Devuelve un puntero al elemento en el que está ubicado el cursor 'c'.
+* @param c Puntero al cursor.
+* @return El elemento actual, o NULL si el cursor llegó al final de la lista.
+*/
+extern elemento_t *lista_cursor_elemento(cursor_lista_t *c);
+
+/**
+* @brief Elimina de la lista el elemento en el que está ubicado el cursor 'c' y lo retorna, dejando al cursor en el elemento siguiente.
+* @param c Puntero al cursor.
+* @return El elemento removido de la lista, o NULL si el cursor llegó al final de la lista.
+*/
+extern elemento_t *lista_cursor_eliminar(cursor_lista_t *c);
+
 /**
 * @brief Dada la lista 'l' y la función 'comparar' ordena la lista de acuerdo al criterio de dicha función.
 * @param l Puntero a la lista de elementos.
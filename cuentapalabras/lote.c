@@ -0,0 +1,491 @@
+/**
+* @file lote.c
+* @brief Implementación del TDA Lote.
+* io_uring se utiliza mediante sus llamadas al sistema, sin bibliotecas adicionales. Cada archivo en curso ocupa una
+* ranura, y el archivo i-ésimo del lote ocupa la ranura i % en_vuelo, de modo que los archivos se entregan en orden
+* y a lo sumo en_vuelo contenidos están en memoria a la vez. Si un archivo llena su contenido de LOTE_TAMANIO_PARTE
+* caracteres, su ranura queda abierta y el resto se lee con pread al entregarlo, reutilizando el mismo contenido.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "lote.h"
+#include "traza.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+//Las operaciones de apertura, cierre y sondeo son enumerados; IORING_FEAT_FAST_POLL (5.7) indica un encabezado que las incluye.
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_FAST_POLL)
+#define LOTE_CON_IO_URING
+#endif
+#endif
+
+//Capacidad inicial del contenido de un archivo; se duplica, hasta LOTE_TAMANIO_PARTE, mientras el archivo no entre.
+#define LOTE_CAPACIDAD_INICIAL (64 * 1024)
+
+//Indica si los lotes se leen mediante io_uring cuando está disponible.
+static int io_uring_habilitado = TRUE;
+//Cantidad de archivos que se leen a la vez mediante io_uring (ver lote_configurar_memoria).
+static int en_vuelo = LOTE_EN_VUELO;
+
+/**
+ * @struct contenido
+ * @brief Modela el contenido leido de un archivo.
+*/
+struct contenido {
+    char *datos;
+    unsigned long cantidad; //Caracteres leidos.
+    unsigned long capacidad; //Caracteres que se pueden leer sin ampliar (se reserva uno más para el invocador).
+};
+
+void lote_configurar_io_uring(int habilitado){
+    io_uring_habilitado = habilitado;
+}
+
+void lote_configurar_memoria(unsigned long memoria_max){
+    en_vuelo = LOTE_EN_VUELO;
+    if (memoria_max>0 && memoria_max/(LOTE_TAMANIO_PARTE+1) < LOTE_EN_VUELO){
+        en_vuelo = (int) (memoria_max/(LOTE_TAMANIO_PARTE+1));
+    }
+    if (en_vuelo<1){
+        en_vuelo = 1;
+    }
+}
+
+unsigned long lote_memoria_maxima(){
+    return ((unsigned long) en_vuelo) * (LOTE_TAMANIO_PARTE+1);
+}
+
+/**
+ * @brief Operación Duplica la capacidad del contenido (o le asigna la capacidad inicial), conservando lo leido. La
+ * capacidad no supera LOTE_TAMANIO_PARTE.
+ * @throw ERROR_LOTE_MEMORIA si no se pudo reservar memoria.
+*/
+static void aux_ampliar(struct contenido *c){
+    unsigned long capacidad = (c->capacidad==0) ? LOTE_CAPACIDAD_INICIAL : 2*c->capacidad;
+    if (capacidad>LOTE_TAMANIO_PARTE){
+        capacidad = LOTE_TAMANIO_PARTE;
+    }
+    char *datos = (char*) realloc(c->datos, capacidad+1);
+
+    if (datos==NULL){
+        printf("Error %d: No se pudo reservar memoria para el contenido de un archivo.\n", ERROR_LOTE_MEMORIA);
+        exit(ERROR_LOTE_MEMORIA);
+    }
+    c->datos = datos;
+    c->capacidad = capacidad;
+}
+
+/**
+ * @brief Operación Lee los archivos de a uno con la biblioteca estándar y entrega el contenido de cada uno, por partes
+ * si no entra en LOTE_TAMANIO_PARTE caracteres.
+*/
+static void aux_leer_simple(char **rutas, int cant_rutas, funcion_archivo_t entregar, void *contexto){
+    struct contenido c = {NULL, 0, 0};
+
+    for (int i=0; i<cant_rutas; i++){
+        traza_comenzar("leer", rutas[i]);
+        FILE *f = fopen(rutas[i], "r");
+
+        if (f==NULL){
+            traza_terminar("leer");
+            entregar(i, NULL, 0, LOTE_ARCHIVO_COMPLETO, contexto);
+        }
+        else{
+            unsigned long leidos;
+            int parte = LOTE_ARCHIVO_COMPLETO;
+            c.cantidad = 0;
+            do{
+                if (c.cantidad==c.capacidad && c.capacidad<LOTE_TAMANIO_PARTE){
+                    aux_ampliar(&c);
+                }
+                //Si el contenido llegó a LOTE_TAMANIO_PARTE caracteres, se entrega como una parte y se reutiliza.
+                if (c.cantidad==c.capacidad){
+                    traza_terminar("leer");
+                    parte = (parte==LOTE_ARCHIVO_COMPLETO) ? LOTE_PARTE_INICIAL : LOTE_PARTE_INTERMEDIA;
+                    entregar(i, c.datos, c.cantidad, parte, contexto);
+                    traza_comenzar("leer", rutas[i]);
+                    c.cantidad = 0;
+                }
+                leidos = fread(c.datos+c.cantidad, 1, c.capacidad-c.cantidad, f);
+                c.cantidad = c.cantidad + leidos;
+            } while (leidos>0);
+            traza_terminar("leer");
+
+            parte = (parte==LOTE_ARCHIVO_COMPLETO) ? LOTE_ARCHIVO_COMPLETO : LOTE_PARTE_FINAL;
+            entregar(i, (ferror(f)) ? NULL : c.datos, c.cantidad, parte, contexto);
+            fclose(f);
+        }
+    }
+    free(c.datos);
+}
+
+#ifdef LOTE_CON_IO_URING
+
+//Operaciones de una solicitud, codificadas en los dos bits bajos de su 'user_data' (el resto es la ranura).
+#define OPERACION_ABRIR 0
+#define OPERACION_LEER 1
+#define OPERACION_CERRAR 2
+
+//Estados de una ranura.
+#define RANURA_LIBRE 0
+#define RANURA_EN_CURSO 1
+#define RANURA_LISTA 2
+#define RANURA_FALLIDA 3
+#define RANURA_PARCIAL 4 //El contenido se llenó sin alcanzar el fin del archivo, que sigue abierto.
+
+/**
+ * @struct anillo
+ * @brief Modela una instancia de io_uring: la cola de envíos, la cola de completados y el arreglo de solicitudes,
+ * compartidos con el núcleo mediante mmap.
+*/
+struct anillo {
+    int fd;
+    unsigned int entradas; //Capacidad de la cola de envíos.
+    unsigned int *sq_cabeza, *sq_cola, *sq_mascara, *sq_arreglo;
+    unsigned int *cq_cabeza, *cq_cola, *cq_mascara;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_mapa, *cq_mapa;
+    size_t sq_tamanio, cq_tamanio, sqes_tamanio;
+    unsigned int sin_enviar; //Solicitudes encoladas que aún no se enviaron al núcleo.
+};
+
+/**
+ * @struct ranura
+ * @brief Modela el estado de la lectura de un archivo en curso.
+*/
+struct ranura {
+    int estado;
+    int fd;
+    struct contenido contenido;
+};
+
+/**
+ * @brief Operación Indica si el núcleo admite las operaciones de apertura, lectura y cierre sobre el anillo.
+*/
+static int aux_anillo_admite_operaciones(struct anillo *A){
+    int to_return = FALSE;
+    unsigned int cant_operaciones = 256;
+    struct io_uring_probe *p = (struct io_uring_probe*) calloc(1, sizeof(struct io_uring_probe) + cant_operaciones*sizeof(struct io_uring_probe_op));
+
+    if (p!=NULL && syscall(__NR_io_uring_register, A->fd, IORING_REGISTER_PROBE, p, cant_operaciones)==0){
+        to_return = TRUE;
+        int operaciones[3] = {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE};
+        for (int i=0; i<3; i++){
+            if (operaciones[i]>p->last_op || (p->ops[operaciones[i]].flags & IO_URING_OP_SUPPORTED)==0){
+                to_return = FALSE;
+            }
+        }
+    }
+    free(p);
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Libera el anillo.
+*/
+static void aux_anillo_destruir(struct anillo *A){
+    if (A->sqes!=NULL && A->sqes!=MAP_FAILED){
+        munmap(A->sqes, A->sqes_tamanio);
+    }
+    if (A->cq_mapa!=NULL && A->cq_mapa!=MAP_FAILED && A->cq_mapa!=A->sq_mapa){
+        munmap(A->cq_mapa, A->cq_tamanio);
+    }
+    if (A->sq_mapa!=NULL && A->sq_mapa!=MAP_FAILED){
+        munmap(A->sq_mapa, A->sq_tamanio);
+    }
+    close(A->fd);
+}
+
+/**
+ * @brief Operación Crea un anillo con capacidad para 'entradas' solicitudes.
+ * @return TRUE si se creó el anillo y admite las operaciones necesarias, FALSE en caso contrario.
+*/
+static int aux_anillo_crear(struct anillo *A, unsigned int entradas){
+    struct io_uring_params p;
+    int to_return = FALSE;
+
+    memset(&p, 0, sizeof(p));
+    memset(A, 0, sizeof(struct anillo));
+    A->fd = (int) syscall(__NR_io_uring_setup, entradas, &p);
+
+    if (A->fd>=0){
+        A->entradas = p.sq_entries;
+        A->sq_tamanio = p.sq_off.array + p.sq_entries*sizeof(unsigned int);
+        A->cq_tamanio = p.cq_off.cqes + p.cq_entries*sizeof(struct io_uring_cqe);
+        A->sqes_tamanio = p.sq_entries*sizeof(struct io_uring_sqe);
+        //Con IORING_FEAT_SINGLE_MMAP ambas colas comparten un único mapeo.
+        if (p.features & IORING_FEAT_SINGLE_MMAP){
+            if (A->cq_tamanio>A->sq_tamanio){
+                A->sq_tamanio = A->cq_tamanio;
+            }
+            A->cq_tamanio = A->sq_tamanio;
+        }
+        A->sq_mapa = mmap(NULL, A->sq_tamanio, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, A->fd, IORING_OFF_SQ_RING);
+        if (p.features & IORING_FEAT_SINGLE_MMAP){
+            A->cq_mapa = A->sq_mapa;
+        }
+        else{
+            A->cq_mapa = mmap(NULL, A->cq_tamanio, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, A->fd, IORING_OFF_CQ_RING);
+        }
+        A->sqes = (struct io_uring_sqe*) mmap(NULL, A->sqes_tamanio, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, A->fd, IORING_OFF_SQES);
+
+        if (A->sq_mapa!=MAP_FAILED && A->cq_mapa!=MAP_FAILED && A->sqes!=MAP_FAILED){
+            char *sq = (char*) A->sq_mapa;
+            char *cq = (char*) A->cq_mapa;
+            A->sq_cabeza = (unsigned int*) (sq + p.sq_off.head);
+            A->sq_cola = (unsigned int*) (sq + p.sq_off.tail);
+            A->sq_mascara = (unsigned int*) (sq + p.sq_off.ring_mask);
+            A->sq_arreglo = (unsigned int*) (sq + p.sq_off.array);
+            A->cq_cabeza = (unsigned int*) (cq + p.cq_off.head);
+            A->cq_cola = (unsigned int*) (cq + p.cq_off.tail);
+            A->cq_mascara = (unsigned int*) (cq + p.cq_off.ring_mask);
+            A->cqes = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+            to_return = aux_anillo_admite_operaciones(A);
+        }
+        if (to_return==FALSE){
+            aux_anillo_destruir(A);
+        }
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Envía al núcleo las solicitudes encoladas y espera a que se completen al menos 'minimo' solicitudes.
+ * @throw ERROR_LOTE_LECTURA si el núcleo rechazó el envío.
+*/
+static void aux_anillo_enviar(struct anillo *A, unsigned int minimo){
+    int enviado = FALSE;
+
+    while (enviado==FALSE){
+        long r = syscall(__NR_io_uring_enter, A->fd, A->sin_enviar, minimo, (minimo>0) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (r>=0){
+            A->sin_enviar = A->sin_enviar - (unsigned int) r;
+            enviado = (A->sin_enviar==0);
+        }
+        else if (errno!=EINTR && errno!=EAGAIN && errno!=EBUSY){
+            printf("Error %d: No se pudieron enviar las lecturas a io_uring (errno %d).\n", ERROR_LOTE_LECTURA, errno);
+            exit(ERROR_LOTE_LECTURA);
+        }
+    }
+}
+
+/**
+ * @brief Operación Encola una solicitud en el anillo, enviando las anteriores si la cola está llena.
+ * @return Puntero a la solicitud, inicializada en 0, para que el invocador complete sus campos.
+*/
+static struct io_uring_sqe *aux_anillo_solicitud(struct anillo *A, int operacion, int ranura){
+    unsigned int cola = *(A->sq_cola);
+
+    if (cola - __atomic_load_n(A->sq_cabeza, __ATOMIC_ACQUIRE) == A->entradas){
+        aux_anillo_enviar(A, 0);
+    }
+    unsigned int indice = cola & *(A->sq_mascara);
+    struct io_uring_sqe *sqe = &(A->sqes[indice]);
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->user_data = (((unsigned long long) ranura) << 2) | (unsigned long long) operacion;
+    A->sq_arreglo[indice] = indice;
+    //La solicitud se publica al avanzar la cola, luego de completarla; por ello el avance se difiere a aux_anillo_publicar.
+    return sqe;
+}
+
+/**
+ * @brief Operación Publica la última solicitud obtenida con aux_anillo_solicitud, avanzando la cola de envíos.
+*/
+static void aux_anillo_publicar(struct anillo *A){
+    __atomic_store_n(A->sq_cola, *(A->sq_cola) + 1, __ATOMIC_RELEASE);
+    A->sin_enviar = A->sin_enviar + 1;
+}
+
+/**
+ * @brief Operación Encola la lectura del resto del archivo de la ranura, ampliando su contenido si está lleno.
+*/
+static void aux_solicitar_lectura(struct anillo *A, struct ranura *R, int r){
+    if (R->contenido.cantidad==R->contenido.capacidad){
+        aux_ampliar(&(R->contenido));
+    }
+    struct io_uring_sqe *sqe = aux_anillo_solicitud(A, OPERACION_LEER, r);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = R->fd;
+    sqe->addr = (unsigned long long) (R->contenido.datos + R->contenido.cantidad);
+    sqe->len = (unsigned int) (R->contenido.capacidad - R->contenido.cantidad);
+    sqe->off = R->contenido.cantidad;
+    aux_anillo_publicar(A);
+}
+
+/**
+ * @brief Operación Encola el cierre del archivo de la ranura; su resultado no se espera antes de entregar el contenido.
+*/
+static void aux_solicitar_cierre(struct anillo *A, struct ranura *R, int r){
+    struct io_uring_sqe *sqe = aux_anillo_solicitud(A, OPERACION_CERRAR, r);
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = R->fd;
+    aux_anillo_publicar(A);
+}
+
+/**
+ * @brief Operación Entrega el archivo de la ranura, cuyo contenido se llenó sin alcanzar el fin del archivo: entrega lo
+ * leido como parte inicial y lee y entrega el resto de a LOTE_TAMANIO_PARTE caracteres. Finalmente cierra el archivo.
+*/
+static void aux_entregar_por_partes(struct ranura *R, int indice, char *ruta, funcion_archivo_t entregar, void *contexto){
+    unsigned long desplazamiento = R->contenido.cantidad;
+    int parte = LOTE_PARTE_INICIAL;
+    long leidos = 1;
+
+    entregar(indice, R->contenido.datos, R->contenido.cantidad, parte, contexto);
+    while (parte!=LOTE_PARTE_FINAL){
+        R->contenido.cantidad = 0;
+        traza_comenzar("leer", ruta);
+        //Se llena el contenido, salvo que se alcance el fin del archivo o falle la lectura.
+        while (leidos>0 && R->contenido.cantidad<R->contenido.capacidad){
+            leidos = (long) pread(R->fd, R->contenido.datos + R->contenido.cantidad, R->contenido.capacidad - R->contenido.cantidad, (off_t) desplazamiento);
+            if (leidos<0 && errno==EINTR){
+                leidos = 1;
+            }
+            else if (leidos>0){
+                R->contenido.cantidad = R->contenido.cantidad + (unsigned long) leidos;
+                desplazamiento = desplazamiento + (unsigned long) leidos;
+            }
+        }
+        traza_terminar("leer");
+        parte = (leidos>0) ? LOTE_PARTE_INTERMEDIA : LOTE_PARTE_FINAL;
+        entregar(indice, (leidos<0) ? NULL : R->contenido.datos, R->contenido.cantidad, parte, contexto);
+    }
+    close(R->fd);
+}
+
+/**
+ * @brief Operación Lee los archivos mediante io_uring y entrega el contenido de cada uno, en orden.
+*/
+static void aux_leer_io_uring(struct anillo *A, char **rutas, int cant_rutas, funcion_archivo_t entregar, void *contexto){
+    struct ranura ranuras[LOTE_EN_VUELO];
+    int abiertos = 0; //Cantidad de archivos cuya apertura se solicitó.
+    int entregados = 0; //Cantidad de archivos entregados.
+    unsigned int en_curso = 0; //Solicitudes enviadas cuyo resultado no se recibió.
+
+    memset(ranuras, 0, sizeof(ranuras));
+    while (entregados<cant_rutas || en_curso>0){
+        //Se entregan, en orden, los archivos ya leidos.
+        while (entregados<cant_rutas && ranuras[entregados % en_vuelo].estado>=RANURA_LISTA){
+            struct ranura *R = &(ranuras[entregados % en_vuelo]);
+            if (R->estado==RANURA_PARCIAL){
+                aux_entregar_por_partes(R, entregados, rutas[entregados], entregar, contexto);
+            }
+            else{
+                entregar(entregados, (R->estado==RANURA_LISTA) ? R->contenido.datos : NULL, R->contenido.cantidad, LOTE_ARCHIVO_COMPLETO, contexto);
+            }
+            R->estado = RANURA_LIBRE;
+            entregados = entregados + 1;
+        }
+
+        //Se solicita la apertura de los archivos siguientes, mientras haya ranuras libres.
+        while (abiertos<cant_rutas && abiertos<entregados+en_vuelo){
+            int r = abiertos % en_vuelo;
+            struct io_uring_sqe *sqe = aux_anillo_solicitud(A, OPERACION_ABRIR, r);
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (unsigned long long) rutas[abiertos];
+            sqe->open_flags = O_RDONLY;
+            aux_anillo_publicar(A);
+            ranuras[r].estado = RANURA_EN_CURSO;
+            ranuras[r].contenido.cantidad = 0;
+            abiertos = abiertos + 1;
+            en_curso = en_curso + 1;
+        }
+
+        //El hilo solo espera al núcleo aquí: el resto del tiempo lo ocupa procesando los archivos entregados.
+        if (en_curso>0){
+            traza_comenzar("esperar e/s", NULL);
+            aux_anillo_enviar(A, 1);
+            traza_terminar("esperar e/s");
+        }
+
+        //Se procesan los resultados recibidos, encolando la operación siguiente de cada archivo.
+        unsigned int cabeza = *(A->cq_cabeza);
+        while (cabeza!=__atomic_load_n(A->cq_cola, __ATOMIC_ACQUIRE)){
+            struct io_uring_cqe *cqe = &(A->cqes[cabeza & *(A->cq_mascara)]);
+            int operacion = (int) (cqe->user_data & 3);
+            int r = (int) (cqe->user_data >> 2);
+            struct ranura *R = &(ranuras[r]);
+            en_curso = en_curso - 1;
+
+            if (operacion==OPERACION_ABRIR){
+                if (cqe->res<0){
+                    R->estado = RANURA_FALLIDA;
+                }
+                else{
+                    R->fd = cqe->res;
+                    aux_solicitar_lectura(A, R, r);
+                    en_curso = en_curso + 1;
+                }
+            }
+            else if (operacion==OPERACION_LEER){
+                if (cqe->res<0){
+                    R->estado = RANURA_FALLIDA;
+                }
+                else{
+                    R->contenido.cantidad = R->contenido.cantidad + (unsigned long) cqe->res;
+                    //Una lectura que llena el contenido puede no haber alcanzado el fin del archivo; una lectura
+                    //incompleta de un archivo regular, en cambio, sí lo alcanzó.
+                    if (cqe->res>0 && R->contenido.cantidad==R->contenido.capacidad){
+                        if (R->contenido.capacidad<LOTE_TAMANIO_PARTE){
+                            aux_solicitar_lectura(A, R, r);
+                            en_curso = en_curso + 1;
+                        }
+                        else{
+                            //El resto del archivo se lee al entregarlo, de a una parte por vez.
+                            R->estado = RANURA_PARCIAL;
+                        }
+                    }
+                    else{
+                        R->estado = RANURA_LISTA;
+                    }
+                }
+                if (R->estado==RANURA_LISTA || R->estado==RANURA_FALLIDA){
+                    aux_solicitar_cierre(A, R, r);
+                    en_curso = en_curso + 1;
+                }
+            }
+            cabeza = cabeza + 1;
+        }
+        __atomic_store_n(A->cq_cabeza, cabeza, __ATOMIC_RELEASE);
+    }
+
+    for (int i=0; i<en_vuelo; i++){
+        free(ranuras[i].contenido.datos);
+    }
+}
+
+#endif // LOTE_CON_IO_URING
+
+int lote_leer_archivos(char **rutas, int cant_rutas, funcion_archivo_t entregar, void *contexto){
+    int to_return = LOTE_LECTURA_SIMPLE;
+
+#ifdef LOTE_CON_IO_URING
+    struct anillo A;
+    //Cada ranura tiene a lo sumo una lectura y un cierre en curso.
+    if (io_uring_habilitado==TRUE && aux_anillo_crear(&A, 2*en_vuelo)==TRUE){
+        aux_leer_io_uring(&A, rutas, cant_rutas, entregar, contexto);
+        aux_anillo_destruir(&A);
+        to_return = LOTE_IO_URING;
+    }
+#endif
+
+    if (to_return==LOTE_LECTURA_SIMPLE){
+        aux_leer_simple(rutas, cant_rutas, entregar, contexto);
+    }
+
+    return to_return;
+}
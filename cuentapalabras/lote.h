@@ -0,0 +1,80 @@
+/**
+* @file lote.h
+* @brief Archivo encabezado del TDA Lote.
+* Lee el contenido de un lote de archivos y lo entrega, archivo por archivo y en el orden dado, a una función del
+* invocador. En Linux, las aperturas, lecturas y cierres se realizan mediante io_uring, manteniendo en curso hasta
+* LOTE_EN_VUELO archivos a la vez, de modo que muchos archivos pequeños no requieran tres llamadas al sistema cada uno.
+* Si io_uring no está disponible (sistema o núcleo que no lo admite, o deshabilitado por lote_configurar_io_uring),
+* los archivos se leen de a uno con las funciones de la biblioteca estándar.
+* Los archivos de hasta LOTE_TAMANIO_PARTE caracteres se entregan completos; los mayores se entregan en partes
+* consecutivas de a lo sumo LOTE_TAMANIO_PARTE caracteres, leidas a medida que se entregan, de modo que la memoria de
+* un lote no depende del tamaño de sus archivos (ver lote_memoria_maxima).
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef LOTE_H_INCLUDED
+#define LOTE_H_INCLUDED
+
+#define ERROR_LOTE_MEMORIA -22
+#define ERROR_LOTE_LECTURA -23
+
+//Cantidad máxima de archivos que se abren y leen a la vez mediante io_uring.
+#define LOTE_EN_VUELO 64
+//Cantidad máxima de caracteres de un archivo que se entregan de una vez.
+#define LOTE_TAMANIO_PARTE (1 << 18)
+
+//Parte del archivo que se entrega en cada invocación.
+#define LOTE_ARCHIVO_COMPLETO 0
+#define LOTE_PARTE_INICIAL 1
+#define LOTE_PARTE_INTERMEDIA 2
+#define LOTE_PARTE_FINAL 3
+
+//Mecanismo con el que se leyó un lote.
+#define LOTE_IO_URING 0
+#define LOTE_LECTURA_SIMPLE 1
+
+/**
+ * @typedef void(funcion_archivo_t)
+ * @brief Plantilla de función que recibe el contenido del archivo de posición 'indice' del lote.
+ * El contenido tiene 'n' caracteres y capacidad para uno más, por lo que puede modificarse (por ejemplo, con
+ * lector_procesar_contenido). Es NULL si el archivo no se pudo abrir o leer. Solo es válido durante la invocación.
+ * 'parte' es LOTE_ARCHIVO_COMPLETO si el contenido es el archivo entero. Si no, el archivo se entrega en invocaciones
+ * consecutivas con LOTE_PARTE_INICIAL, cero o más LOTE_PARTE_INTERMEDIA y LOTE_PARTE_FINAL (que puede estar vacía);
+ * las partes se cortan en cualquier caracter, incluso dentro de una palabra.
+*/
+typedef void (funcion_archivo_t)(int indice, char *contenido, unsigned long n, int parte, void *contexto);
+
+/**
+ * @brief Establece si los lotes se leen mediante io_uring cuando está disponible. Por defecto está habilitado.
+ * @param habilitado TRUE o FALSE.
+*/
+extern void lote_configurar_io_uring(int habilitado);
+
+/**
+ * @brief Limita la memoria que ocupan los contenidos de los archivos en curso de lectura, reduciendo la cantidad de
+ * archivos que se leen a la vez (al menos uno). Por defecto se leen LOTE_EN_VUELO archivos a la vez.
+ * @param memoria_max Cantidad de bytes que pueden ocupar los contenidos (0 indica LOTE_EN_VUELO archivos a la vez).
+*/
+extern void lote_configurar_memoria(unsigned long memoria_max);
+
+/**
+ * @brief Devuelve la cantidad máxima de bytes que ocupan los contenidos de los archivos en curso de lectura, según la
+ * cantidad de archivos que se leen a la vez. Cada contenido ocupa a lo sumo LOTE_TAMANIO_PARTE caracteres y uno más.
+*/
+extern unsigned long lote_memoria_maxima();
+
+/**
+ * @brief Lee los archivos de las rutas dadas e invoca a 'entregar' con el contenido de cada uno, completo o por partes,
+ * en el orden de 'rutas'.
+ * @param rutas Arreglo de rutas de los archivos.
+ * @param cant_rutas Cantidad de rutas.
+ * @param entregar Función que recibe el contenido de cada archivo.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'entregar'.
+ * @throw ERROR_LOTE_MEMORIA si no se pudo reservar memoria para los contenidos.
+ * @throw ERROR_LOTE_LECTURA si io_uring rechazó las solicitudes una vez iniciado el lote.
+ * @return LOTE_IO_URING o LOTE_LECTURA_SIMPLE, según el mecanismo con el que se leyó el lote.
+*/
+extern int lote_leer_archivos(char **rutas, int cant_rutas, funcion_archivo_t entregar, void *contexto);
+
+#endif // LOTE_H_INCLUDED
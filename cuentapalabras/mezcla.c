@@ -0,0 +1,593 @@
+/**
+* @file mezcla.c
+* @brief Implementación del TDA Mezcla.
+* Cada corrida es un archivo binario de registros <cantidad (64 bits), longitud, caracteres de la palabra>. Las corridas
+* volcadas desde un multiset están en orden lexicográfico, y las corridas temporales de la segunda etapa están
+* ordenadas según la función de comparación de la salida.
+* Se mantienen abiertas a lo sumo mezcla_vias_maximas() corridas a la vez: si hay más, se mezclan por grupos en corridas
+* intermedias, en tantas pasadas como sean necesarias. Las corridas creadas y aún no eliminadas se registran, de modo
+* que si el programa finaliza por un error se eliminan al salir.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <pthread.h>
+#endif
+#include "define.h"
+#include "lista.h"
+#include "multiset.h"
+#include "mezcla.h"
+
+/**
+ * @struct cursor_corrida
+ * @brief Modela la lectura secuencial de una corrida, conservando el registro actual.
+*/
+struct cursor_corrida {
+    FILE *f; ///Manejador del archivo de la corrida.
+    elemento_t actual; ///Último registro leido de la corrida.
+};
+typedef struct cursor_corrida cursor_corrida_t;
+
+/**
+ * @typedef int(funcion_menor_t)
+ * @brief Plantilla de función que indica si el cursor 'c1' debe salir antes que el cursor 'c2' en la mezcla.
+*/
+typedef int (funcion_menor_t)(cursor_corrida_t *c1, cursor_corrida_t *c2);
+
+//Función de comparación utilizada por qsort y por la mezcla de la segunda etapa.
+static funcion_comparacion_t *comparar_salida = NULL;
+
+//Rutas de las corridas creadas que aún no se eliminaron, y si ya se registró su eliminación al salir.
+static char **pendientes = NULL;
+static int cant_pendientes = 0;
+static int limpieza_registrada = FALSE;
+#ifndef _WIN32
+static pthread_mutex_t candado_pendientes = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * @brief Elimina las corridas pendientes. Se invoca al finalizar el programa, por lo que solo encuentra corridas si
+ * finalizó antes de eliminarlas (por ejemplo, por un error).
+*/
+static void aux_eliminar_pendientes(){
+    for (int i=0; i<cant_pendientes; i++){
+        remove(pendientes[i]);
+        free(pendientes[i]);
+    }
+    free(pendientes);
+    pendientes = NULL;
+    cant_pendientes = 0;
+}
+
+/**
+ * @brief Registra la corrida de la ruta dada como pendiente de eliminar.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria para el registro.
+*/
+static void aux_registrar_pendiente(char *ruta){
+#ifndef _WIN32
+    pthread_mutex_lock(&candado_pendientes);
+#endif
+    char **nuevas = (char**) realloc(pendientes, (cant_pendientes+1)*sizeof(char*));
+    char *copia = (char*) malloc(strlen(ruta)+1);
+    if (nuevas==NULL || copia==NULL){
+        printf("Error %d: No se pudo reservar memoria para la mezcla.\n", ERROR_MEZCLA_MEMORIA);
+        exit(ERROR_MEZCLA_MEMORIA);
+    }
+    strcpy(copia, ruta);
+    pendientes = nuevas;
+    pendientes[cant_pendientes] = copia;
+    cant_pendientes = cant_pendientes + 1;
+    if (limpieza_registrada==FALSE){
+        atexit(aux_eliminar_pendientes);
+        limpieza_registrada = TRUE;
+    }
+#ifndef _WIN32
+    pthread_mutex_unlock(&candado_pendientes);
+#endif
+}
+
+void mezcla_eliminar_corrida(char *path){
+#ifndef _WIN32
+    pthread_mutex_lock(&candado_pendientes);
+#endif
+    remove(path);
+    for (int i=0; i<cant_pendientes; i++){
+        if (strcmp(pendientes[i], path)==0){
+            free(pendientes[i]);
+            cant_pendientes = cant_pendientes - 1;
+            pendientes[i] = pendientes[cant_pendientes];
+            i = cant_pendientes;
+        }
+    }
+#ifndef _WIN32
+    pthread_mutex_unlock(&candado_pendientes);
+#endif
+}
+
+int mezcla_vias_maximas(){
+    int to_return = MEZCLA_VIAS;
+#ifndef _WIN32
+    //La mitad de los descriptores disponibles queda para los archivos de entrada y salida del programa.
+    long limite = sysconf(_SC_OPEN_MAX);
+    if (limite>0 && limite/2<to_return){
+        to_return = (int) (limite/2);
+    }
+#endif
+    if (to_return<2){
+        to_return = 2;
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Crea el archivo de una corrida para escritura y lo registra como pendiente de eliminar.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo crear el archivo.
+ * @return Manejador del archivo abierto.
+*/
+static FILE *aux_crear_corrida(char *path){
+    FILE *f = fopen(path, "wb");
+    if (f==NULL){
+        printf("Error %d: No se pudo crear la corrida '%s'.\n", ERROR_MEZCLA_ARCHIVO, path);
+        exit(ERROR_MEZCLA_ARCHIVO);
+    }
+    aux_registrar_pendiente(path);
+
+    return f;
+}
+
+/**
+ * @brief Escribe un registro en el archivo de la corrida.
+ * @param f Puntero al manejador de archivo.
+ * @param palabra Puntero a la cadena de caracteres.
+ * @param cantidad Cantidad de repeticiones de la palabra.
+*/
+static void aux_escribir_registro(FILE *f, char *palabra, long long cantidad){
+    int longitud = strlen(palabra);
+    fwrite(&cantidad, sizeof(long long), 1, f);
+    fwrite(&longitud, sizeof(int), 1, f);
+    fwrite(palabra, sizeof(char), longitud, f);
+}
+
+/**
+ * @brief Lee el siguiente registro de la corrida en el elemento 'e', reservando memoria para su palabra.
+ * @param f Puntero al manejador de archivo.
+ * @param e Puntero al elemento donde se almacena el registro.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria para la palabra.
+ * @return TRUE si se leyó un registro, FALSE si la corrida finalizó.
+*/
+static int aux_leer_registro(FILE *f, elemento_t *e){
+    int longitud;
+
+    if (fread(&(e->a), sizeof(long long), 1, f)!=1 || fread(&longitud, sizeof(int), 1, f)!=1){
+        return FALSE;
+    }
+    e->b = (char*) malloc((longitud+1)*sizeof(char));
+    if (e->b==NULL){
+        printf("Error %d: No se pudo reservar memoria para la palabra de la corrida.\n", ERROR_MEZCLA_MEMORIA);
+        exit(ERROR_MEZCLA_MEMORIA);
+    }
+    if (fread(e->b, sizeof(char), longitud, f)!=(size_t)longitud){
+        free(e->b);
+        e->b = NULL;
+        return FALSE;
+    }
+    e->b[longitud] = '\0';
+
+    return TRUE;
+}
+
+/**
+ * @brief Función de visita que escribe cada palabra del multiset en la corrida recibida como contexto.
+*/
+static void aux_visitar_volcado(char *palabra, long long cantidad, void *contexto){
+    aux_escribir_registro((FILE*) contexto, palabra, cantidad);
+}
+
+void mezcla_volcar_corrida(multiset_t *m, char *path){
+    FILE *f = aux_crear_corrida(path);
+    //El recorrido del multiset es lexicográfico, por lo que la corrida queda ordenada.
+    multiset_recorrer(m, aux_visitar_volcado, f);
+    fclose(f);
+}
+
+//----MEZCLA DE K VIAS MEDIANTE UN HEAP DE CURSORES----
+
+/**
+ * @brief Indica si el registro actual de 'c1' es lexicográficamente menor al de 'c2'.
+*/
+static int aux_menor_lexicografico(cursor_corrida_t *c1, cursor_corrida_t *c2){
+    return strcmp(c1->actual.b, c2->actual.b)<0;
+}
+
+/**
+ * @brief Indica si el registro actual de 'c1' es menor al de 'c2' según la función de comparación de la salida.
+*/
+static int aux_menor_salida(cursor_corrida_t *c1, cursor_corrida_t *c2){
+    return comparar_salida(&(c1->actual), &(c2->actual))==ELEM1_MENOR_QUE_ELEM2;
+}
+
+/**
+ * @brief Restablece la propiedad de heap (mínimo en la raiz) a partir de la posición 'pos' hacia abajo.
+ * @param heap Arreglo de punteros a cursores.
+ * @param n Cantidad de cursores en el heap.
+ * @param pos Posición a hundir.
+ * @param menor Función que establece el orden de los cursores.
+*/
+static void aux_hundir(cursor_corrida_t **heap, int n, int pos, funcion_menor_t menor){
+    int terminado = FALSE;
+
+    while (terminado==FALSE){
+        int minimo = pos;
+        int izq = 2*pos + 1;
+        int der = 2*pos + 2;
+
+        if (izq<n && menor(heap[izq], heap[minimo])){
+            minimo = izq;
+        }
+        if (der<n && menor(heap[der], heap[minimo])){
+            minimo = der;
+        }
+
+        if (minimo==pos){
+            terminado = TRUE;
+        }
+        else{
+            cursor_corrida_t *aux = heap[pos];
+            heap[pos] = heap[minimo];
+            heap[minimo] = aux;
+            pos = minimo;
+        }
+    }
+}
+
+/**
+ * @brief Abre las corridas dadas y construye el heap con el primer registro de cada una.
+ * @param rutas Rutas de las corridas.
+ * @param k Cantidad de corridas.
+ * @param cursores Arreglo de k cursores a inicializar.
+ * @param heap Arreglo de k punteros donde se construye el heap.
+ * @param menor Función que establece el orden de los cursores.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo abrir alguna corrida.
+ * @return Cantidad de cursores no vacíos en el heap.
+*/
+static int aux_construir_heap(char **rutas, int k, cursor_corrida_t *cursores, cursor_corrida_t **heap, funcion_menor_t menor){
+    int n = 0;
+
+    for (int i=0; i<k; i++){
+        cursores[i].f = fopen(rutas[i], "rb");
+        if (cursores[i].f==NULL){
+            printf("Error %d: No se pudo abrir la corrida '%s'.\n", ERROR_MEZCLA_ARCHIVO, rutas[i]);
+            exit(ERROR_MEZCLA_ARCHIVO);
+        }
+        if (aux_leer_registro(cursores[i].f, &(cursores[i].actual))==TRUE){
+            heap[n] = &cursores[i];
+            n = n + 1;
+        }
+    }
+    for (int i=n/2-1; i>=0; i--){
+        aux_hundir(heap, n, i, menor);
+    }
+
+    return n;
+}
+
+/**
+ * @brief Avanza el cursor de la raiz del heap al siguiente registro de su corrida, quitándolo del heap si finalizó.
+ * @param heap Arreglo de punteros a cursores.
+ * @param n Cantidad de cursores en el heap.
+ * @param menor Función que establece el orden de los cursores.
+ * @return Nueva cantidad de cursores en el heap.
+*/
+static int aux_avanzar_raiz(cursor_corrida_t **heap, int n, funcion_menor_t menor){
+    if (aux_leer_registro(heap[0]->f, &(heap[0]->actual))==FALSE){
+        n = n - 1;
+        heap[0] = heap[n];
+    }
+    aux_hundir(heap, n, 0, menor);
+
+    return n;
+}
+
+/**
+ * @brief Reserva memoria para 'k' cursores y su heap.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria.
+*/
+static void aux_reservar_cursores(int k, cursor_corrida_t **cursores, cursor_corrida_t ***heap){
+    *cursores = (cursor_corrida_t*) malloc(k*sizeof(cursor_corrida_t) + 1);
+    *heap = (cursor_corrida_t**) malloc(k*sizeof(cursor_corrida_t*) + 1);
+    if (*cursores==NULL || *heap==NULL){
+        printf("Error %d: No se pudo reservar memoria para la mezcla.\n", ERROR_MEZCLA_MEMORIA);
+        exit(ERROR_MEZCLA_MEMORIA);
+    }
+}
+
+/**
+ * @brief Cierra las corridas y libera los cursores y el heap.
+*/
+static void aux_liberar_cursores(int k, cursor_corrida_t *cursores, cursor_corrida_t **heap){
+    for (int i=0; i<k; i++){
+        fclose(cursores[i].f);
+    }
+    free(cursores);
+    free(heap);
+}
+
+//----ORDENAMIENTO POR TRAMOS SEGUN LA FUNCION DE COMPARACION DE LA SALIDA----
+
+/**
+ * @struct tramo
+ * @brief Modela el buffer de elementos ya combinados que se ordena en memoria antes de escribirse.
+*/
+struct tramo {
+    elemento_t *elementos; ///Arreglo de elementos del tramo.
+    int cantidad; ///Cantidad de elementos cargados.
+    int capacidad; ///Capacidad del arreglo de elementos.
+    unsigned long memoria; ///Bytes utilizados por los elementos cargados.
+};
+typedef struct tramo tramo_t;
+
+/**
+ * @brief Adaptador de la función de comparación de la salida para qsort.
+*/
+static int aux_comparar_qsort(const void *e1, const void *e2){
+    comparacion_resultado_t resultado = comparar_salida((elemento_t*) e1, (elemento_t*) e2);
+    int to_return = 0;
+
+    if (resultado==ELEM1_MENOR_QUE_ELEM2){
+        to_return = -1;
+    }
+    else{
+        if (resultado==ELEM1_MAYOR_QUE_ELEM2){
+            to_return = 1;
+        }
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Agrega el elemento al tramo, tomando posesión de su palabra.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo ampliar el tramo.
+*/
+static void aux_tramo_agregar(tramo_t *t, elemento_t e){
+    if (t->cantidad==t->capacidad){
+        t->capacidad = (t->capacidad==0) ? 1024 : 2*t->capacidad;
+        t->elementos = (elemento_t*) realloc(t->elementos, t->capacidad*sizeof(elemento_t));
+        if (t->elementos==NULL){
+            printf("Error %d: No se pudo reservar memoria para la mezcla.\n", ERROR_MEZCLA_MEMORIA);
+            exit(ERROR_MEZCLA_MEMORIA);
+        }
+    }
+    t->elementos[t->cantidad] = e;
+    t->cantidad = t->cantidad + 1;
+    t->memoria = t->memoria + sizeof(elemento_t) + strlen(e.b) + 1;
+}
+
+/**
+ * @brief Ordena el tramo y lo escribe en el archivo 'f', ya sea como corrida (binaria) o como texto de salida.
+ * Luego del volcado el tramo queda vacío.
+*/
+static void aux_tramo_volcar(tramo_t *t, FILE *f, int como_corrida){
+    qsort(t->elementos, t->cantidad, sizeof(elemento_t), aux_comparar_qsort);
+    for (int i=0; i<t->cantidad; i++){
+        if (como_corrida==TRUE){
+            aux_escribir_registro(f, t->elementos[i].b, t->elementos[i].a);
+        }
+        else{
+            fprintf(f, "%lld   %s\n", t->elementos[i].a, t->elementos[i].b);
+        }
+        free(t->elementos[i].b);
+    }
+    t->cantidad = 0;
+    t->memoria = 0;
+}
+
+/**
+ * @brief Construye la ruta de la i-ésima corrida temporal del tipo dado ('f' para los tramos ordenados según la salida,
+ * 'p' para las corridas intermedias de las mezclas por pasadas).
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria para la ruta.
+*/
+static char *aux_ruta_temporal(char *path_temporal, char tipo, int i){
+    char *ruta = (char*) malloc(strlen(path_temporal) + 16);
+    if (ruta==NULL){
+        printf("Error %d: No se pudo reservar memoria para la mezcla.\n", ERROR_MEZCLA_MEMORIA);
+        exit(ERROR_MEZCLA_MEMORIA);
+    }
+    sprintf(ruta, "%s.%c%d", path_temporal, tipo, i);
+    return ruta;
+}
+
+/**
+ * @brief Ordena el tramo y lo escribe en una nueva corrida temporal, que se agrega al arreglo de temporales.
+ * @param t Puntero al tramo a volcar.
+ * @param path_temporal Prefijo de las corridas temporales.
+ * @param temporales Arreglo de rutas de las corridas temporales creadas hasta el momento.
+ * @param cant_temporales Puntero a la cantidad de corridas temporales, que se incrementa en 1.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo crear la corrida.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria.
+ * @return Arreglo de rutas con la nueva corrida agregada.
+*/
+static char **aux_tramo_volcar_temporal(tramo_t *t, char *path_temporal, char **temporales, int *cant_temporales){
+    int i = *cant_temporales;
+
+    temporales = (char**) realloc(temporales, (i+1)*sizeof(char*));
+    if (temporales==NULL){
+        printf("Error %d: No se pudo reservar memoria para la mezcla.\n", ERROR_MEZCLA_MEMORIA);
+        exit(ERROR_MEZCLA_MEMORIA);
+    }
+    temporales[i] = aux_ruta_temporal(path_temporal, 'f', i);
+    FILE *f = aux_crear_corrida(temporales[i]);
+    aux_tramo_volcar(t, f, TRUE);
+    fclose(f);
+    *cant_temporales = i + 1;
+
+    return temporales;
+}
+
+//----MEZCLA POR PASADAS----
+
+/**
+ * @brief Elimina las corridas temporales dadas y libera sus rutas y el arreglo.
+*/
+static void aux_eliminar_intermedias(char **rutas, int cant){
+    for (int i=0; i<cant; i++){
+        mezcla_eliminar_corrida(rutas[i]);
+        free(rutas[i]);
+    }
+    free(rutas);
+}
+
+//Cantidad de corridas intermedias creadas, que numera sus rutas.
+static int cant_intermedias = 0;
+
+/**
+ * @brief Mezcla las corridas dadas en una nueva corrida en 'destino', en el orden que establece 'menor'.
+ * @param rutas Rutas de las corridas.
+ * @param k Cantidad de corridas, a lo sumo mezcla_vias_maximas().
+ * @param menor Función que establece el orden de los cursores.
+ * @param combinar TRUE si se suman las repeticiones de una misma palabra (corridas en orden lexicográfico).
+ * @param destino Ruta de la corrida a crear.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo abrir o crear alguna corrida.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria.
+*/
+static void aux_mezclar_en_corrida(char **rutas, int k, funcion_menor_t menor, int combinar, char *destino){
+    cursor_corrida_t *cursores;
+    cursor_corrida_t **heap;
+    FILE *f = aux_crear_corrida(destino);
+
+    aux_reservar_cursores(k, &cursores, &heap);
+    int n = aux_construir_heap(rutas, k, cursores, heap, menor);
+    while (n>0){
+        elemento_t e = heap[0]->actual;
+        n = aux_avanzar_raiz(heap, n, menor);
+        while (combinar==TRUE && n>0 && strcmp(heap[0]->actual.b, e.b)==0){
+            e.a = e.a + heap[0]->actual.a;
+            free(heap[0]->actual.b);
+            n = aux_avanzar_raiz(heap, n, menor);
+        }
+        aux_escribir_registro(f, e.b, e.a);
+        free(e.b);
+    }
+    aux_liberar_cursores(k, cursores, heap);
+    fclose(f);
+}
+
+/**
+ * @brief Mezcla las corridas por grupos de mezcla_vias_maximas() en corridas intermedias, en tantas pasadas como sean
+ * necesarias para que queden a lo sumo mezcla_vias_maximas(). Las corridas intermedias ya mezcladas se eliminan.
+ * @param rutas Rutas de las corridas, que no se eliminan ni se liberan.
+ * @param cant Puntero a la cantidad de corridas, donde se almacena la cantidad resultante.
+ * @param menor Función que establece el orden de los cursores.
+ * @param combinar TRUE si se suman las repeticiones de una misma palabra.
+ * @param path_temporal Prefijo de las corridas intermedias.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo abrir o crear alguna corrida.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria.
+ * @return 'rutas' si no fue necesario reducirlas, o un arreglo de rutas de corridas intermedias, que se eliminan con
+ * aux_eliminar_intermedias.
+*/
+static char **aux_reducir_corridas(char **rutas, int *cant, funcion_menor_t menor, int combinar, char *path_temporal){
+    int vias = mezcla_vias_maximas();
+    char **actuales = rutas;
+    int cant_actuales = *cant;
+
+    while (cant_actuales>vias){
+        int cant_nuevas = (cant_actuales + vias - 1) / vias;
+        char **nuevas = (char**) malloc(cant_nuevas*sizeof(char*));
+        if (nuevas==NULL){
+            printf("Error %d: No se pudo reservar memoria para la mezcla.\n", ERROR_MEZCLA_MEMORIA);
+            exit(ERROR_MEZCLA_MEMORIA);
+        }
+        for (int i=0; i<cant_nuevas; i++){
+            int desde = i*vias;
+            int k = (cant_actuales-desde<vias) ? cant_actuales-desde : vias;
+            nuevas[i] = aux_ruta_temporal(path_temporal, 'p', cant_intermedias);
+            cant_intermedias = cant_intermedias + 1;
+            aux_mezclar_en_corrida(actuales+desde, k, menor, combinar, nuevas[i]);
+        }
+        if (actuales!=rutas){
+            aux_eliminar_intermedias(actuales, cant_actuales);
+        }
+        actuales = nuevas;
+        cant_actuales = cant_nuevas;
+    }
+    *cant = cant_actuales;
+
+    return actuales;
+}
+
+void mezcla_k_vias(char **corridas, int cant_corridas, funcion_comparacion_t comparar, unsigned long memoria_max, char *path_temporal, FILE *salida){
+    cursor_corrida_t *cursores;
+    cursor_corrida_t **heap;
+    tramo_t tramo = {NULL, 0, 0, 0};
+    char **temporales = NULL;
+    int cant_temporales = 0;
+    int cant_entrada = cant_corridas;
+
+    comparar_salida = comparar;
+
+    ///Etapa 1: mezcla lexicográfica de las corridas, sumando las repeticiones de una misma palabra. Si hay más corridas
+    ///de las que pueden abrirse a la vez, primero se mezclan por grupos.
+    char **entrada = aux_reducir_corridas(corridas, &cant_entrada, aux_menor_lexicografico, TRUE, path_temporal);
+    aux_reservar_cursores(cant_entrada, &cursores, &heap);
+    int n = aux_construir_heap(entrada, cant_entrada, cursores, heap, aux_menor_lexicografico);
+
+    while (n>0){
+        elemento_t combinado = heap[0]->actual;
+        n = aux_avanzar_raiz(heap, n, aux_menor_lexicografico);
+
+        //Mientras la raiz contenga la misma palabra, se acumulan sus repeticiones.
+        while (n>0 && strcmp(heap[0]->actual.b, combinado.b)==0){
+            combinado.a = combinado.a + heap[0]->actual.a;
+            free(heap[0]->actual.b);
+            n = aux_avanzar_raiz(heap, n, aux_menor_lexicografico);
+        }
+        aux_tramo_agregar(&tramo, combinado);
+
+        //Si el tramo supera la memoria disponible, se ordena y se escribe en una corrida temporal.
+        if (tramo.memoria>memoria_max){
+            temporales = aux_tramo_volcar_temporal(&tramo, path_temporal, temporales, &cant_temporales);
+        }
+    }
+    aux_liberar_cursores(cant_entrada, cursores, heap);
+    if (entrada!=corridas){
+        aux_eliminar_intermedias(entrada, cant_entrada);
+    }
+
+    ///Etapa 2: si todo entró en memoria se escribe directamente, sino se mezclan las corridas temporales.
+    if (cant_temporales==0){
+        aux_tramo_volcar(&tramo, salida, FALSE);
+    }
+    else{
+        //El último tramo se ordena en memoria y se escribe como una corrida más.
+        temporales = aux_tramo_volcar_temporal(&tramo, path_temporal, temporales, &cant_temporales);
+
+        int cant_tramos = cant_temporales;
+        char **tramos = aux_reducir_corridas(temporales, &cant_tramos, aux_menor_salida, FALSE, path_temporal);
+        aux_reservar_cursores(cant_tramos, &cursores, &heap);
+        n = aux_construir_heap(tramos, cant_tramos, cursores, heap, aux_menor_salida);
+        while (n>0){
+            fprintf(salida, "%lld   %s\n", heap[0]->actual.a, heap[0]->actual.b);
+            free(heap[0]->actual.b);
+            n = aux_avanzar_raiz(heap, n, aux_menor_salida);
+        }
+        aux_liberar_cursores(cant_tramos, cursores, heap);
+        if (tramos!=temporales){
+            aux_eliminar_intermedias(tramos, cant_tramos);
+        }
+
+        //Elimina las corridas temporales.
+        for (int i=0; i<cant_temporales; i++){
+            mezcla_eliminar_corrida(temporales[i]);
+            free(temporales[i]);
+        }
+    }
+
+    free(tramo.elementos);
+    free(temporales);
+}
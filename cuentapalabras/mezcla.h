@@ -0,0 +1,66 @@
+/**
+* @file mezcla.h
+* @brief Archivo encabezado del TDA Mezcla.
+* Permite volcar el contenido de un multiset a disco como una corrida ordenada de pares <palabra, cantidad> y
+* luego combinar varias corridas mediante una mezcla de k vías, de modo que la memoria utilizada quede acotada.
+* La cantidad de archivos abiertos también queda acotada: las corridas se mezclan de a grupos de a lo sumo
+* mezcla_vias_maximas() y, si hay más, en varias pasadas.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef MEZCLA_H_INCLUDED
+#define MEZCLA_H_INCLUDED
+
+#include <stdio.h>
+#include "lista.h"
+#include "multiset.h"
+
+//Constantes para representar los posibles errores en las operaciones del TDA Mezcla.
+#define ERROR_MEZCLA_ARCHIVO -11
+#define ERROR_MEZCLA_MEMORIA -12
+
+//Cantidad máxima de corridas que se mezclan a la vez (ver mezcla_vias_maximas). Puede cambiarse al compilar.
+#ifndef MEZCLA_VIAS
+#define MEZCLA_VIAS 64
+#endif
+
+/**
+ * @brief Escribe en el archivo 'path' todas las palabras del multiset 'm' en orden lexicográfico junto a su cantidad de repeticiones.
+ * @param m Puntero al multiset a volcar.
+ * @param path Puntero a cadena de caracteres con la ruta del archivo de la corrida.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo crear el archivo de la corrida.
+*/
+extern void mezcla_volcar_corrida(multiset_t *m, char *path);
+
+/**
+ * @brief Elimina el archivo de una corrida volcada con mezcla_volcar_corrida. Las corridas que no se eliminan se
+ * eliminan al finalizar el programa, de modo que no quedan en disco si finaliza por un error.
+ * @param path Puntero a cadena de caracteres con la ruta del archivo de la corrida.
+*/
+extern void mezcla_eliminar_corrida(char *path);
+
+/**
+ * @brief Devuelve la cantidad de corridas que se mezclan a la vez: MEZCLA_VIAS, o la mitad de la cantidad de archivos
+ * que el proceso puede tener abiertos si es menor.
+ * @return Entero mayor o igual a 2.
+*/
+extern int mezcla_vias_maximas();
+
+/**
+ * @brief Combina las corridas dadas sumando las repeticiones de una misma palabra y escribe el resultado en 'salida'
+ * ordenado según 'comparar', con el formato "cantidad   palabra" por linea.
+ * Si los pares combinados exceden 'memoria_max' bytes, se ordenan por tramos en archivos temporales con prefijo
+ * 'path_temporal' que luego se mezclan y eliminan.
+ * @param corridas Puntero a punteros de cadenas de caracteres con las rutas de las corridas.
+ * @param cant_corridas Entero con la cantidad de corridas.
+ * @param comparar Función de comparación de elementos que establece el orden de la salida.
+ * @param memoria_max Entero positivo con la cantidad de bytes que se pueden mantener en memoria.
+ * @param path_temporal Puntero a cadena de caracteres con el prefijo de los archivos temporales.
+ * @param salida Puntero al manejador del archivo de salida. Requiere que esté abierto para escritura.
+ * @throw ERROR_MEZCLA_ARCHIVO si no se pudo abrir o crear alguno de los archivos.
+ * @throw ERROR_MEZCLA_MEMORIA si no se pudo reservar memoria.
+*/
+extern void mezcla_k_vias(char **corridas, int cant_corridas, funcion_comparacion_t comparar, unsigned long memoria_max, char *path_temporal, FILE *salida);
+
+#endif // MEZCLA_H_INCLUDED
@@ -6,46 +6,146 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 #include "multiset.h"
 #include "lista.h"
 #include "define.h"
+#include "patricia.h"
+#include "rafaga.h"
+#include "aproximado.h"
+#include "contador.h"
+#include "alfabeto.h"
 
 /**
  * @struct trie
  * @brief Modela un árbol trie, donde el rótulo será la cantidad de repeticiones de la palabra hasta el nodo actual y
- * puede tener hasta 26 nodos hijos, donde cada hijo representa un caracter entre 'a' y 'z' (excluyendo a la ñ).
+ * puede tener hasta ALFABETO_TAMANIO nodos hijos, donde cada hijo representa un caracter del alfabeto (ver alfabeto.h).
 */
 struct trie {
-    int cantidad; //Cantidad de veces que aparece esa palabra en el multiset.
-    struct trie *siguiente[26];
+    contador_t cantidad; //Cantidad de veces que aparece esa palabra en el multiset (ver contador.h).
+    unsigned int id; //Identificador de la palabra, asignado en su primera inserción (ocupa el relleno junto al contador).
+    unsigned int generacion; //Generación del multiset en la que se creó el nodo: si es anterior a la actual, el nodo puede estar compartido con instantáneas y no se modifica.
+    struct trie *siguiente[ALFABETO_TAMANIO];
 };
 
 /**
- * @brief Operación Dado un char, devuelve la posicion del índice entre 0 y 25 del nodo trie que le corresponde al char.
- * @param ch Puntero al caracter.
- * @return Entero entre 0 y 25 si el char está entre 'a' y 'z' (excluyendo ñ). En caso contrario, devuelve -1.
+ * @struct multiset
+ * @brief Modela el multiset como la raiz de un árbol trie junto a la cantidad de nodos reservados para el mismo.
 */
-static int aux_recuperar_posicion_en_alfabeto(char*ch){
-    int value_ch = *ch;
+struct multiset {
+    int modo; //Implementación del multiset (MULTISET_MODO_TRIE, MULTISET_MODO_COMPACTO, MULTISET_MODO_APROXIMADO o MULTISET_MODO_RAFAGA).
+    struct trie *raiz; //Nodo raiz del árbol, que representa a la cadena vacía (solo en MULTISET_MODO_TRIE).
+    unsigned long cant_nodos; //Cantidad de nodos reservados (incluyendo la raiz).
+    unsigned int cant_palabras; //Cantidad de palabras distintas, que es también el próximo identificador a asignar.
+    patricia_t *compacto; //Árbol con compresión de caminos (solo en MULTISET_MODO_COMPACTO).
+    aproximado_t *aproximado; //Contador aproximado (solo en MULTISET_MODO_APROXIMADO).
+    rafaga_t *rafaga; //Trie de ráfagas (solo en MULTISET_MODO_RAFAGA).
+    tabla_contadores_t *desbordados; //Contadores del trie que no entran en el campo del nodo (NULL si no hay).
+    struct trie *bloque; //Arreglo contiguo de nodos construido por multiset_compactar (NULL si no hay).
+    unsigned long cant_bloque; //Cantidad de nodos del bloque.
+    unsigned int generacion; //Generación de los nodos que se pueden modificar o, en una instantánea, versión que muestra.
+    int instantanea; //TRUE si el multiset es una instantánea de solo lectura (ver multiset_instantanea).
+    struct versiones *versiones; //Registro de las instantáneas tomadas (NULL si nunca se tomó una).
+    struct trie *libres; //Nodos devueltos por multiset_reiniciar para reutilizarlos, enlazados por su primer hijo.
+    unsigned long cant_libres; //Cantidad de nodos en 'libres'.
+};
 
-    if ((value_ch>=97) && (value_ch<=122)){
-        value_ch = value_ch - 97;
-    }
-    else{
-        value_ch = -1;
-    }
+/**
+ * @struct retirado
+ * @brief Modela un nodo que dejó de pertenecer al trie del multiset pero que las instantáneas de versión menor o igual
+ * a 'hasta' pueden seguir viendo. Si 'arbol' es TRUE, se retira el trie completo a partir del nodo junto al bloque
+ * contiguo de sus nodos compactados; si no, solo el nodo.
+*/
+struct retirado {
+    struct trie *nodo;
+    struct trie *bloque;
+    unsigned long cant_bloque;
+    unsigned int hasta;
+    int arbol;
+};
+
+/**
+ * @struct lista_retirados
+ * @brief Modela un arreglo de nodos retirados, ordenado por 'hasta' de forma creciente.
+*/
+struct lista_retirados {
+    struct retirado *entradas;
+    unsigned long cantidad;
+    unsigned long capacidad;
+};
+
+/**
+ * @struct version_leida
+ * @brief Modela una versión del multiset junto a la cantidad de instantáneas vivas que la muestran.
+*/
+struct version_leida {
+    unsigned int version;
+    unsigned int lectores;
+};
+
+/**
+ * @struct versiones
+ * @brief Modela el registro compartido entre un multiset y sus instantáneas. 'leidas' contiene las versiones con
+ * instantáneas vivas, en orden creciente, y 'retirados' los nodos que esperan a que no queden instantáneas que los vean.
+ * Los nodos que retira el hilo que inserta se acumulan en 'pendientes' sin tomar el candado, y pasan a 'retirados' al
+ * tomar la siguiente instantánea o al compactar, vaciar o eliminar el multiset. El registro se libera una vez eliminados
+ * el multiset y todas sus instantáneas.
+*/
+struct versiones {
+#ifndef _WIN32
+    pthread_mutex_t candado;
+#endif
+    struct version_leida *leidas;
+    unsigned int cant_leidas;
+    unsigned int capacidad_leidas;
+    struct lista_retirados retirados;
+    struct lista_retirados pendientes;
+    int vivo; //TRUE mientras no se elimine el multiset del que se toman las instantáneas.
+};
+
+//Parámetros con los que se crean los multisets en MULTISET_MODO_APROXIMADO.
+static double error_aproximado = MULTISET_APROXIMADO_ERROR;
+static int capacidad_aproximado = MULTISET_APROXIMADO_CAPACIDAD;
+//Indica si multiset_compactar respalda los bloques grandes con páginas grandes.
+static int paginas_grandes = FALSE;
+
+//Tamaño de una página grande (transparent huge page) en x86-64 y arm64 con páginas de 4 KB.
+#define TAMANIO_PAGINA_GRANDE (2UL << 20)
+//Longitud de las claves que se filtran en un arreglo local; las más largas se filtran en memoria reservada.
+#define LONGITUD_CLAVE_LOCAL 128
+
+/**
+ * @struct recorrido_trie
+ * @brief Modela la palabra del nodo en curso de un recorrido del trie. Como en patricia.c, el arreglo se amplía con la
+ * profundidad del recorrido en lugar de copiarse en cada nivel, de modo que la pila no depende de la longitud de las palabras.
+*/
+struct recorrido_trie {
+    char *palabra; //Palabra del nodo en curso (terminada en '\0').
+    unsigned long capacidad; //Capacidad del arreglo 'palabra'.
+};
 
-    return value_ch;
+/**
+ * @brief Operación Dado un char, devuelve la posicion del índice entre 0 y ALFABETO_TAMANIO-1 del nodo trie que le corresponde al char.
+ * @param ch Puntero al caracter.
+ * @return Entero entre 0 y ALFABETO_TAMANIO-1 si el char pertenece al alfabeto. En caso contrario, devuelve -1.
+*/
+static int aux_recuperar_posicion_en_alfabeto(char*ch){
+    return ALFABETO_POSICION(*ch);
 }
 
 /**
- * @brief Operación Dada una posición que corresponde a un nodo del árbol (entre 0 y 25), se recupera el caracter que simboliza dicha posición.
- * @param pos Entero entre 0 y 25.
- * @return Caracter entre 'a' y 'z' (excluyendo a ñ).
+ * @brief Operación Dada una posición que corresponde a un nodo del árbol (entre 0 y ALFABETO_TAMANIO-1), se recupera el caracter que simboliza dicha posición.
+ * @param pos Entero entre 0 y ALFABETO_TAMANIO-1.
+ * @return Caracter del alfabeto.
 */
 static char aux_recuperar_caracter_en_posicion(int pos){
-    char ch = (97 + pos);
-    return ch;
+    return ALFABETO_CARACTER(pos);
 }
 
 /**
@@ -57,16 +157,10 @@ static char aux_recuperar_caracter_en_posicion(int pos){
  * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para el elemento o para su contenido.
  * @return Elemento construido y con memoria reservada.
 */
-static elemento_t aux_construir_elemento(int cant_repeticiones, char* s, int length_s){
-    //Reservacián de memoria
-    elemento_t *elem = (elemento_t*) malloc(sizeof(elemento_t));
-    //Si no se reserva memoria, entonces el programa finaliza indicando el error en cuestion.
-    if (elem==NULL){
-        printf("Error %d: No se pudo reservar memoria para el elemento.\n", ERROR_ELEMENTO_MEMORIA);
-        exit(ERROR_ELEMENTO_MEMORIA);
-    }
+static elemento_t aux_construir_elemento(long long cant_repeticiones, char* s, int length_s){
+    elemento_t elem;
     //Establece el valor a, esto es, la cantidad de repeticiones.
-    elem->a = cant_repeticiones;
+    elem.a = cant_repeticiones;
 
     //Establece el valor b, esto es, la secuencia de caracteres.
     char *secuencia = (char*)malloc(sizeof(char)*(length_s+1));
@@ -82,80 +176,297 @@ static elemento_t aux_construir_elemento(int cant_repeticiones, char* s, int len
     }
     //El ultimo caracter es será el caracter nulo o fin de cadena.
     secuencia[length_s] = '\0';
-    elem->b = secuencia;
+    elem.b = secuencia;
+
+    return elem;
+}
+
+/**
+ * @brief Operación Inicializa la palabra de un recorrido con el prefijo dado.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para la palabra.
+*/
+static void aux_iniciar_recorrido(struct recorrido_trie *R, char *prefijo){
+    unsigned long longitud = strlen(prefijo);
 
-    return *elem;
+    R->capacidad = longitud + 64;
+    R->palabra = (char*) malloc(R->capacidad*sizeof(char));
+    if (R->palabra==NULL){
+        printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_MULTISET_MEMORIA);
+        exit(ERROR_MULTISET_MEMORIA);
+    }
+    memcpy(R->palabra, prefijo, longitud+1);
+}
+
+/**
+ * @brief Operación Fija el caracter de la posición 'longitud' de la palabra del recorrido y la termina tras él,
+ * ampliando el arreglo si es necesario. Los caracteres anteriores se conservan.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo ampliar el arreglo.
+*/
+static void aux_fijar_caracter(struct recorrido_trie *R, unsigned long longitud, char c){
+    if (longitud + 2 > R->capacidad){
+        R->capacidad = 2*R->capacidad;
+        R->palabra = (char*) realloc(R->palabra, R->capacidad*sizeof(char));
+        if (R->palabra==NULL){
+            printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_MULTISET_MEMORIA);
+            exit(ERROR_MULTISET_MEMORIA);
+        }
+    }
+    R->palabra[longitud] = c;
+    R->palabra[longitud+1] = '\0';
 }
 
 /**
  * @brief Operación Dado el árbol T, realiza la carga de los elementos cuya cantidad de repeticiones es mayor o igual a 1 en la lista L.
  * @param L Puntero a la lista.
+ * @param desbordados Tabla de contadores desbordados del multiset.
  * @param T Puntero a la estructura del árbol trie.
- * @param s Arreglo de caracteres de la iteración previa.
- * @param length_s Longitud del arreglo previo.
+ * @param R Puntero al recorrido, cuya palabra es la que representa el nodo T.
+ * @param longitud Longitud de la palabra que representa el nodo T.
  * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para el elemento o para su contenido.
 */
-static void aux_cargar_elementos_en_lista(lista_t *L, struct trie *T, char s[], int length_s){
+static void aux_cargar_elementos_en_lista(lista_t *L, tabla_contadores_t *desbordados, struct trie *T, struct recorrido_trie *R, unsigned long longitud){
     ///Inicializa las variables a utilizar.
     struct trie *T_hijo;
-    char s_nuevo[length_s+1];
-
-    ///Copia lo obtenido en el arreglo s en uno nuevo con una capacidad+1.
-    for (int j=0; j<length_s; j++){
-        s_nuevo[j] = s[j];
-    }
 
     ///Para cada posible hijo del nodo T.
-    for (int i=0; i<26; i++){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
         //Recupero al hijo i del nodo T
         T_hijo = T->siguiente[i];
 
         //Si el hijo i está definido, entonces se procede a recuperar el char de la posicion i.
         if (T_hijo!=NULL){
-            s_nuevo[length_s] = aux_recuperar_caracter_en_posicion(i);
+            aux_fijar_caracter(R, longitud, aux_recuperar_caracter_en_posicion(i));
 
             //Si el nodo hijo tiene una cantidad>0, entonces es una palabra con repeticiones que se debe insertar en la lista.
             if (T_hijo->cantidad > 0){
-                elemento_t elem = aux_construir_elemento(T_hijo->cantidad, s_nuevo, length_s+1);
+                elemento_t elem = aux_construir_elemento(contador_valor(desbordados, &(T_hijo->cantidad)), R->palabra, longitud+1);
                 lista_insertar(L, elem, 0);
             }
 
-            aux_cargar_elementos_en_lista(L, T_hijo, s_nuevo, length_s+1);
+            aux_cargar_elementos_en_lista(L, desbordados, T_hijo, R, longitud+1);
         }
     }
 }
 
 
-multiset_t *multiset_crear(){
+/**
+ * @brief Operación Construye un nodo del árbol trie sin hijos y con cantidad de repeticiones en 0, reutilizando uno de
+ * los nodos libres del multiset si los hay.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE al que pertenece el nodo.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para el nodo.
+ * @return Puntero al nodo construido.
+*/
+static struct trie *aux_crear_nodo(multiset_t *m){
+    struct trie *T = m->libres;
+
+    if (T!=NULL){
+        m->libres = T->siguiente[0];
+        m->cant_libres = m->cant_libres - 1;
+    }
+    else{
+        //Revervo memoria para el nodo.
+        T = (struct trie*)malloc(sizeof(struct trie));
+        //Si no se reservá memoria, entonces el programa finaliza indicando el error.
+        if (T==NULL){
+            printf("Error %d: No se pudo reservar memoria para el multiset.\n", ERROR_MULTISET_MEMORIA);
+            exit(ERROR_MULTISET_MEMORIA);
+        }
+    }
+    T->cantidad = 0;
+    T->id = 0;
+    T->generacion = m->generacion;
+    //Inicializa como NULL las referencia a los posibles caracteres del alfabeto.
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        T->siguiente[i] = NULL;
+    }
+
+    return T;
+}
+
+/**
+ * @brief Operación Copia en 'clave' los caracteres de 's' que pertenecen al alfabeto, descartando el resto.
+ * Permite que las implementaciones alternativas ignoren los mismos caracteres que el trie.
+ * @param s Puntero a la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @param clave Arreglo con capacidad para la longitud de 's' más 1 caracteres.
+*/
+static void aux_filtrar_alfabeto(char *s, char *fin, char *clave){
+    while ((fin==NULL) ? (*s!='\0') : (s<fin)){
+        if (aux_recuperar_posicion_en_alfabeto(s)!=-1){
+            *clave = *s;
+            clave++;
+        }
+        s++;
+    }
+    *clave = '\0';
+}
+
+/**
+ * @brief Operación Filtra la palabra 's' (ver aux_filtrar_alfabeto) en 'local' si entra en él, o en memoria reservada si
+ * no, de modo que la pila no depende de la longitud de la palabra.
+ * @param s Puntero a la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @param local Arreglo con capacidad para LONGITUD_CLAVE_LOCAL+1 caracteres.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para la clave.
+ * @return Puntero a la clave, que se libera con aux_liberar_clave.
+*/
+static char *aux_construir_clave(char *s, char *fin, char *local){
+    unsigned long longitud = (fin==NULL) ? strlen(s) : (unsigned long) (fin-s);
+    char *to_return = local;
+
+    if (longitud>LONGITUD_CLAVE_LOCAL){
+        to_return = (char*) malloc(longitud+1);
+        if (to_return==NULL){
+            printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_MULTISET_MEMORIA);
+            exit(ERROR_MULTISET_MEMORIA);
+        }
+    }
+    aux_filtrar_alfabeto(s, fin, to_return);
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Libera la clave construida con aux_construir_clave, si no está en el arreglo local.
+*/
+static void aux_liberar_clave(char *clave, char *local){
+    if (clave!=local){
+        free(clave);
+    }
+}
+
+multiset_t *multiset_crear_modo(int modo){
     //Revervo memoria para el multiset.
-    multiset_t *M = (struct trie*)malloc(sizeof(struct trie));
+    multiset_t *M = (struct multiset*)malloc(sizeof(struct multiset));
     //Si no se reservá memoria, entonces el programa finaliza indicando el error.
     if (M==NULL){
         printf("Error %d: No se pudo reservar memoria para el multiset.\n", ERROR_MULTISET_MEMORIA);
         exit(ERROR_MULTISET_MEMORIA);
     }
-    M->cantidad = 0;
-    //Inicializa como NULL las referencia a las 26 posibles letras del abecedario.
-    for (int i=0; i<26; i++){
-        M->siguiente[i] = NULL;
+    M->modo = modo;
+    M->raiz = NULL;
+    M->cant_nodos = 0;
+    M->cant_palabras = 0;
+    M->compacto = NULL;
+    M->aproximado = NULL;
+    M->rafaga = NULL;
+    M->desbordados = NULL;
+    M->bloque = NULL;
+    M->cant_bloque = 0;
+    M->generacion = 0;
+    M->instantanea = FALSE;
+    M->versiones = NULL;
+    M->libres = NULL;
+    M->cant_libres = 0;
+
+    if (modo==MULTISET_MODO_COMPACTO){
+        M->compacto = patricia_crear();
+    }
+    else if (modo==MULTISET_MODO_APROXIMADO){
+        M->aproximado = aproximado_crear(error_aproximado, MULTISET_APROXIMADO_PROBABILIDAD_FALLO, capacidad_aproximado);
+    }
+    else if (modo==MULTISET_MODO_RAFAGA){
+        M->rafaga = rafaga_crear();
+    }
+    else{
+        M->raiz = aux_crear_nodo(M);
+        M->cant_nodos = 1;
     }
 
     return M;
 }
 
-void multiset_insertar(multiset_t *m, char *s){
+multiset_t *multiset_crear(){
+    return multiset_crear_modo(MULTISET_MODO_TRIE);
+}
+
+void multiset_configurar_aproximado(double error, int capacidad){
+    error_aproximado = error;
+    capacidad_aproximado = capacidad;
+}
+
+/**
+ * @brief Operación Agrega un nodo retirado al final de la lista dada.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para la lista.
+*/
+static void aux_agregar_retirado(struct lista_retirados *L, struct retirado r){
+    if (L->cantidad==L->capacidad){
+        L->capacidad = (L->capacidad==0) ? 64 : 2*L->capacidad;
+        L->entradas = (struct retirado*) realloc(L->entradas, L->capacidad*sizeof(struct retirado));
+        if (L->entradas==NULL){
+            printf("Error %d: No se pudo reservar memoria para el multiset.\n", ERROR_MULTISET_MEMORIA);
+            exit(ERROR_MULTISET_MEMORIA);
+        }
+    }
+    L->entradas[L->cantidad] = r;
+    L->cantidad = L->cantidad + 1;
+}
+
+/**
+ * @brief Operación Devuelve una copia del nodo 'T', que pertenece a una generación anterior del multiset 'm' y puede
+ * estar compartido con instantáneas, para modificarla en su lugar. El nodo original queda retirado hasta que no haya
+ * instantáneas que lo vean, salvo que pertenezca al bloque contiguo (que se retira entero).
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+ * @param T Puntero al nodo a copiar.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para la copia.
+ * @return Puntero a la copia, de la generación actual.
+*/
+static struct trie *aux_copiar_nodo(multiset_t *m, struct trie *T){
+    struct trie *copia = aux_crear_nodo(m);
+
+    memcpy(copia->siguiente, T->siguiente, sizeof(T->siguiente));
+    copia->id = T->id;
+    copia->cantidad = T->cantidad;
+    //La tabla de contadores se indexa por la dirección del campo: un contador desbordado se traslada a la copia.
+    if (T->cantidad==CONTADOR_DESBORDADO){
+        long long cantidad = contador_valor(m->desbordados, &(T->cantidad));
+        contador_quitar(m->desbordados, &(T->cantidad));
+        copia->cantidad = 0;
+        contador_sumar(&(m->desbordados), &(copia->cantidad), cantidad);
+    }
+
+    if (m->bloque==NULL || T<m->bloque || T>=m->bloque+m->cant_bloque){
+        struct retirado r = {T, NULL, 0, m->generacion-1, FALSE};
+        aux_agregar_retirado(&(m->versiones->pendientes), r);
+    }
+
+    return copia;
+}
+
+/**
+ * @brief Operación Recorre el camino de la palabra 's' desde la raiz del trie, creando los nodos que falten y copiando
+ * los que estén compartidos con instantáneas (ver multiset_instantanea).
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para un nodo.
+ * @return Nodo terminal de la palabra.
+*/
+static struct trie *aux_recorrer_camino(multiset_t *m, char *s, char *fin){
     int pos_en_alfabeto = -1;
-    struct trie *T = (struct trie*) m;
+    struct trie *T = m->raiz;
+    //Solo puede haber nodos compartidos si se tomó alguna instantánea; si no, se evita leer la generación de cada nodo.
+    int compartidos = (m->versiones!=NULL);
+
+    if (compartidos==TRUE && T->generacion!=m->generacion){
+        T = aux_copiar_nodo(m, T);
+        m->raiz = T;
+    }
 
     ///Mientras que no se llegue a fin de cadena, se procede a recorrer/crear la secuencia de chars.
-    while (*s!='\0'){
+    while ((fin==NULL) ? (*s!='\0') : (s<fin)){
         //Se recupera la posicion del char en cuestián.
         pos_en_alfabeto = aux_recuperar_posicion_en_alfabeto(s);
         //Si es un char válido, esto es, la posicion está entre 0 y 25 inclusive.
         if (pos_en_alfabeto!=-1){
             //Si el nodo siguiente en la posicion dada no existe, entonces se crea.
             if (T->siguiente[pos_en_alfabeto]==NULL){
-                T->siguiente[pos_en_alfabeto] = (struct trie*) multiset_crear();
+                T->siguiente[pos_en_alfabeto] = aux_crear_nodo(m);
+                m->cant_nodos = m->cant_nodos + 1;
+            }
+            //Si el nodo siguiente es de una generación anterior, se copia: 'T' ya es de la generación actual.
+            else if (compartidos==TRUE && T->siguiente[pos_en_alfabeto]->generacion!=m->generacion){
+                T->siguiente[pos_en_alfabeto] = aux_copiar_nodo(m, T->siguiente[pos_en_alfabeto]);
             }
             //Recupero el nodo trie en cuestián
             T = T->siguiente[pos_en_alfabeto];
@@ -164,19 +475,105 @@ void multiset_insertar(multiset_t *m, char *s){
         s++;
     }
 
-    //Al finalizar el recorrido, se está en el ultimo nodo, por lo que se debe incrementar el contador de palabra en 1.
-    T->cantidad = T->cantidad + 1;
+    return T;
+}
+
+/**
+ * @brief Operación Inserta 'cantidad' repeticiones de la palabra 's' en el trie de ALFABETO_TAMANIO hijos por nodo del multiset 'm'.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @param cantidad Entero positivo con la cantidad de repeticiones a sumar.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para un nodo.
+ * @return Identificador de la palabra.
+*/
+static unsigned int aux_insertar_en_trie(multiset_t *m, char *s, char *fin, long long cantidad){
+    struct trie *T = aux_recorrer_camino(m, s, fin);
+
+    //Si la palabra no tenía repeticiones, recibe el próximo identificador.
+    if (T->cantidad==0){
+        T->id = m->cant_palabras;
+        m->cant_palabras = m->cant_palabras + 1;
+    }
+    //Al finalizar el recorrido, se está en el ultimo nodo, por lo que se debe incrementar el contador de palabra.
+    contador_sumar(&(m->desbordados), &(T->cantidad), cantidad);
+
+    return T->id;
+}
+
+/**
+ * @brief Operación Inserta 'cantidad' repeticiones de la palabra 's' en la implementación del multiset 'm'.
+ * Solo el trie recorre la palabra en el lugar; las demás implementaciones reciben una copia filtrada que
+ * termina en '\0'.
+ * @param m Puntero al multiset.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @param cantidad Entero positivo con la cantidad de repeticiones a sumar.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria.
+*/
+static void aux_insertar(multiset_t *m, char *s, char *fin, long long cantidad){
+    char local[LONGITUD_CLAVE_LOCAL+1];
+
+    if (m->modo==MULTISET_MODO_COMPACTO){
+        char *clave = aux_construir_clave(s, fin, local);
+        patricia_insertar(m->compacto, clave, cantidad);
+        aux_liberar_clave(clave, local);
+    }
+    else if (m->modo==MULTISET_MODO_APROXIMADO){
+        char *clave = aux_construir_clave(s, fin, local);
+        aproximado_insertar(m->aproximado, clave, cantidad);
+        aux_liberar_clave(clave, local);
+    }
+    else if (m->modo==MULTISET_MODO_RAFAGA){
+        char *clave = aux_construir_clave(s, fin, local);
+        rafaga_insertar(m->rafaga, clave, cantidad);
+        aux_liberar_clave(clave, local);
+    }
+    else{
+        aux_insertar_en_trie(m, s, fin, cantidad);
+    }
+}
+
+void multiset_insertar_cantidad(multiset_t *m, char *s, long long cantidad){
+    aux_insertar(m, s, NULL, cantidad);
+}
+
+void multiset_insertar(multiset_t *m, char *s){
+    aux_insertar(m, s, NULL, 1);
+}
+
+void multiset_insertar_longitud(multiset_t *m, char *s, unsigned long longitud){
+    aux_insertar(m, s, s+longitud, 1);
+}
+
+long multiset_insertar_id(multiset_t *m, char *s){
+    long to_return = -1;
+
+    if (m->modo==MULTISET_MODO_TRIE){
+        to_return = aux_insertar_en_trie(m, s, NULL, 1);
+    }
+    else{
+        multiset_insertar(m, s);
+    }
+
+    return to_return;
 }
 
-int multiset_cantidad(multiset_t *m, char s[]){
+/**
+ * @brief Operación Busca el nodo terminal de la palabra 's' en el trie de ALFABETO_TAMANIO hijos por nodo del multiset 'm'.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @return Nodo terminal de la palabra, o NULL si su camino no existe en el trie.
+*/
+static struct trie *aux_buscar_en_trie(multiset_t *m, char s[], char *fin){
     ///Inicializar variables
-    int cant_repeticiones = 0;
     int existe_palabra = TRUE;
     int pos_en_alfabeto = -1;
-    struct trie *T = (struct trie*) m;
+    struct trie *T = m->raiz;
 
     ///Mientras exista la palabra en el trie y exista char que leer aun.
-    while((existe_palabra==TRUE) && ((*s)!='\0')){
+    while((existe_palabra==TRUE) && ((fin==NULL) ? ((*s)!='\0') : (s<fin))){
         //Se recupera la posicion del char en cuestion.
         pos_en_alfabeto = aux_recuperar_posicion_en_alfabeto(s);
 
@@ -196,67 +593,1129 @@ int multiset_cantidad(multiset_t *m, char s[]){
         }
     }
 
-    if (existe_palabra==TRUE){
-        cant_repeticiones = T->cantidad;
+    return T;
+}
+
+/**
+ * @brief Operación Devuelve la cantidad de repeticiones de la palabra 's' en el trie de ALFABETO_TAMANIO hijos por nodo del multiset 'm'.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @return Entero mayor o igual a 0.
+*/
+static long long aux_cantidad_en_trie(multiset_t *m, char s[], char *fin){
+    long long cant_repeticiones = 0;
+    struct trie *T = aux_buscar_en_trie(m, s, fin);
+
+    if (T!=NULL){
+        cant_repeticiones = contador_valor(m->desbordados, &(T->cantidad));
     }
 
     return cant_repeticiones;
 }
 
-lista_t multiset_elementos(multiset_t *m, int (*f)(elemento_t, elemento_t)){
+long multiset_buscar_id(multiset_t *m, char *s){
+    long to_return = -1;
+
+    if (m->modo==MULTISET_MODO_TRIE){
+        struct trie *T = aux_buscar_en_trie(m, s, NULL);
+        if (T!=NULL && T->cantidad!=0){
+            to_return = T->id;
+        }
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Devuelve la cantidad de repeticiones de la palabra 's' en la implementación del multiset 'm'.
+ * @param m Puntero al multiset.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param fin Puntero al caracter siguiente al último de 's', o NULL si 's' termina en '\0'.
+ * @return Entero mayor o igual a 0.
+*/
+static long long aux_cantidad(multiset_t *m, char *s, char *fin){
+    char local[LONGITUD_CLAVE_LOCAL+1];
+    long long to_return;
+
+    if (m->modo==MULTISET_MODO_COMPACTO){
+        char *clave = aux_construir_clave(s, fin, local);
+        to_return = patricia_cantidad(m->compacto, clave);
+        aux_liberar_clave(clave, local);
+    }
+    else if (m->modo==MULTISET_MODO_APROXIMADO){
+        char *clave = aux_construir_clave(s, fin, local);
+        to_return = aproximado_cantidad(m->aproximado, clave);
+        aux_liberar_clave(clave, local);
+    }
+    else if (m->modo==MULTISET_MODO_RAFAGA){
+        char *clave = aux_construir_clave(s, fin, local);
+        to_return = rafaga_cantidad(m->rafaga, clave);
+        aux_liberar_clave(clave, local);
+    }
+    else{
+        to_return = aux_cantidad_en_trie(m, s, fin);
+    }
+
+    return to_return;
+}
+
+long long multiset_cantidad(multiset_t *m, char s[]){
+    return aux_cantidad(m, s, NULL);
+}
+
+long long multiset_cantidad_longitud(multiset_t *m, char *s, unsigned long longitud){
+    return aux_cantidad(m, s, s+longitud);
+}
+
+/**
+ * @brief Operación Función de visita que inserta una copia de la palabra y su cantidad al inicio de la lista recibida como contexto.
+ * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para el elemento o para su contenido.
+*/
+static void aux_visitar_insercion_en_lista(char *palabra, long long cantidad, void *contexto){
+    lista_insertar((lista_t*) contexto, aux_construir_elemento(cantidad, palabra, strlen(palabra)), 0);
+}
+
+lista_t multiset_elementos(multiset_t *m, funcion_comparacion_t f){
     //Se crea la lista de elementos y se almacena su puntero.
     lista_t *L = (lista_t*) lista_crear();
-    //Parsing de multiset a trie para poder utilizarlo en la función a continuación.
-    struct trie *T = (struct trie*) m;
-    //Elemento del nodo raiz es una cadena vacía.
-    char s[1] = {'\0'};
-    //Se procede a cargar la lista de manera semi-recursiva.
-    aux_cargar_elementos_en_lista(L, T, s, 0);
 
-    return *L;
+    if (m->modo!=MULTISET_MODO_TRIE){
+        //Se conserva el mismo orden que en el trie: cada palabra se inserta al inicio de la lista.
+        multiset_recorrer(m, aux_visitar_insercion_en_lista, L);
+    }
+    else{
+        //Recupera la raiz del trie para poder utilizarlo en la función a continuación.
+        struct trie *T = m->raiz;
+        //Elemento del nodo raiz es una cadena vacía.
+        struct recorrido_trie R;
+        aux_iniciar_recorrido(&R, "");
+        //Se procede a cargar la lista de manera semi-recursiva.
+        aux_cargar_elementos_en_lista(L, m->desbordados, T, &R, 0);
+        free(R.palabra);
+    }
+    //Si se recibió un criterio, se ordena la lista según él.
+    if (f!=NULL){
+        lista_ordenar(L, f);
+    }
+
+    //Se devuelve una copia de la lista, por lo que se libera la estructura reservada.
+    lista_t to_return = *L;
+    free(L);
+
+    return to_return;
 }
 
 /**
- * @brief Realiza la liberación de la memoria, esto es, remueve todo dato perteneciente al nodo de la memoria.
- * @param nodo Puntero a un nodo del árbol.
+ * @brief Operación Dado el nodo T, recorre en orden lexicográfico sus descendientes e invoca a 'visitar' con cada palabra que tenga repeticiones.
+ * @param desbordados Tabla de contadores desbordados del multiset.
+ * @param T Puntero a un nodo del árbol.
+ * @param R Puntero al recorrido, cuya palabra es la que representa el nodo T.
+ * @param longitud Longitud de la palabra que representa el nodo T.
+ * @param visitar Función a invocar por cada palabra.
+ * @param contexto Puntero a datos del invocador.
 */
-static void aux_liberar_memoria(struct trie *nodo){
-    nodo->cantidad = 0;
-    for (int i=0; i<26; i++){
-        nodo->siguiente[i] = NULL;
-        free(nodo->siguiente[i]);
+static void aux_recorrer(tabla_contadores_t *desbordados, struct trie *T, struct recorrido_trie *R, unsigned long longitud, funcion_visita_t visitar, void *contexto){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        struct trie *T_hijo = T->siguiente[i];
+        if (T_hijo!=NULL){
+            aux_fijar_caracter(R, longitud, aux_recuperar_caracter_en_posicion(i));
+
+            //El prefijo se visita antes que sus extensiones, respetando el orden de strcmp.
+            if (T_hijo->cantidad > 0){
+                visitar(R->palabra, contador_valor(desbordados, &(T_hijo->cantidad)), contexto);
+            }
+            aux_recorrer(desbordados, T_hijo, R, longitud+1, visitar, contexto);
+        }
     }
-    free(nodo);
-    nodo = NULL;
 }
 
 /**
- * @brief Elimina los nodos del árbol de manera recursiva.
- * @param nodo Puntero a un nodo del árbol.
+ * @brief Operación Dado el nodo T, recorre en orden lexicográfico sus descendientes e invoca a 'visitar' con cada palabra
+ * que tenga repeticiones junto a su identificador. Sigue el mismo esquema que aux_recorrer.
+*/
+static void aux_recorrer_ids(tabla_contadores_t *desbordados, struct trie *T, struct recorrido_trie *R, unsigned long longitud, funcion_visita_id_t visitar, void *contexto){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        struct trie *T_hijo = T->siguiente[i];
+        if (T_hijo!=NULL){
+            aux_fijar_caracter(R, longitud, aux_recuperar_caracter_en_posicion(i));
+            if (T_hijo->cantidad > 0){
+                visitar(R->palabra, contador_valor(desbordados, &(T_hijo->cantidad)), T_hijo->id, contexto);
+            }
+            aux_recorrer_ids(desbordados, T_hijo, R, longitud+1, visitar, contexto);
+        }
+    }
+}
+
+void multiset_recorrer_ids(multiset_t *m, funcion_visita_id_t visitar, void *contexto){
+    if (m->modo==MULTISET_MODO_TRIE){
+        struct recorrido_trie R;
+        aux_iniciar_recorrido(&R, "");
+        aux_recorrer_ids(m->desbordados, m->raiz, &R, 0, visitar, contexto);
+        free(R.palabra);
+    }
+}
+
+int multiset_modo(multiset_t *m){
+    return m->modo;
+}
+
+unsigned int multiset_cantidad_palabras(multiset_t *m){
+    return m->cant_palabras;
+}
+
+void multiset_recorrer(multiset_t *m, funcion_visita_t visitar, void *contexto){
+    if (m->modo==MULTISET_MODO_COMPACTO){
+        patricia_recorrer(m->compacto, visitar, contexto);
+    }
+    else if (m->modo==MULTISET_MODO_APROXIMADO){
+        aproximado_recorrer_prefijo(m->aproximado, "", visitar, contexto);
+    }
+    else if (m->modo==MULTISET_MODO_RAFAGA){
+        rafaga_recorrer(m->rafaga, visitar, contexto);
+    }
+    else{
+        struct recorrido_trie R;
+        aux_iniciar_recorrido(&R, "");
+        aux_recorrer(m->desbordados, m->raiz, &R, 0, visitar, contexto);
+        free(R.palabra);
+    }
+}
+
+/**
+ * @struct recopilacion
+ * @brief Modela el arreglo de elementos que se recopila al recorrer el multiset en orden lexicográfico.
+*/
+struct recopilacion {
+    elemento_t *elementos; ///Arreglo de elementos recopilados.
+    int cantidad; ///Cantidad de elementos recopilados.
+    int capacidad; ///Capacidad del arreglo.
+    long long maxima_cantidad; ///Mayor cantidad de repeticiones entre los elementos recopilados.
+};
+
+/**
+ * @brief Función de visita que agrega una copia de la palabra y su cantidad al final de la recopilación.
+ * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para el elemento o el arreglo.
+*/
+static void aux_visitar_recopilacion(char *palabra, long long cantidad, void *contexto){
+    struct recopilacion *R = (struct recopilacion*) contexto;
+
+    if (R->cantidad==R->capacidad){
+        R->capacidad = (R->capacidad==0) ? 64 : 2*R->capacidad;
+        R->elementos = (elemento_t*) realloc(R->elementos, R->capacidad*sizeof(elemento_t));
+        if (R->elementos==NULL){
+            printf("Error %d: No se pudo reservar memoria para el elemento.\n", ERROR_ELEMENTO_MEMORIA);
+            exit(ERROR_ELEMENTO_MEMORIA);
+        }
+    }
+    R->elementos[R->cantidad] = aux_construir_elemento(cantidad, palabra, strlen(palabra));
+    R->cantidad = R->cantidad + 1;
+    if (cantidad>R->maxima_cantidad){
+        R->maxima_cantidad = cantidad;
+    }
+}
+
+/**
+ * @struct diferencia
+ * @brief Modela el estado de la comparación de dos multisets.
+*/
+struct diferencia {
+    multiset_t *anterior; //Multiset de referencia.
+    multiset_t *actual; //Multiset comparado con el de referencia.
+    funcion_diferencia_t *visitar; //Función que recibe cada palabra que difiere.
+    void *contexto; //Datos del invocador.
+};
+
+/**
+ * @brief Operación Función de visita que informa como agregada una palabra que solo está en el multiset actual.
+*/
+static void aux_visitar_agregada(char *palabra, long long cantidad, void *contexto){
+    struct diferencia *D = (struct diferencia*) contexto;
+    D->visitar(palabra, 0, cantidad, D->contexto);
+}
+
+/**
+ * @brief Operación Función de visita que informa como removida una palabra que solo está en el multiset anterior.
+*/
+static void aux_visitar_removida(char *palabra, long long cantidad, void *contexto){
+    struct diferencia *D = (struct diferencia*) contexto;
+    D->visitar(palabra, cantidad, 0, D->contexto);
+}
+
+/**
+ * @brief Operación Compara las palabras de dos multisets de cualquier modo recopilando las de cada uno, que los
+ * recorridos entregan en orden lexicográfico, y mezclándolas a la par, de modo que las diferencias se informan en el
+ * mismo orden que en el trie. Una palabra que solo aparece en un recorrido se busca en el otro multiset, ya que en
+ * MULTISET_MODO_APROXIMADO su cantidad puede ser una estimación aunque no se recorra.
+ * @param D Puntero al estado de la comparación.
+ * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para las recopilaciones.
 */
-static void aux_multiset_eliminar(struct trie *nodo){
-    //Si el puntero al nodo del arbol no es nulo, entonces.
-    if (nodo!=NULL){
-        //Un nodo puede llegar a tener, como mucho, 26 hijos (por cada letra del alfabeto, excluyendo la ñ).
-        for (int i=0; i<26; i++){
-            //Si el nodo i no es nulo, se sigue con el recorrido.
-            if (nodo!=NULL){
-                if (nodo->siguiente[i]!=NULL){
-                //Sigo con el recorrido del árbol
-                aux_multiset_eliminar(nodo->siguiente[i]);
-
-                //Finalizado el recorrido, se procede a eliminar el nodo y su contenido.
-                aux_liberar_memoria(nodo->siguiente[i]);
+static void aux_diferencia_recopilada(struct diferencia *D){
+    struct recopilacion A = {NULL, 0, 0, 0};
+    struct recopilacion B = {NULL, 0, 0, 0};
+    int i = 0;
+    int j = 0;
+
+    multiset_recorrer(D->anterior, aux_visitar_recopilacion, &A);
+    multiset_recorrer(D->actual, aux_visitar_recopilacion, &B);
+    while (i<A.cantidad || j<B.cantidad){
+        int orden = (i==A.cantidad) ? 1 : ((j==B.cantidad) ? -1 : strcmp(A.elementos[i].b, B.elementos[j].b));
+
+        if (orden<0){
+            long long cantidad_actual = multiset_cantidad(D->actual, A.elementos[i].b);
+            if (cantidad_actual!=A.elementos[i].a){
+                D->visitar(A.elementos[i].b, A.elementos[i].a, cantidad_actual, D->contexto);
+            }
+            i++;
+        }
+        else if (orden>0){
+            if (multiset_cantidad(D->anterior, B.elementos[j].b)==0){
+                D->visitar(B.elementos[j].b, 0, B.elementos[j].a, D->contexto);
             }
+            j++;
+        }
+        else{
+            if (A.elementos[i].a!=B.elementos[j].a){
+                D->visitar(A.elementos[i].b, A.elementos[i].a, B.elementos[j].a, D->contexto);
             }
+            i++;
+            j++;
         }
+    }
 
+    for (i=0; i<A.cantidad; i++){
+        free(A.elementos[i].b);
+    }
+    for (j=0; j<B.cantidad; j++){
+        free(B.elementos[j].b);
     }
+    free(A.elementos);
+    free(B.elementos);
 }
 
-void multiset_eliminar(multiset_t **m){
-    //Realiza la eliminación del multiset de manera recursiva, partiendo de la raiz del árbol trie.
-    aux_multiset_eliminar(*m);
+/**
+ * @brief Operación Recorre a la par los descendientes de los nodos A (del multiset anterior) y B (del actual), que
+ * representan la misma palabra, e informa en orden lexicográfico las palabras que difieren. Sigue el esquema de aux_recorrer.
+ * @param D Puntero al estado de la comparación.
+ * @param A Puntero a un nodo del multiset anterior.
+ * @param B Puntero al nodo del multiset actual que representa la misma palabra que A.
+ * @param R Puntero al recorrido, cuya palabra es la que representan A y B.
+ * @param longitud Longitud de la palabra.
+*/
+static void aux_diferencia(struct diferencia *D, struct trie *A, struct trie *B, struct recorrido_trie *R, unsigned long longitud){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        struct trie *A_hijo = A->siguiente[i];
+        struct trie *B_hijo = B->siguiente[i];
+        //Si ninguno de los dos tiene el hijo, no hay palabras que comparar.
+        if (A_hijo!=NULL || B_hijo!=NULL){
+            aux_fijar_caracter(R, longitud, aux_recuperar_caracter_en_posicion(i));
+            if (A_hijo==NULL){
+                //Todo el subárbol es nuevo: sus palabras se informan sin buscarlas en el multiset anterior.
+                if (B_hijo->cantidad > 0){
+                    aux_visitar_agregada(R->palabra, contador_valor(D->actual->desbordados, &(B_hijo->cantidad)), D);
+                }
+                aux_recorrer(D->actual->desbordados, B_hijo, R, longitud+1, aux_visitar_agregada, D);
+            }
+            else if (B_hijo==NULL){
+                if (A_hijo->cantidad > 0){
+                    aux_visitar_removida(R->palabra, contador_valor(D->anterior->desbordados, &(A_hijo->cantidad)), D);
+                }
+                aux_recorrer(D->anterior->desbordados, A_hijo, R, longitud+1, aux_visitar_removida, D);
+            }
+            else{
+                long long cantidad_anterior = (A_hijo->cantidad > 0) ? contador_valor(D->anterior->desbordados, &(A_hijo->cantidad)) : 0;
+                long long cantidad_actual = (B_hijo->cantidad > 0) ? contador_valor(D->actual->desbordados, &(B_hijo->cantidad)) : 0;
+                if (cantidad_anterior!=cantidad_actual){
+                    D->visitar(R->palabra, cantidad_anterior, cantidad_actual, D->contexto);
+                }
+                aux_diferencia(D, A_hijo, B_hijo, R, longitud+1);
+            }
+        }
+    }
+}
+
+void multiset_diferencia(multiset_t *anterior, multiset_t *actual, funcion_diferencia_t visitar, void *contexto){
+    struct diferencia D = {anterior, actual, visitar, contexto};
+
+    if (anterior->modo==MULTISET_MODO_TRIE && actual->modo==MULTISET_MODO_TRIE){
+        struct recorrido_trie R;
+        aux_iniciar_recorrido(&R, "");
+        aux_diferencia(&D, anterior->raiz, actual->raiz, &R, 0);
+        free(R.palabra);
+    }
+    else{
+        aux_diferencia_recopilada(&D);
+    }
+}
+
+void multiset_recorrer_prefijo(multiset_t *m, char *prefijo, funcion_visita_t visitar, void *contexto){
+    char local[LONGITUD_CLAVE_LOCAL+1];
+    char *clave = aux_construir_clave(prefijo, NULL, local);
+
+    if (m->modo==MULTISET_MODO_COMPACTO){
+        patricia_recorrer_prefijo(m->compacto, clave, visitar, contexto);
+    }
+    else if (m->modo==MULTISET_MODO_APROXIMADO){
+        aproximado_recorrer_prefijo(m->aproximado, clave, visitar, contexto);
+    }
+    else if (m->modo==MULTISET_MODO_RAFAGA){
+        rafaga_recorrer_prefijo(m->rafaga, clave, visitar, contexto);
+    }
+    else{
+        struct trie *T = m->raiz;
+        int longitud = 0;
+
+        //Se desciende por el camino del prefijo.
+        while (T!=NULL && clave[longitud]!='\0'){
+            T = T->siguiente[aux_recuperar_posicion_en_alfabeto(&clave[longitud])];
+            longitud++;
+        }
+        //Si el camino existe, se visita el propio prefijo y luego sus extensiones.
+        if (T!=NULL){
+            struct recorrido_trie R;
+            if (longitud>0 && T->cantidad>0){
+                visitar(clave, contador_valor(m->desbordados, &(T->cantidad)), contexto);
+            }
+            aux_iniciar_recorrido(&R, clave);
+            aux_recorrer(m->desbordados, T, &R, longitud, visitar, contexto);
+            free(R.palabra);
+        }
+    }
+    aux_liberar_clave(clave, local);
+}
+
+/**
+ * @brief Ordena los elementos por cantidad de repeticiones mediante radix sort LSD (un byte por pasada).
+ * Cada pasada es un conteo estable, por lo que a igual cantidad se conserva el orden previo de los elementos.
+ * Solo se realizan las pasadas necesarias para representar la mayor cantidad.
+ * @param R Puntero a la recopilación a ordenar.
+ * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para el arreglo auxiliar.
+*/
+static void aux_ordenar_por_cantidad(struct recopilacion *R){
+    elemento_t *auxiliar = (elemento_t*) malloc(R->cantidad*sizeof(elemento_t) + 1);
+    if (auxiliar==NULL){
+        printf("Error %d: No se pudo reservar memoria para el elemento.\n", ERROR_ELEMENTO_MEMORIA);
+        exit(ERROR_ELEMENTO_MEMORIA);
+    }
+
+    for (int desplazamiento=0; (desplazamiento<64) && ((R->maxima_cantidad>>desplazamiento)>0); desplazamiento=desplazamiento+8){
+        int posiciones[257] = {0};
+
+        //Cuenta cuantos elementos hay con cada valor del byte y calcula la posición inicial de cada uno.
+        for (int i=0; i<R->cantidad; i++){
+            posiciones[((R->elementos[i].a>>desplazamiento) & 0xFF) + 1]++;
+        }
+        for (int b=0; b<256; b++){
+            posiciones[b+1] = posiciones[b+1] + posiciones[b];
+        }
+        //Distribuye los elementos respetando el orden en que se encontraban.
+        for (int i=0; i<R->cantidad; i++){
+            auxiliar[posiciones[(R->elementos[i].a>>desplazamiento) & 0xFF]++] = R->elementos[i];
+        }
+
+        elemento_t *intercambio = R->elementos;
+        R->elementos = auxiliar;
+        auxiliar = intercambio;
+    }
+
+    free(auxiliar);
+}
+
+elemento_t *multiset_arreglo_por_frecuencia(multiset_t *m, char *prefijo, int *cantidad){
+    struct recopilacion R = {NULL, 0, 0, 0};
+
+    //El recorrido del trie es lexicográfico, y el ordenamiento por cantidad es estable, por lo que no se comparan cadenas.
+    multiset_recorrer_prefijo(m, prefijo, aux_visitar_recopilacion, &R);
+    aux_ordenar_por_cantidad(&R);
+    *cantidad = R.cantidad;
+
+    return R.elementos;
+}
+
+lista_t multiset_elementos_por_frecuencia(multiset_t *m){
+    int cantidad;
+    elemento_t *elementos = multiset_arreglo_por_frecuencia(m, "", &cantidad);
+    lista_t to_return = {NULL, NULL, 0};
+
+    //Cada elemento se inserta al final de la lista, en tiempo constante.
+    for (int i=0; i<cantidad; i++){
+        lista_insertar(&to_return, elementos[i], i);
+    }
+    free(elementos);
+
+    return to_return;
+}
+
+unsigned long multiset_memoria(multiset_t *m){
+    unsigned long to_return = sizeof(struct multiset);
+
+    if (m->modo==MULTISET_MODO_COMPACTO){
+        to_return = to_return + patricia_memoria(m->compacto);
+    }
+    else if (m->modo==MULTISET_MODO_APROXIMADO){
+        to_return = to_return + aproximado_memoria(m->aproximado);
+    }
+    else if (m->modo==MULTISET_MODO_RAFAGA){
+        to_return = to_return + rafaga_memoria(m->rafaga);
+    }
+    else{
+        to_return = to_return + (m->cant_nodos + m->cant_libres) * sizeof(struct trie) + contador_memoria(m->desbordados);
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Libera el nodo dado, salvo que pertenezca al bloque contiguo del multiset 'm' (que se libera entero).
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+ * @param nodo Puntero a un nodo del árbol.
+*/
+static void aux_liberar_nodo(multiset_t *m, struct trie *nodo){
+    if (m->bloque==NULL || nodo<m->bloque || nodo>=m->bloque+m->cant_bloque){
+        free(nodo);
+    }
+}
+
+/**
+ * @brief Elimina los nodos descendientes del nodo dado de manera recursiva (recorrido en postorden), dejando al nodo sin hijos.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE al que pertenece el nodo.
+ * @param nodo Puntero a un nodo del árbol.
+*/
+static void aux_multiset_eliminar(multiset_t *m, struct trie *nodo){
+    //Un nodo puede llegar a tener, como mucho, ALFABETO_TAMANIO hijos (uno por cada caracter del alfabeto).
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        //Si el hijo i no es nulo, primero se eliminan sus descendientes y luego el hijo en si mismo.
+        if (nodo->siguiente[i]!=NULL){
+            aux_multiset_eliminar(m, nodo->siguiente[i]);
+            aux_liberar_nodo(m, nodo->siguiente[i]);
+            nodo->siguiente[i] = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Operación Devuelve los nodos descendientes del nodo dado a la lista de nodos libres del multiset, dejando al
+ * nodo sin hijos. Ningún nodo pertenece al bloque contiguo ni está compartido con instantáneas.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE al que pertenece el nodo.
+ * @param nodo Puntero a un nodo del árbol.
+*/
+static void aux_reciclar_hijos(multiset_t *m, struct trie *nodo){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        struct trie *hijo = nodo->siguiente[i];
+        if (hijo!=NULL){
+            aux_reciclar_hijos(m, hijo);
+            hijo->siguiente[0] = m->libres;
+            m->libres = hijo;
+            m->cant_libres = m->cant_libres + 1;
+            nodo->siguiente[i] = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Operación Libera los nodos de la lista de nodos libres del multiset.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE.
+*/
+static void aux_liberar_libres(multiset_t *m){
+    while (m->libres!=NULL){
+        struct trie *T = m->libres;
+        m->libres = T->siguiente[0];
+        free(T);
+    }
+    m->cant_libres = 0;
+}
+
+/**
+ * @brief Operación Avanza desde el nodo 'T' al hijo de la posición dada, creándolo si no existe. Si es el primer nodo
+ * creado para la palabra en curso, registra de qué nodo y posición cuelga para poder deshacer el camino.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE, sin instantáneas.
+ * @param T Puntero al nodo actual.
+ * @param pos Posición del hijo, entre 0 y ALFABETO_TAMANIO-1.
+ * @param padre_creado Puntero al nodo del que cuelga el primer nodo creado (NULL si todavía no se creó ninguno).
+ * @param pos_creado Puntero a la posición del primer nodo creado en su padre.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para el nodo.
+ * @return Puntero al hijo.
+*/
+static struct trie *aux_avanzar_camino(multiset_t *m, struct trie *T, int pos, struct trie **padre_creado, int *pos_creado){
+    if (T->siguiente[pos]==NULL){
+        if (*padre_creado==NULL){
+            *padre_creado = T;
+            *pos_creado = pos;
+        }
+        T->siguiente[pos] = aux_crear_nodo(m);
+        m->cant_nodos = m->cant_nodos + 1;
+    }
+
+    return T->siguiente[pos];
+}
+
+/**
+ * @brief Operación Deshace los nodos creados para una palabra que resultó inválida, devolviéndolos a la lista de nodos
+ * libres. Los nodos creados forman una cadena sin repeticiones que cuelga de 'padre' en la posición dada.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE, sin instantáneas.
+ * @param padre Puntero al nodo del que cuelga el primer nodo creado, o NULL si no se creó ninguno.
+ * @param pos Posición del primer nodo creado en 'padre'.
+*/
+static void aux_deshacer_camino(multiset_t *m, struct trie *padre, int pos){
+    if (padre!=NULL){
+        struct trie *T = padre->siguiente[pos];
+        unsigned long libres = m->cant_libres;
+
+        padre->siguiente[pos] = NULL;
+        aux_reciclar_hijos(m, T);
+        T->siguiente[0] = m->libres;
+        m->libres = T;
+        m->cant_libres = m->cant_libres + 1;
+        m->cant_nodos = m->cant_nodos - (m->cant_libres - libres);
+    }
+}
+
+//----INSTANTANEAS----
+
+/**
+ * @brief Operación Toma el candado del registro de versiones.
+*/
+static void aux_bloquear_versiones(struct versiones *V){
+#ifndef _WIN32
+    pthread_mutex_lock(&(V->candado));
+#endif
+}
+
+/**
+ * @brief Operación Libera el candado del registro de versiones.
+*/
+static void aux_desbloquear_versiones(struct versiones *V){
+#ifndef _WIN32
+    pthread_mutex_unlock(&(V->candado));
+#endif
+}
+
+/**
+ * @brief Operación Construye un registro de versiones vacío, de un multiset vivo.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para el registro.
+*/
+static struct versiones *aux_crear_versiones(){
+    struct versiones *V = (struct versiones*) malloc(sizeof(struct versiones));
+    if (V==NULL){
+        printf("Error %d: No se pudo reservar memoria para el multiset.\n", ERROR_MULTISET_MEMORIA);
+        exit(ERROR_MULTISET_MEMORIA);
+    }
+#ifndef _WIN32
+    pthread_mutex_init(&(V->candado), NULL);
+#endif
+    V->leidas = NULL;
+    V->cant_leidas = 0;
+    V->capacidad_leidas = 0;
+    V->retirados.entradas = NULL;
+    V->retirados.cantidad = 0;
+    V->retirados.capacidad = 0;
+    V->pendientes = V->retirados;
+    V->vivo = TRUE;
+
+    return V;
+}
+
+/**
+ * @brief Operación Elimina el registro de versiones, que ya no tiene nodos retirados. Luego de la invocación '*V' es NULL.
+*/
+static void aux_eliminar_versiones(struct versiones **V){
+#ifndef _WIN32
+    pthread_mutex_destroy(&((*V)->candado));
+#endif
+    free((*V)->leidas);
+    free((*V)->retirados.entradas);
+    free((*V)->pendientes.entradas);
+    free(*V);
+    *V = NULL;
+}
+
+/**
+ * @brief Operación Registra una instantánea viva de la versión dada. Requiere el candado del registro.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para el registro.
+*/
+static void aux_registrar_lector(struct versiones *V, unsigned int version){
+    unsigned int i = V->cant_leidas;
+
+    //Las instantáneas nuevas del multiset muestran la mayor versión, por lo que se busca desde la última.
+    while (i>0 && V->leidas[i-1].version>version){
+        i--;
+    }
+    if (i>0 && V->leidas[i-1].version==version){
+        V->leidas[i-1].lectores = V->leidas[i-1].lectores + 1;
+    }
+    else{
+        if (V->cant_leidas==V->capacidad_leidas){
+            V->capacidad_leidas = (V->capacidad_leidas==0) ? 8 : 2*V->capacidad_leidas;
+            V->leidas = (struct version_leida*) realloc(V->leidas, V->capacidad_leidas*sizeof(struct version_leida));
+            if (V->leidas==NULL){
+                printf("Error %d: No se pudo reservar memoria para el multiset.\n", ERROR_MULTISET_MEMORIA);
+                exit(ERROR_MULTISET_MEMORIA);
+            }
+        }
+        memmove(&(V->leidas[i+1]), &(V->leidas[i]), (V->cant_leidas-i)*sizeof(struct version_leida));
+        V->leidas[i].version = version;
+        V->leidas[i].lectores = 1;
+        V->cant_leidas = V->cant_leidas + 1;
+    }
+}
+
+/**
+ * @brief Operación Quita del registro una instantánea viva de la versión dada. Requiere el candado del registro.
+*/
+static void aux_soltar_lector(struct versiones *V, unsigned int version){
+    unsigned int i = 0;
+
+    while (V->leidas[i].version!=version){
+        i++;
+    }
+    V->leidas[i].lectores = V->leidas[i].lectores - 1;
+    if (V->leidas[i].lectores==0){
+        memmove(&(V->leidas[i]), &(V->leidas[i+1]), (V->cant_leidas-i-1)*sizeof(struct version_leida));
+        V->cant_leidas = V->cant_leidas - 1;
+    }
+}
+
+/**
+ * @brief Operación Libera el árbol a partir del nodo 'T', salvo los nodos que pertenecen al bloque dado (que se libera entero).
+*/
+static void aux_liberar_arbol(struct trie *T, struct trie *bloque, unsigned long cant_bloque){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        if (T->siguiente[i]!=NULL){
+            aux_liberar_arbol(T->siguiente[i], bloque, cant_bloque);
+        }
+    }
+    if (bloque==NULL || T<bloque || T>=bloque+cant_bloque){
+        free(T);
+    }
+}
+
+/**
+ * @brief Operación Libera los nodos retirados que ya no puede ver ninguna instantánea viva, esto es, aquellos cuya
+ * versión 'hasta' es menor que la menor versión registrada. Requiere el candado del registro.
+*/
+static void aux_reclamar(struct versiones *V){
+    unsigned long liberados = 0;
+
+    while (liberados<V->retirados.cantidad && (V->cant_leidas==0 || V->retirados.entradas[liberados].hasta<V->leidas[0].version)){
+        struct retirado *r = &(V->retirados.entradas[liberados]);
+        if (r->arbol==TRUE){
+            aux_liberar_arbol(r->nodo, r->bloque, r->cant_bloque);
+            free(r->bloque);
+        }
+        else{
+            free(r->nodo);
+        }
+        liberados++;
+    }
+    if (liberados>0){
+        memmove(V->retirados.entradas, &(V->retirados.entradas[liberados]), (V->retirados.cantidad-liberados)*sizeof(struct retirado));
+        V->retirados.cantidad = V->retirados.cantidad - liberados;
+    }
+}
+
+/**
+ * @brief Operación Pasa los nodos que retiró el hilo que inserta a la lista de retirados. Requiere el candado del registro.
+*/
+static void aux_trasladar_pendientes(struct versiones *V){
+    for (unsigned long i=0; i<V->pendientes.cantidad; i++){
+        aux_agregar_retirado(&(V->retirados), V->pendientes.entradas[i]);
+    }
+    V->pendientes.cantidad = 0;
+}
+
+/**
+ * @brief Operación Retira el trie completo del multiset 'm', que tiene instantáneas, junto a su bloque contiguo, para que
+ * se libere cuando ya no quede ninguna instantánea que pueda verlo. El invocador debe reemplazar la raiz y el bloque.
+ * @param m Puntero al multiset en MULTISET_MODO_TRIE (no una instantánea).
+ * @param vivo FALSE si el multiset se elimina, en cuyo caso el registro se libera si no quedan instantáneas vivas.
+*/
+static void aux_retirar_trie(multiset_t *m, int vivo){
+    struct versiones *V = m->versiones;
+    struct retirado r = {m->raiz, m->bloque, m->cant_bloque, m->generacion-1, TRUE};
+    int liberar;
+
+    aux_bloquear_versiones(V);
+    aux_trasladar_pendientes(V);
+    aux_agregar_retirado(&(V->retirados), r);
+    V->vivo = vivo;
+    aux_reclamar(V);
+    liberar = (V->vivo==FALSE && V->cant_leidas==0);
+    aux_desbloquear_versiones(V);
+
+    if (liberar==TRUE){
+        aux_eliminar_versiones(&(m->versiones));
+    }
+}
+
+multiset_t *multiset_instantanea(multiset_t *m){
+    multiset_t *to_return = NULL;
+
+    if (m->modo==MULTISET_MODO_TRIE){
+        unsigned int version = m->generacion;
+
+        if (m->instantanea==FALSE){
+            if (m->versiones==NULL){
+                m->versiones = aux_crear_versiones();
+            }
+        }
+
+        aux_bloquear_versiones(m->versiones);
+        aux_registrar_lector(m->versiones, version);
+        if (m->instantanea==FALSE){
+            //Los nodos actuales quedan compartidos con la instantánea, por lo que las inserciones siguientes los copian.
+            m->generacion = m->generacion + 1;
+            aux_trasladar_pendientes(m->versiones);
+            aux_reclamar(m->versiones);
+        }
+        aux_desbloquear_versiones(m->versiones);
+
+        to_return = (struct multiset*) malloc(sizeof(struct multiset));
+        if (to_return==NULL){
+            printf("Error %d: No se pudo reservar memoria para el multiset.\n", ERROR_MULTISET_MEMORIA);
+            exit(ERROR_MULTISET_MEMORIA);
+        }
+        to_return->modo = MULTISET_MODO_TRIE;
+        to_return->raiz = m->raiz;
+        to_return->cant_nodos = m->cant_nodos;
+        to_return->cant_palabras = m->cant_palabras;
+        to_return->compacto = NULL;
+        to_return->aproximado = NULL;
+        to_return->rafaga = NULL;
+        //Los contadores desbordados de los nodos compartidos pueden seguir creciendo en el multiset: se copian.
+        to_return->desbordados = contador_copiar_tabla(m->desbordados);
+        to_return->bloque = NULL;
+        to_return->cant_bloque = 0;
+        to_return->generacion = version;
+        to_return->instantanea = TRUE;
+        to_return->versiones = m->versiones;
+        to_return->libres = NULL;
+        to_return->cant_libres = 0;
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Elimina la instantánea 'm', liberando los nodos retirados que solo ella podía ver y, si el multiset
+ * del que se tomó ya fue eliminado y no quedan otras instantáneas, el registro de versiones.
+*/
+static void aux_eliminar_instantanea(multiset_t *m){
+    struct versiones *V = m->versiones;
+    int liberar;
+
+    aux_bloquear_versiones(V);
+    aux_soltar_lector(V, m->generacion);
+    aux_reclamar(V);
+    liberar = (V->vivo==FALSE && V->cant_leidas==0);
+    aux_desbloquear_versiones(V);
+
+    if (liberar==TRUE){
+        aux_eliminar_versiones(&V);
+    }
+    contador_eliminar_tabla(&(m->desbordados));
+}
+
+/**
+ * @struct reubicacion
+ * @brief Modela el estado de la copia de los nodos de un trie a un bloque contiguo.
+ * Durante la copia, el campo 'generacion' de cada nodo original almacena su posición en preorden, que indexa los
+ * arreglos 'nodos' y 'destinos' (posición en el bloque). Se usa dicho campo, y no 'id', porque las instantáneas que
+ * comparten los nodos originales pueden leer sus identificadores durante la copia.
+*/
+struct reubicacion {
+    struct trie **nodos;
+    unsigned int *destinos;
+    struct peso_nodo *pesos;
+    unsigned long cant_numerados; //Cantidad de nodos ya numerados en preorden.
+};
+
+/**
+ * @struct peso_nodo
+ * @brief Modela el peso de un nodo, esto es, la suma de las repeticiones de las palabras de su subárbol.
+*/
+struct peso_nodo {
+    long long peso;
+    unsigned int posicion; //Posición del nodo en preorden.
+};
+
+/**
+ * @brief Operación Numera en preorden los nodos del subárbol 'T', guardando su identificador y calculando el peso de cada subárbol.
+ * @return Peso del subárbol 'T'.
+*/
+static long long aux_numerar_y_pesar(struct reubicacion *R, tabla_contadores_t *desbordados, struct trie *T){
+    unsigned int posicion = (unsigned int) R->cant_numerados;
+    long long peso = contador_valor(desbordados, &(T->cantidad));
+
+    R->cant_numerados = R->cant_numerados + 1;
+    R->nodos[posicion] = T;
+    T->generacion = posicion;
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        if (T->siguiente[i]!=NULL){
+            peso = peso + aux_numerar_y_pesar(R, desbordados, T->siguiente[i]);
+        }
+    }
+    R->pesos[posicion].peso = peso;
+    R->pesos[posicion].posicion = posicion;
+
+    return peso;
+}
+
+/**
+ * @brief Operación Compara dos pesos de nodos de forma decreciente; a igual peso, conserva el preorden.
+*/
+static int aux_comparar_pesos(const void *a, const void *b){
+    const struct peso_nodo *x = (const struct peso_nodo*) a;
+    const struct peso_nodo *y = (const struct peso_nodo*) b;
+    int to_return;
+
+    if (x->peso!=y->peso){
+        to_return = (x->peso > y->peso) ? -1 : 1;
+    }
+    else{
+        to_return = (x->posicion < y->posicion) ? -1 : 1;
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Operación Reserva el bloque contiguo de 'n' nodos de multiset_compactar. Si las páginas grandes están
+ * habilitadas y el bloque ocupa al menos una, se alinea a su tamaño y se solicita al núcleo que lo respalde con ellas,
+ * de modo que los recorridos del trie requieran menos entradas de la TLB.
+ * @return Puntero al bloque, que se libera con free, o NULL si no se pudo reservar.
+*/
+static struct trie *aux_reservar_bloque(unsigned long n){
+    struct trie *to_return = NULL;
+    unsigned long bytes = n * sizeof(struct trie);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (paginas_grandes==TRUE && bytes>=TAMANIO_PAGINA_GRANDE){
+        void *bloque = NULL;
+        bytes = (bytes + TAMANIO_PAGINA_GRANDE - 1) / TAMANIO_PAGINA_GRANDE * TAMANIO_PAGINA_GRANDE;
+        if (posix_memalign(&bloque, TAMANIO_PAGINA_GRANDE, bytes)==0){
+            //Si el núcleo no admite páginas grandes, el bloque se usa igualmente con páginas normales.
+            madvise(bloque, bytes, MADV_HUGEPAGE);
+            to_return = (struct trie*) bloque;
+        }
+    }
+#endif
+    if (to_return==NULL){
+        to_return = (struct trie*) malloc(bytes);
+    }
+
+    return to_return;
+}
+
+void multiset_configurar_paginas_grandes(int habilitadas){
+    paginas_grandes = habilitadas;
+}
+
+int multiset_region_compacta(multiset_t *m, void **inicio, unsigned long *bytes){
+    int to_return = FALSE;
+
+    *inicio = m->bloque;
+    *bytes = m->cant_bloque * sizeof(struct trie);
+    if (m->bloque!=NULL){
+        to_return = TRUE;
+    }
+
+    return to_return;
+}
+
+void multiset_compactar(multiset_t *m){
+    if (m->modo==MULTISET_MODO_TRIE){
+        unsigned long n = m->cant_nodos;
+        struct trie *bloque = aux_reservar_bloque(n);
+        tabla_contadores_t *nuevos_desbordados = NULL;
+        struct reubicacion R;
+        R.nodos = (struct trie**) malloc(n * sizeof(struct trie*));
+        R.destinos = (unsigned int*) malloc(n * sizeof(unsigned int));
+        R.pesos = (struct peso_nodo*) malloc(n * sizeof(struct peso_nodo));
+        R.cant_numerados = 0;
+        if (bloque==NULL || R.nodos==NULL || R.destinos==NULL || R.pesos==NULL){
+            printf("Error %d: No se pudo reservar memoria para compactar el multiset.\n", ERROR_MULTISET_MEMORIA);
+            exit(ERROR_MULTISET_MEMORIA);
+        }
+
+        //Los nodos se ubican por peso decreciente: como un nodo pesa al menos lo que sus hijos, la raiz queda primera
+        //y los nodos de los caminos más recorridos quedan juntos al inicio del bloque.
+        aux_numerar_y_pesar(&R, m->desbordados, m->raiz);
+        qsort(R.pesos, n, sizeof(struct peso_nodo), aux_comparar_pesos);
+        for (unsigned long i=0; i<n; i++){
+            R.destinos[R.pesos[i].posicion] = (unsigned int) i;
+        }
+
+        for (unsigned long i=0; i<n; i++){
+            struct trie *T = R.nodos[R.pesos[i].posicion];
+            struct trie *copia = &(bloque[i]);
+            long long cantidad = contador_valor(m->desbordados, &(T->cantidad));
+
+            //El contador se vuelve a sumar para que, si está desbordado, la tabla se indexe por la dirección de la copia.
+            copia->cantidad = 0;
+            if (cantidad>0){
+                contador_sumar(&nuevos_desbordados, &(copia->cantidad), cantidad);
+            }
+            copia->id = T->id;
+            copia->generacion = m->generacion;
+            for (int j=0; j<ALFABETO_TAMANIO; j++){
+                copia->siguiente[j] = (T->siguiente[j]==NULL) ? NULL : &(bloque[R.destinos[T->siguiente[j]->generacion]]);
+            }
+        }
+
+        //Se liberan los nodos originales (incluido el bloque de una compactación anterior) y sus contadores o, si
+        //pueden estar compartidos con instantáneas, se retiran hasta que se eliminen.
+        if (m->versiones!=NULL){
+            aux_retirar_trie(m, TRUE);
+        }
+        else{
+            aux_multiset_eliminar(m, m->raiz);
+            aux_liberar_nodo(m, m->raiz);
+            free(m->bloque);
+        }
+        contador_eliminar_tabla(&(m->desbordados));
+        free(R.nodos);
+        free(R.destinos);
+        free(R.pesos);
+
+        m->bloque = bloque;
+        m->cant_bloque = n;
+        m->raiz = &(bloque[0]);
+        m->desbordados = nuevos_desbordados;
+    }
+}
+
+void multiset_vaciar(multiset_t *m){
+    if (m->modo==MULTISET_MODO_COMPACTO){
+        patricia_vaciar(m->compacto);
+    }
+    else if (m->modo==MULTISET_MODO_APROXIMADO){
+        aproximado_vaciar(m->aproximado);
+    }
+    else if (m->modo==MULTISET_MODO_RAFAGA){
+        rafaga_vaciar(m->rafaga);
+    }
+    else{
+        //Si los nodos pueden estar compartidos con instantáneas, se retiran y el trie continúa desde una raiz nueva.
+        if (m->versiones!=NULL){
+            aux_retirar_trie(m, TRUE);
+            m->bloque = NULL;
+            m->cant_bloque = 0;
+            m->raiz = aux_crear_nodo(m);
+        }
+        else{
+            aux_multiset_eliminar(m, m->raiz);
+            //La raiz del bloque contiguo no puede liberarse por separado: se reemplaza por un nodo nuevo.
+            if (m->bloque!=NULL){
+                free(m->bloque);
+                m->bloque = NULL;
+                m->cant_bloque = 0;
+                m->raiz = aux_crear_nodo(m);
+            }
+        }
+        aux_liberar_libres(m);
+        m->raiz->cantidad = 0;
+        m->cant_nodos = 1;
+        m->cant_palabras = 0;
+        contador_eliminar_tabla(&(m->desbordados));
+    }
+}
+
+void multiset_reiniciar(multiset_t *m){
+    //Los nodos del bloque contiguo o compartidos con instantáneas no pueden reutilizarse uno a uno.
+    if (m->modo!=MULTISET_MODO_TRIE || m->versiones!=NULL || m->bloque!=NULL){
+        multiset_vaciar(m);
+    }
+    else{
+        aux_reciclar_hijos(m, m->raiz);
+        m->raiz->cantidad = 0;
+        m->cant_nodos = 1;
+        m->cant_palabras = 0;
+        contador_eliminar_tabla(&(m->desbordados));
+    }
+}
+
+long multiset_insertar_texto(multiset_t *m, const char *texto, unsigned long n){
+    const alfabeto_plegado_t *P = alfabeto_plegado();
+    long to_return = -1;
+
+    if (m->modo==MULTISET_MODO_TRIE && m->versiones==NULL){
+        struct trie *T = m->raiz;
+        struct trie *padre_creado = NULL;
+        int pos_creado = 0;
+        int valida = TRUE;
+
+        to_return = 0;
+        //El final del texto se trata como un separador, de modo que la última palabra se cierre en el mismo recorrido.
+        for (unsigned long i=0; i<=n; i++){
+            int clase = (i==n) ? ALFABETO_CLASE_SEPARADOR : P->clases[(unsigned char) texto[i]];
+
+            if (clase>=0){
+                if (valida==TRUE){
+                    T = aux_avanzar_camino(m, T, clase, &padre_creado, &pos_creado);
+                }
+            }
+            else if (clase==ALFABETO_CLASE_SEPARADOR){
+                //Toda palabra no vacía termina en un nodo distinto de la raiz.
+                if (valida==TRUE && T!=m->raiz){
+                    if (T->cantidad==0){
+                        T->id = m->cant_palabras;
+                        m->cant_palabras = m->cant_palabras + 1;
+                    }
+                    contador_sumar(&(m->desbordados), &(T->cantidad), 1);
+                    to_return = to_return + 1;
+                }
+                T = m->raiz;
+                padre_creado = NULL;
+                valida = TRUE;
+            }
+            else{
+                unsigned char siguiente = (i+1<n) ? (unsigned char) texto[i+1] : 0;
+                if (clase==ALFABETO_CLASE_LATINO && (siguiente & 0xC0)==0x80 && P->latinos[siguiente - 0x80][0]!='\0'){
+                    for (const char *c=P->latinos[siguiente - 0x80]; *c!='\0' && valida==TRUE; c++){
+                        T = aux_avanzar_camino(m, T, ALFABETO_POSICION(*c), &padre_creado, &pos_creado);
+                    }
+                    i++;
+                }
+                else if (valida==TRUE){
+                    //La palabra es inválida: se quitan los nodos que se crearon para ella y se ignora hasta el separador.
+                    aux_deshacer_camino(m, padre_creado, pos_creado);
+                    padre_creado = NULL;
+                    valida = FALSE;
+                }
+            }
+        }
+    }
+
+    return to_return;
+}
+
+void multiset_eliminar(multiset_t **m){
+    if ((*m)->modo==MULTISET_MODO_COMPACTO){
+        patricia_eliminar(&((*m)->compacto));
+    }
+    else if ((*m)->modo==MULTISET_MODO_APROXIMADO){
+        aproximado_eliminar(&((*m)->aproximado));
+    }
+    else if ((*m)->modo==MULTISET_MODO_RAFAGA){
+        rafaga_eliminar(&((*m)->rafaga));
+    }
+    else if ((*m)->instantanea==TRUE){
+        aux_eliminar_instantanea(*m);
+    }
+    else{
+        //Si los nodos pueden estar compartidos con instantáneas, se retiran hasta que se elimine la última de ellas.
+        if ((*m)->versiones!=NULL){
+            aux_retirar_trie(*m, FALSE);
+        }
+        else{
+            //Realiza la eliminación del multiset de manera recursiva, partiendo de la raiz del árbol trie.
+            aux_multiset_eliminar(*m, (*m)->raiz);
+            aux_liberar_nodo(*m, (*m)->raiz);
+            free((*m)->bloque);
+        }
+        aux_liberar_libres(*m);
+        contador_eliminar_tabla(&((*m)->desbordados));
+    }
     //Libera el espacio reservado para el multiset y setea la referencia como NULL
     free(*m);
     *m = NULL;
@@ -13,13 +13,44 @@
 #define ERROR_MULTISET_MEMORIA -4
 #define ERROR_ELEMENTO_MEMORIA -7
 
+//Constantes para representar las implementaciones disponibles del multiset.
+#define MULTISET_MODO_TRIE 0 ///Trie de un hijo por caracter del alfabeto en cada nodo (ver alfabeto.h), un nodo por caracter.
+#define MULTISET_MODO_COMPACTO 1 ///Trie con compresión de caminos (árbol Patricia).
+#define MULTISET_MODO_APROXIMADO 2 ///Conteo aproximado con memoria acotada (Count-Min Sketch y Space-Saving, ver aproximado.h).
+#define MULTISET_MODO_RAFAGA 3 ///Trie de ráfagas: nodos en los primeros niveles y cubetas de sufijos en las hojas (ver rafaga.h).
+
+//Parámetros por defecto de MULTISET_MODO_APROXIMADO (ver multiset_configurar_aproximado).
+#define MULTISET_APROXIMADO_ERROR 0.0001
+#define MULTISET_APROXIMADO_PROBABILIDAD_FALLO 0.01
+#define MULTISET_APROXIMADO_CAPACIDAD 10000
+
 
 /**
-* @struct trie
-* @brief Representa un árbol Trie, donde cada nodo representa un caracter distinto.
+* @struct multiset
+* @brief Representa un multiset implementado sobre un árbol Trie, donde cada nodo representa un caracter distinto.
 */
-struct trie;
-typedef struct trie multiset_t;
+struct multiset;
+typedef struct multiset multiset_t;
+
+/**
+ * @typedef void(funcion_visita_t)
+ * @brief Plantilla de función que recibe cada palabra del multiset junto a su cantidad de repeticiones.
+ * La cadena 'palabra' solo es válida durante la invocación, por lo que debe copiarse si se desea conservarla.
+*/
+typedef void (funcion_visita_t)(char *palabra, long long cantidad, void *contexto);
+
+/**
+ * @typedef void(funcion_visita_id_t)
+ * @brief Plantilla de función que recibe cada palabra del multiset junto a su cantidad de repeticiones y su identificador.
+*/
+typedef void (funcion_visita_id_t)(char *palabra, long long cantidad, unsigned int id, void *contexto);
+
+/**
+ * @typedef void(funcion_diferencia_t)
+ * @brief Plantilla de función que recibe cada palabra cuya cantidad de repeticiones difiere entre dos multisets, junto a
+ * su cantidad en cada uno (0 si no pertenece a él).
+*/
+typedef void (funcion_diferencia_t)(char *palabra, long long cantidad_anterior, long long cantidad_actual, void *contexto);
 
 
 /**
@@ -29,6 +60,24 @@ typedef struct trie multiset_t;
 */
 extern multiset_t *multiset_crear();
 
+/**
+ * @brief Crea un multiset vacio de palabras con la implementación indicada y lo devuelve.
+ * Todas las operaciones del multiset conservan su semántica con independencia de la implementación elegida.
+ * @param modo MULTISET_MODO_TRIE, MULTISET_MODO_COMPACTO, MULTISET_MODO_APROXIMADO o MULTISET_MODO_RAFAGA.
+ * @throw ERROR_MULTISET_MEMORIA si el programa no logra reservar memoria para el multiset.
+ * @return Puntero al multiset construido.
+*/
+extern multiset_t *multiset_crear_modo(int modo);
+
+/**
+ * @brief Establece los parámetros con los que se crean los siguientes multisets en MULTISET_MODO_APROXIMADO.
+ * En dicho modo, multiset_cantidad devuelve una cota superior de la cantidad real (ver aproximado.h) y los recorridos
+ * y listas de elementos solo incluyen las 'capacidad' palabras más repetidas.
+ * @param error Error máximo de una cantidad, como fracción del total de palabras insertadas (entre 0 y 1).
+ * @param capacidad Cantidad de palabras más repetidas que conserva cada multiset.
+*/
+extern void multiset_configurar_aproximado(double error, int capacidad);
+
 /**
  * @brief Inserta la palabra 's' al multiset 'm'.
  * Si la reservación de memoria no se realiza correctamente, puede finalizar la ejecución del programa con ERROR_MULTISET_MEMORIA.
@@ -39,24 +88,233 @@ extern multiset_t *multiset_crear();
 */
 extern void multiset_insertar(multiset_t *m, char *s);
 
+/**
+ * @brief Inserta 'cantidad' repeticiones de la palabra 's' al multiset 'm', con el mismo criterio que multiset_insertar.
+ * @param m Puntero al multiset.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @param cantidad Entero positivo con la cantidad de repeticiones a sumar.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria.
+*/
+extern void multiset_insertar_cantidad(multiset_t *m, char *s, long long cantidad);
+
+/**
+ * @brief Inserta la palabra formada por los 'longitud' caracteres desde 's', con el mismo criterio que multiset_insertar.
+ * La palabra no necesita terminar en '\0', por lo que puede ser un tramo de un texto en memoria; en MULTISET_MODO_TRIE
+ * se recorre en el lugar, sin copiarla.
+ * @param m Puntero al multiset.
+ * @param s Puntero al primer caracter de la palabra.
+ * @param longitud Cantidad de caracteres de la palabra.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria.
+*/
+extern void multiset_insertar_longitud(multiset_t *m, char *s, unsigned long longitud);
+
+/**
+ * @brief Separa el texto dado en palabras e inserta cada una, en una sola pasada: cada byte se clasifica con la tabla
+ * de clases del plegado establecido (ver alfabeto.h) y el camino de la palabra se recorre o crea en el trie a medida
+ * que se lee, sin copiarla. Si la palabra resulta inválida, se quitan los nodos creados para ella. Las palabras se
+ * separan y pliegan con el mismo criterio que lector_procesar_contenido. El texto no se modifica ni necesita terminar
+ * en '\0'. Solo está disponible en MULTISET_MODO_TRIE sin instantáneas.
+ * @param m Puntero al multiset.
+ * @param texto Puntero a los caracteres del texto.
+ * @param n Cantidad de caracteres del texto.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria.
+ * @return Cantidad de palabras insertadas, o -1 si el multiset no admite la inserción en una pasada (el texto no se procesa).
+*/
+extern long multiset_insertar_texto(multiset_t *m, const char *texto, unsigned long n);
+
+/**
+ * @brief Inserta la palabra 's' al multiset 'm' y devuelve su identificador.
+ * En MULTISET_MODO_TRIE cada palabra recibe, en su primera inserción, el menor identificador aún no asignado
+ * (0, 1, 2, ...), que se almacena en el nodo terminal de la palabra. En los demás modos la palabra se inserta sin identificador.
+ * @param m Puntero al multiset.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria.
+ * @return Identificador de la palabra, o -1 si el modo del multiset no asigna identificadores.
+*/
+extern long multiset_insertar_id(multiset_t *m, char *s);
+
+/**
+ * @brief Devuelve el identificador que recibió la palabra 's' al insertarse (ver multiset_insertar_id), sin insertarla.
+ * @param m Puntero al multiset.
+ * @param s Puntero al inicio de la cadena de caracteres.
+ * @return Identificador de la palabra, o -1 si no está en el multiset o su modo no asigna identificadores.
+*/
+extern long multiset_buscar_id(multiset_t *m, char *s);
+
+/**
+ * @brief Devuelve la cantidad de palabras distintas con identificador del multiset 'm' (solo en MULTISET_MODO_TRIE).
+ * Los identificadores asignados son los enteros entre 0 y dicha cantidad menos 1.
+ * @param m Puntero al multiset.
+ * @return Entero mayor o igual a 0.
+*/
+extern unsigned int multiset_cantidad_palabras(multiset_t *m);
+
+/**
+ * @brief Devuelve la implementación del multiset.
+ * @param m Puntero al multiset.
+ * @return MULTISET_MODO_TRIE, MULTISET_MODO_COMPACTO, MULTISET_MODO_APROXIMADO o MULTISET_MODO_RAFAGA.
+*/
+extern int multiset_modo(multiset_t *m);
+
 /**
  * @brief Devuelve la cantidad de repeticiones de la palabra 's' en el multiset m.
  * @param m Puntero al multiset.
  * @param s Puntero al inicio de la cadena de caracteres.
  * @return Entero positivo mayor a 0 si se hay repticiones de s, en cambio, si no está definida o la misma no tiene repeticiones devuelve 0.
 */
-extern int multiset_cantidad(multiset_t *m, char *s);
+extern long long multiset_cantidad(multiset_t *m, char *s);
+
+/**
+ * @brief Devuelve la cantidad de repeticiones de la palabra formada por los 'longitud' caracteres desde 's', con el
+ * mismo criterio que multiset_cantidad. La palabra no necesita terminar en '\0'.
+ * @param m Puntero al multiset.
+ * @param s Puntero al primer caracter de la palabra.
+ * @param longitud Cantidad de caracteres de la palabra.
+ * @return Entero mayor o igual a 0.
+*/
+extern long long multiset_cantidad_longitud(multiset_t *m, char *s, unsigned long longitud);
 
 /**
  * @brief Devuelve una lista de tipo lista_t ordenada segun la funcion 'f' con todos los elementos del multiset 'm' y la cantidad de apariciones de cada uno.
+ * Si 'f' es NULL, las palabras quedan en orden lexicográfico inverso, sin comparar elementos.
  * @param m Puntero al multiset.
- * @param f Función de comparación de elementos.
+ * @param f Función de comparación de elementos (ver lista_ordenar), o NULL.
  * @return Lista de elementos ordenados con las palabras y su respectiva cantidad de repeticiones.
 */
-extern lista_t multiset_elementos(multiset_t *m, int (*f)(elemento_t, elemento_t));
+extern lista_t multiset_elementos(multiset_t *m, funcion_comparacion_t f);
+
+/**
+ * @brief Devuelve una lista con todos los elementos del multiset 'm' ordenada de menor a mayor cantidad de repeticiones y,
+ * a igual cantidad, en orden lexicográfico. Aprovecha el orden del trie, por lo que no compara cadenas y su costo es lineal.
+ * @param m Puntero al multiset.
+ * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para los elementos.
+ * @return Lista de elementos ordenados con las palabras y su respectiva cantidad de repeticiones.
+*/
+extern lista_t multiset_elementos_por_frecuencia(multiset_t *m);
+
+/**
+ * @brief Devuelve un arreglo con los elementos del multiset 'm' cuyas palabras comienzan con 'prefijo', en el mismo orden
+ * que multiset_elementos_por_frecuencia. No modifica el multiset, por lo que varios hilos pueden construir a la vez los
+ * arreglos de prefijos distintos.
+ * @param m Puntero al multiset.
+ * @param prefijo Puntero a la cadena de caracteres del prefijo (vacía para todas las palabras).
+ * @param cantidad Puntero donde se almacena la cantidad de elementos del arreglo.
+ * @throw ERROR_ELEMENTO_MEMORIA si no se pudo reservar memoria para los elementos.
+ * @return Arreglo de elementos, o NULL si no hay ninguno. Tanto el arreglo como la palabra de cada elemento se liberan con free.
+*/
+extern elemento_t *multiset_arreglo_por_frecuencia(multiset_t *m, char *prefijo, int *cantidad);
+
+/**
+ * @brief Recorre las palabras del multiset 'm' en orden lexicográfico e invoca a 'visitar' con cada una de ellas.
+ * @param m Puntero al multiset.
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'visitar'.
+*/
+extern void multiset_recorrer(multiset_t *m, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Recorre las palabras del multiset 'm' en orden lexicográfico e invoca a 'visitar' con cada una de ellas y su
+ * identificador (solo en MULTISET_MODO_TRIE; en los demás modos no realiza ninguna visita).
+ * @param m Puntero al multiset.
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones, su identificador y el contexto dado.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'visitar'.
+*/
+extern void multiset_recorrer_ids(multiset_t *m, funcion_visita_id_t visitar, void *contexto);
+
+/**
+ * @brief Recorre en orden lexicográfico solo las palabras del multiset 'm' que comienzan con 'prefijo'.
+ * Los caracteres del prefijo fuera del alfabeto se ignoran, al igual que en multiset_insertar.
+ * @param m Puntero al multiset.
+ * @param prefijo Puntero a la cadena de caracteres del prefijo.
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'visitar'.
+*/
+extern void multiset_recorrer_prefijo(multiset_t *m, char *prefijo, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Compara los multisets 'anterior' y 'actual' e invoca a 'visitar' con cada palabra agregada, removida o cuya
+ * cantidad de repeticiones cambió. Si ambos están en MULTISET_MODO_TRIE, los árboles se recorren a la par, en orden
+ * lexicográfico, y los subárboles que solo están en uno de ellos se informan sin buscar sus palabras en el otro.
+ * En los demás modos, las palabras de ambos multisets se recopilan y se mezclan a la par, por lo que también se
+ * informan en orden lexicográfico, a costa de copiarlas en memoria.
+ * @param anterior Puntero al multiset de referencia.
+ * @param actual Puntero al multiset a comparar con el de referencia.
+ * @param visitar Función que recibe cada palabra que difiere, su cantidad en cada multiset y el contexto dado.
+ * @param contexto Puntero a datos del invocador que se pasan sin modificar a 'visitar'.
+*/
+extern void multiset_diferencia(multiset_t *anterior, multiset_t *actual, funcion_diferencia_t visitar, void *contexto);
+
+/**
+ * @brief Devuelve la cantidad de bytes de memoria reservados por los nodos del multiset 'm' (incluyendo los contadores desbordados).
+ * @param m Puntero al multiset.
+ * @return Entero positivo con la cantidad de bytes en uso.
+*/
+extern unsigned long multiset_memoria(multiset_t *m);
+
+/**
+ * @brief Copia los nodos del multiset 'm' a un único bloque contiguo de memoria, ordenados por la cantidad de repeticiones
+ * de su subárbol, de modo que los caminos de las palabras frecuentes compartan líneas de cache y páginas.
+ * El bloque se reserva y escribe en el hilo invocador, por lo que en Linux sus páginas se ubican en el nodo NUMA de dicho
+ * hilo; con multiset_configurar_paginas_grandes, los bloques grandes se respaldan con páginas grandes.
+ * Conviene invocarla una vez construido el multiset y antes de consultarlo repetidas veces; el multiset admite
+ * inserciones posteriores, cuyos nodos nuevos se reservan por separado. Solo tiene efecto en MULTISET_MODO_TRIE.
+ * @param m Puntero al multiset.
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para el bloque.
+*/
+extern void multiset_compactar(multiset_t *m);
+
+/**
+ * @brief Establece si multiset_compactar solicita páginas grandes (transparent huge pages) para los bloques que ocupan
+ * al menos una, lo que reduce los fallos de TLB al recorrer tries grandes. Por defecto está deshabilitado.
+ * Solo tiene efecto en Linux; si el núcleo no las admite, los bloques se respaldan con páginas normales.
+ * @param habilitadas TRUE o FALSE.
+*/
+extern void multiset_configurar_paginas_grandes(int habilitadas);
+
+/**
+ * @brief Devuelve la región de memoria del bloque contiguo construido por multiset_compactar, por ejemplo para consultar
+ * en qué nodo NUMA residen sus páginas (ver topologia.h).
+ * @param m Puntero al multiset.
+ * @param inicio Puntero donde se almacena el inicio del bloque, o NULL si no hay.
+ * @param bytes Puntero donde se almacena el tamaño del bloque.
+ * @return TRUE si el multiset tiene un bloque contiguo, FALSE en caso contrario.
+*/
+extern int multiset_region_compacta(multiset_t *m, void **inicio, unsigned long *bytes);
+
+/**
+ * @brief Devuelve una instantánea del multiset 'm': una vista de solo lectura de sus palabras en el momento de la
+ * invocación, que se construye en tiempo constante (solo se copian los contadores desbordados, ver contador.h) y que
+ * no cambia aunque 'm' siga recibiendo inserciones. La instantánea comparte los nodos del trie con 'm'; a partir de
+ * ella, cada inserción en 'm' copia los nodos del camino de la palabra que aún estén compartidos (copia de caminos), y
+ * los nodos reemplazados se liberan cuando ya no queda ninguna instantánea que pueda verlos.
+ * La instantánea admite las operaciones de consulta, recorrido y exportación del multiset, y se libera con
+ * multiset_eliminar; no debe recibir inserciones, ni compactarse o vaciarse. Puede consultarse desde otro hilo mientras
+ * 'm' recibe inserciones, pero las instantáneas de 'm' deben tomarse en el hilo que inserta (o excluyéndolo), mientras
+ * que las de una instantánea pueden tomarse desde cualquier hilo. Solo está disponible en MULTISET_MODO_TRIE.
+ * @param m Puntero al multiset, o a una instantánea (en cuyo caso se devuelve otra vista de las mismas palabras).
+ * @throw ERROR_MULTISET_MEMORIA si no se pudo reservar memoria para la instantánea.
+ * @return Puntero a la instantánea, o NULL si el multiset no está en MULTISET_MODO_TRIE.
+*/
+extern multiset_t *multiset_instantanea(multiset_t *m);
+
+/**
+ * @brief Remueve todas las palabras del multiset 'm' liberando sus nodos. El multiset queda vacío y puede seguir utilizándose.
+ * @param m Puntero al multiset.
+*/
+extern void multiset_vaciar(multiset_t *m);
+
+/**
+ * @brief Remueve todas las palabras del multiset 'm' conservando sus nodos para las inserciones siguientes, de modo que
+ * un multiset reutilizado para muchos archivos no vuelve a reservar memoria por cada uno. Los nodos conservados se
+ * liberan con multiset_vaciar o multiset_eliminar. En un multiset compactado, con instantáneas o que no está en
+ * MULTISET_MODO_TRIE equivale a multiset_vaciar.
+ * @param m Puntero al multiset.
+*/
+extern void multiset_reiniciar(multiset_t *m);
 
 /**
  * @brief Elimina el multiset 'm' liberando el espacio de memoria reservado. Luego de la invocacion 'm' debe NULL.
+ * Los nodos que comparte con instantáneas aún no eliminadas se liberan al eliminar la última de ellas.
  * @param m Puntero al multiset.
 */
 extern void multiset_eliminar(multiset_t **m);
@@ -0,0 +1,237 @@
+/**
+* @file ngrama.c
+* @brief Implementación del TDA Ngrama.
+* Al exportar, cada identificador se traduce a su posición en el orden lexicográfico del multiset, de modo que el
+* orden de las secuencias se resuelve comparando enteros.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "ngrama.h"
+
+/**
+ * @struct entrada_ngrama
+ * @brief Modela una secuencia de la tabla. Una entrada con cantidad 0 está libre.
+*/
+struct entrada_ngrama {
+    unsigned int ids[NGRAMA_MAXIMO];
+    long long cantidad;
+};
+
+/**
+ * @struct tabla_ngramas
+ * @brief Modela la tabla de secuencias junto a la ventana de las últimas palabras leidas.
+*/
+struct tabla_ngramas {
+    int n; //Longitud de las secuencias.
+    struct entrada_ngrama *entradas;
+    unsigned long capacidad; //Potencia de 2.
+    unsigned long cantidad; //Cantidad de entradas ocupadas.
+    unsigned int ventana[NGRAMA_MAXIMO]; //Identificadores de las últimas palabras leidas, la más reciente al final.
+    int cant_ventana; //Cantidad de palabras en la ventana.
+};
+
+/**
+ * @brief Reserva un arreglo de entradas libres.
+ * @throw ERROR_NGRAMA_MEMORIA si no se logra reservar memoria.
+*/
+static struct entrada_ngrama *aux_crear_entradas(unsigned long capacidad){
+    struct entrada_ngrama *to_return = (struct entrada_ngrama*) calloc(capacidad, sizeof(struct entrada_ngrama));
+    if (to_return==NULL){
+        printf("Error %d: No se pudo reservar memoria para los n-gramas.\n", ERROR_NGRAMA_MEMORIA);
+        exit(ERROR_NGRAMA_MEMORIA);
+    }
+    return to_return;
+}
+
+tabla_ngramas_t *ngrama_crear(int n){
+    tabla_ngramas_t *t = (tabla_ngramas_t*) malloc(sizeof(struct tabla_ngramas));
+    if (t==NULL){
+        printf("Error %d: No se pudo reservar memoria para los n-gramas.\n", ERROR_NGRAMA_MEMORIA);
+        exit(ERROR_NGRAMA_MEMORIA);
+    }
+    t->n = n;
+    t->capacidad = 1024;
+    t->cantidad = 0;
+    t->entradas = aux_crear_entradas(t->capacidad);
+    t->cant_ventana = 0;
+
+    return t;
+}
+
+/**
+ * @brief Combina los identificadores de la secuencia en un valor de dispersión.
+*/
+static unsigned long long aux_hash(tabla_ngramas_t *t, unsigned int *ids){
+    unsigned long long h = 0;
+
+    for (int i=0; i<t->n; i++){
+        h = (h ^ ids[i]) * 0x9E3779B97F4A7C15ULL;
+        h = h ^ (h>>29);
+    }
+
+    return h;
+}
+
+/**
+ * @brief Devuelve la posición de la secuencia en el arreglo dado, o la posición libre donde debería ubicarse.
+*/
+static unsigned long aux_buscar(tabla_ngramas_t *t, struct entrada_ngrama *entradas, unsigned long capacidad, unsigned int *ids){
+    unsigned long pos = aux_hash(t, ids) & (capacidad-1);
+
+    while (entradas[pos].cantidad!=0 && memcmp(entradas[pos].ids, ids, t->n*sizeof(unsigned int))!=0){
+        pos = (pos+1) & (capacidad-1);
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Duplica la capacidad de la tabla, reubicando las entradas ocupadas.
+*/
+static void aux_ampliar(tabla_ngramas_t *t){
+    unsigned long capacidad = 2*t->capacidad;
+    struct entrada_ngrama *entradas = aux_crear_entradas(capacidad);
+
+    for (unsigned long i=0; i<t->capacidad; i++){
+        if (t->entradas[i].cantidad!=0){
+            entradas[aux_buscar(t, entradas, capacidad, t->entradas[i].ids)] = t->entradas[i];
+        }
+    }
+    free(t->entradas);
+    t->entradas = entradas;
+    t->capacidad = capacidad;
+}
+
+void ngrama_agregar_palabra(tabla_ngramas_t *t, unsigned int id){
+    //Se desplaza la ventana si está completa y se agrega la palabra al final.
+    if (t->cant_ventana==t->n){
+        memmove(t->ventana, t->ventana+1, (t->n-1)*sizeof(unsigned int));
+        t->cant_ventana = t->cant_ventana - 1;
+    }
+    t->ventana[t->cant_ventana] = id;
+    t->cant_ventana = t->cant_ventana + 1;
+
+    if (t->cant_ventana==t->n){
+        //La tabla se mantiene ocupada a lo sumo a la mitad, para que las búsquedas sean cortas.
+        if (2*(t->cantidad+1) > t->capacidad){
+            aux_ampliar(t);
+        }
+        unsigned long pos = aux_buscar(t, t->entradas, t->capacidad, t->ventana);
+        if (t->entradas[pos].cantidad==0){
+            memcpy(t->entradas[pos].ids, t->ventana, t->n*sizeof(unsigned int));
+            t->cantidad = t->cantidad + 1;
+        }
+        t->entradas[pos].cantidad = t->entradas[pos].cantidad + 1;
+    }
+}
+
+void ngrama_reiniciar_ventana(tabla_ngramas_t *t){
+    t->cant_ventana = 0;
+}
+
+//----EXPORTACIÓN----
+
+/**
+ * @struct diccionario
+ * @brief Modela la traducción de identificadores a palabras y a su posición en orden lexicográfico.
+*/
+struct diccionario {
+    char **palabras; //Palabra de cada identificador.
+    unsigned int *rangos; //Posición en orden lexicográfico de cada identificador.
+    unsigned int cant_visitadas;
+};
+
+/**
+ * @brief Función de visita que registra la palabra y la posición lexicográfica de cada identificador.
+ * @throw ERROR_NGRAMA_MEMORIA si no se logra reservar memoria para la palabra.
+*/
+static void aux_visitar_diccionario(char *palabra, long long cantidad, unsigned int id, void *contexto){
+    struct diccionario *D = (struct diccionario*) contexto;
+
+    D->palabras[id] = (char*) malloc(strlen(palabra)+1);
+    if (D->palabras[id]==NULL){
+        printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_NGRAMA_MEMORIA);
+        exit(ERROR_NGRAMA_MEMORIA);
+    }
+    strcpy(D->palabras[id], palabra);
+    D->rangos[id] = D->cant_visitadas;
+    D->cant_visitadas = D->cant_visitadas + 1;
+}
+
+//Tabla y diccionario que utiliza la comparación de qsort, que no recibe contexto.
+static tabla_ngramas_t *tabla_ordenada = NULL;
+static struct diccionario *diccionario_ordenado = NULL;
+
+/**
+ * @brief Compara dos secuencias por cantidad y, a igual cantidad, por la posición lexicográfica de sus palabras.
+ * Como el espacio precede a toda letra, el orden coincide con el de las cadenas "palabra1 palabra2 ...".
+*/
+static int aux_comparar_entradas(const void *p1, const void *p2){
+    const struct entrada_ngrama *e1 = (const struct entrada_ngrama*) p1;
+    const struct entrada_ngrama *e2 = (const struct entrada_ngrama*) p2;
+    int to_return = (e1->cantidad > e2->cantidad) - (e1->cantidad < e2->cantidad);
+
+    for (int i=0; i<tabla_ordenada->n && to_return==0; i++){
+        unsigned int r1 = diccionario_ordenado->rangos[e1->ids[i]];
+        unsigned int r2 = diccionario_ordenado->rangos[e2->ids[i]];
+        to_return = (r1 > r2) - (r1 < r2);
+    }
+
+    return to_return;
+}
+
+void ngrama_exportar(tabla_ngramas_t *t, multiset_t *m, FILE *f){
+    unsigned int cant_palabras = multiset_cantidad_palabras(m);
+    struct diccionario D;
+    unsigned long cant_ocupadas = 0;
+
+    D.palabras = (char**) malloc(cant_palabras*sizeof(char*) + 1);
+    D.rangos = (unsigned int*) malloc(cant_palabras*sizeof(unsigned int) + 1);
+    D.cant_visitadas = 0;
+    if (D.palabras==NULL || D.rangos==NULL){
+        printf("Error %d: No se pudo reservar memoria para el diccionario.\n", ERROR_NGRAMA_MEMORIA);
+        exit(ERROR_NGRAMA_MEMORIA);
+    }
+    multiset_recorrer_ids(m, aux_visitar_diccionario, &D);
+
+    //Se compactan las entradas ocupadas al inicio del arreglo; la tabla deja de ser utilizable como tal.
+    for (unsigned long i=0; i<t->capacidad; i++){
+        if (t->entradas[i].cantidad!=0){
+            t->entradas[cant_ocupadas] = t->entradas[i];
+            cant_ocupadas = cant_ocupadas + 1;
+        }
+    }
+    tabla_ordenada = t;
+    diccionario_ordenado = &D;
+    qsort(t->entradas, cant_ocupadas, sizeof(struct entrada_ngrama), aux_comparar_entradas);
+
+    for (unsigned long i=0; i<cant_ocupadas; i++){
+        fprintf(f, "%lld  ", t->entradas[i].cantidad);
+        for (int j=0; j<t->n; j++){
+            fprintf(f, " %s", D.palabras[t->entradas[i].ids[j]]);
+        }
+        fprintf(f, "\n");
+    }
+
+    //La tabla queda vacía.
+    memset(t->entradas, 0, t->capacidad*sizeof(struct entrada_ngrama));
+    t->cantidad = 0;
+    t->cant_ventana = 0;
+
+    for (unsigned int i=0; i<cant_palabras; i++){
+        free(D.palabras[i]);
+    }
+    free(D.palabras);
+    free(D.rangos);
+}
+
+void ngrama_eliminar(tabla_ngramas_t **t){
+    free((*t)->entradas);
+    free(*t);
+    *t = NULL;
+}
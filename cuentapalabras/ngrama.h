@@ -0,0 +1,63 @@
+/**
+* @file ngrama.h
+* @brief Archivo encabezado del TDA Ngrama.
+* Cuenta secuencias de N palabras consecutivas (bigramas o trigramas). Cada secuencia se representa por los
+* identificadores de sus palabras (ver multiset_insertar_id), empaquetados como clave de una tabla hash de
+* direccionamiento abierto, por lo que las palabras no se copian ni se comparan como cadenas al contar.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef NGRAMA_H_INCLUDED
+#define NGRAMA_H_INCLUDED
+
+#include <stdio.h>
+#include "multiset.h"
+
+#define ERROR_NGRAMA_MEMORIA -20
+
+//Longitud máxima de las secuencias.
+#define NGRAMA_MAXIMO 3
+
+struct tabla_ngramas;
+typedef struct tabla_ngramas tabla_ngramas_t;
+
+/**
+ * @brief Crea una tabla vacía de secuencias de 'n' palabras y la devuelve.
+ * @param n Longitud de las secuencias, entre 2 y NGRAMA_MAXIMO.
+ * @throw ERROR_NGRAMA_MEMORIA si no se logra reservar memoria.
+ * @return Puntero a la tabla construida.
+*/
+extern tabla_ngramas_t *ngrama_crear(int n);
+
+/**
+ * @brief Agrega la palabra de identificador 'id' a la ventana de las últimas palabras leidas y, si la ventana ya
+ * contiene 'n' palabras, incrementa la secuencia que forman.
+ * @param t Puntero a la tabla.
+ * @param id Identificador de la palabra leida.
+ * @throw ERROR_NGRAMA_MEMORIA si no se logra ampliar la tabla.
+*/
+extern void ngrama_agregar_palabra(tabla_ngramas_t *t, unsigned int id);
+
+/**
+ * @brief Vacía la ventana de últimas palabras leidas, de modo que ninguna secuencia cruce el límite de un documento.
+ * @param t Puntero a la tabla.
+*/
+extern void ngrama_reiniciar_ventana(tabla_ngramas_t *t);
+
+/**
+ * @brief Escribe cada secuencia en el archivo dado, con el formato de totales.out y sus palabras separadas por un espacio,
+ * de menor a mayor cantidad de repeticiones y, a igual cantidad, en orden lexicográfico. Luego la tabla queda vacía.
+ * @param t Puntero a la tabla.
+ * @param m Multiset en MULTISET_MODO_TRIE que asignó los identificadores.
+ * @param f Puntero al archivo abierto para escritura.
+ * @throw ERROR_NGRAMA_MEMORIA si no se logra reservar memoria para el ordenamiento.
+*/
+extern void ngrama_exportar(tabla_ngramas_t *t, multiset_t *m, FILE *f);
+
+/**
+ * @brief Elimina la tabla liberando la memoria reservada. Luego de la invocación '*t' es NULL.
+*/
+extern void ngrama_eliminar(tabla_ngramas_t **t);
+
+#endif // NGRAMA_H_INCLUDED
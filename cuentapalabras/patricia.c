@@ -0,0 +1,304 @@
+/**
+* @file patricia.c
+* @brief Implementación del TDA Patricia.
+* Cada nodo conserva la etiqueta de la arista que llega a él como un desplazamiento y una longitud dentro del
+* arreglo de caracteres del árbol. Al dividir una arista no se copian caracteres, solo se ajustan los desplazamientos.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "patricia.h"
+#include "contador.h"
+#include "alfabeto.h"
+
+/**
+ * @struct nodo_patricia
+ * @brief Modela un nodo del árbol, con la etiqueta de la arista que llega a él y hasta ALFABETO_TAMANIO hijos, uno por
+ * cada caracter del alfabeto (ver alfabeto.h) con el que puede comenzar la etiqueta del hijo.
+*/
+struct nodo_patricia {
+    unsigned long etiqueta; //Posición del primer caracter de la etiqueta en el arreglo de caracteres.
+    unsigned int longitud; //Cantidad de caracteres de la etiqueta (comparte palabra de memoria con el contador).
+    contador_t cantidad; //Cantidad de veces que aparece la palabra que termina en este nodo (ver contador.h).
+    struct nodo_patricia *siguiente[ALFABETO_TAMANIO];
+};
+
+/**
+ * @struct patricia
+ * @brief Modela el árbol como su raiz (de etiqueta vacía) y el arreglo de caracteres de las etiquetas.
+*/
+struct patricia {
+    struct nodo_patricia *raiz;
+    char *caracteres; //Arreglo común de caracteres de las etiquetas.
+    unsigned long cant_caracteres; //Caracteres ocupados del arreglo.
+    unsigned long capacidad; //Capacidad del arreglo de caracteres.
+    unsigned long cant_nodos; //Cantidad de nodos reservados (incluyendo la raiz).
+    tabla_contadores_t *desbordados; //Contadores que no entran en el campo del nodo (NULL si no hay).
+};
+
+/**
+ * @brief Construye un nodo sin hijos con la etiqueta dada.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra reservar memoria.
+*/
+static struct nodo_patricia *aux_crear_nodo(patricia_t *p, unsigned long etiqueta, unsigned int longitud){
+    struct nodo_patricia *N = (struct nodo_patricia*) malloc(sizeof(struct nodo_patricia));
+    if (N==NULL){
+        printf("Error %d: No se pudo reservar memoria para el nodo.\n", ERROR_PATRICIA_MEMORIA);
+        exit(ERROR_PATRICIA_MEMORIA);
+    }
+    N->etiqueta = etiqueta;
+    N->longitud = longitud;
+    N->cantidad = 0;
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        N->siguiente[i] = NULL;
+    }
+    p->cant_nodos = p->cant_nodos + 1;
+
+    return N;
+}
+
+/**
+ * @brief Agrega los caracteres de 's' al final del arreglo de caracteres y devuelve la posición del primero.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra ampliar el arreglo.
+*/
+static unsigned long aux_agregar_caracteres(patricia_t *p, char *s, unsigned long longitud){
+    unsigned long inicio = p->cant_caracteres;
+
+    if (p->cant_caracteres + longitud > p->capacidad){
+        unsigned long capacidad = (p->capacidad==0) ? 256 : p->capacidad;
+        while (p->cant_caracteres + longitud > capacidad){
+            capacidad = 2*capacidad;
+        }
+        p->caracteres = (char*) realloc(p->caracteres, capacidad*sizeof(char));
+        if (p->caracteres==NULL){
+            printf("Error %d: No se pudo reservar memoria para las etiquetas.\n", ERROR_PATRICIA_MEMORIA);
+            exit(ERROR_PATRICIA_MEMORIA);
+        }
+        p->capacidad = capacidad;
+    }
+    memcpy(p->caracteres + inicio, s, longitud);
+    p->cant_caracteres = p->cant_caracteres + longitud;
+
+    return inicio;
+}
+
+patricia_t *patricia_crear(){
+    patricia_t *P = (struct patricia*) malloc(sizeof(struct patricia));
+    if (P==NULL){
+        printf("Error %d: No se pudo reservar memoria para el arbol.\n", ERROR_PATRICIA_MEMORIA);
+        exit(ERROR_PATRICIA_MEMORIA);
+    }
+    P->caracteres = NULL;
+    P->cant_caracteres = 0;
+    P->capacidad = 0;
+    P->cant_nodos = 0;
+    P->desbordados = NULL;
+    P->raiz = aux_crear_nodo(P, 0, 0);
+
+    return P;
+}
+
+void patricia_insertar(patricia_t *p, char *s, long long cantidad){
+    struct nodo_patricia *T = p->raiz;
+
+    ///Mientras queden caracteres, se desciende por la arista que comienza con el caracter actual.
+    while (*s!='\0'){
+        int pos = ALFABETO_POSICION(*s);
+        struct nodo_patricia *H = T->siguiente[pos];
+
+        if (H==NULL){
+            //No hay arista, por lo que se crea una hoja con el resto de la palabra como etiqueta.
+            unsigned int longitud = strlen(s);
+            H = aux_crear_nodo(p, aux_agregar_caracteres(p, s, longitud), longitud);
+            T->siguiente[pos] = H;
+            s = s + longitud;
+        }
+        else{
+            //Se recupera cuántos caracteres de la etiqueta coinciden con la palabra.
+            char *etiqueta = p->caracteres + H->etiqueta;
+            unsigned int j = 0;
+            while (j<H->longitud && s[j]==etiqueta[j]){
+                j++;
+            }
+
+            if (j<H->longitud){
+                //La palabra diverge dentro de la arista: se divide en un nodo intermedio con el prefijo en común.
+                struct nodo_patricia *M = aux_crear_nodo(p, H->etiqueta, j);
+                H->etiqueta = H->etiqueta + j;
+                H->longitud = H->longitud - j;
+                M->siguiente[ALFABETO_POSICION(p->caracteres[H->etiqueta])] = H;
+                T->siguiente[pos] = M;
+                H = M;
+            }
+            s = s + j;
+        }
+        T = H;
+    }
+
+    contador_sumar(&(p->desbordados), &(T->cantidad), cantidad);
+}
+
+long long patricia_cantidad(patricia_t *p, char *s){
+    long long cant_repeticiones = 0;
+    int existe_palabra = TRUE;
+    struct nodo_patricia *T = p->raiz;
+
+    while ((existe_palabra==TRUE) && (*s!='\0')){
+        T = T->siguiente[ALFABETO_POSICION(*s)];
+        if (T==NULL){
+            existe_palabra = FALSE;
+        }
+        else{
+            //La etiqueta completa debe coincidir con el comienzo de lo que resta de la palabra.
+            if (strncmp(s, p->caracteres + T->etiqueta, T->longitud)!=0){
+                existe_palabra = FALSE;
+            }
+            else{
+                s = s + T->longitud;
+            }
+        }
+    }
+
+    if (existe_palabra==TRUE){
+        cant_repeticiones = contador_valor(p->desbordados, &(T->cantidad));
+    }
+
+    return cant_repeticiones;
+}
+
+/**
+ * @struct recorrido_patricia
+ * @brief Modela el estado del recorrido: la palabra construida hasta el momento y la función a invocar.
+*/
+struct recorrido_patricia {
+    patricia_t *p;
+    char *palabra; //Palabra del nodo actual (terminada en '\0').
+    unsigned long capacidad; //Capacidad del arreglo 'palabra'.
+    funcion_visita_t *visitar;
+    void *contexto;
+};
+
+/**
+ * @brief Recorre en orden lexicográfico el subárbol del nodo T, cuya palabra tiene 'longitud' caracteres antes de su etiqueta.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra ampliar el arreglo de la palabra.
+*/
+static void aux_recorrer(struct recorrido_patricia *R, struct nodo_patricia *T, unsigned long longitud){
+    unsigned long longitud_nueva = longitud + T->longitud;
+
+    if (longitud_nueva + 1 > R->capacidad){
+        while (longitud_nueva + 1 > R->capacidad){
+            R->capacidad = 2*R->capacidad;
+        }
+        R->palabra = (char*) realloc(R->palabra, R->capacidad*sizeof(char));
+        if (R->palabra==NULL){
+            printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_PATRICIA_MEMORIA);
+            exit(ERROR_PATRICIA_MEMORIA);
+        }
+    }
+    memcpy(R->palabra + longitud, R->p->caracteres + T->etiqueta, T->longitud);
+    R->palabra[longitud_nueva] = '\0';
+
+    //El prefijo se visita antes que sus extensiones, respetando el orden de strcmp.
+    if (T->cantidad>0){
+        R->visitar(R->palabra, contador_valor(R->p->desbordados, &(T->cantidad)), R->contexto);
+    }
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        if (T->siguiente[i]!=NULL){
+            aux_recorrer(R, T->siguiente[i], longitud_nueva);
+        }
+    }
+}
+
+void patricia_recorrer(patricia_t *p, funcion_visita_t visitar, void *contexto){
+    patricia_recorrer_prefijo(p, "", visitar, contexto);
+}
+
+void patricia_recorrer_prefijo(patricia_t *p, char *prefijo, funcion_visita_t visitar, void *contexto){
+    unsigned long longitud_prefijo = strlen(prefijo);
+    struct recorrido_patricia R = {p, NULL, longitud_prefijo+64, visitar, contexto};
+    struct nodo_patricia *T = p->raiz;
+    unsigned long consumidos = 0;
+    int existe_prefijo = TRUE;
+
+    R.palabra = (char*) malloc(R.capacidad*sizeof(char));
+    if (R.palabra==NULL){
+        printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_PATRICIA_MEMORIA);
+        exit(ERROR_PATRICIA_MEMORIA);
+    }
+
+    ///Se desciende mientras el prefijo abarque por completo la etiqueta de la arista.
+    while ((existe_prefijo==TRUE) && (consumidos<longitud_prefijo)){
+        struct nodo_patricia *H = T->siguiente[ALFABETO_POSICION(prefijo[consumidos])];
+        if (H==NULL){
+            existe_prefijo = FALSE;
+        }
+        else{
+            unsigned long restantes = longitud_prefijo - consumidos;
+            unsigned long comparar = (restantes<H->longitud) ? restantes : H->longitud;
+
+            if (strncmp(prefijo + consumidos, p->caracteres + H->etiqueta, comparar)!=0){
+                existe_prefijo = FALSE;
+            }
+            else{
+                //Si el prefijo termina dentro de la etiqueta, todo el subárbol de H comienza con él.
+                if (restantes<=H->longitud){
+                    memcpy(R.palabra, prefijo, consumidos);
+                    aux_recorrer(&R, H, consumidos);
+                    existe_prefijo = FALSE;
+                }
+                else{
+                    consumidos = consumidos + H->longitud;
+                    T = H;
+                }
+            }
+        }
+    }
+    //Solo se llega aquí con el prefijo vacío, por lo que se recorre el árbol completo.
+    if (existe_prefijo==TRUE){
+        aux_recorrer(&R, T, 0);
+    }
+    free(R.palabra);
+}
+
+unsigned long patricia_memoria(patricia_t *p){
+    return p->cant_nodos*sizeof(struct nodo_patricia) + p->capacidad*sizeof(char) + sizeof(struct patricia) + contador_memoria(p->desbordados);
+}
+
+unsigned long patricia_cantidad_nodos(patricia_t *p){
+    return p->cant_nodos;
+}
+
+/**
+ * @brief Elimina los nodos descendientes del nodo dado de manera recursiva, dejando al nodo sin hijos.
+*/
+static void aux_eliminar_descendientes(struct nodo_patricia *nodo){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        if (nodo->siguiente[i]!=NULL){
+            aux_eliminar_descendientes(nodo->siguiente[i]);
+            free(nodo->siguiente[i]);
+            nodo->siguiente[i] = NULL;
+        }
+    }
+}
+
+void patricia_vaciar(patricia_t *p){
+    aux_eliminar_descendientes(p->raiz);
+    p->raiz->cantidad = 0;
+    p->cant_nodos = 1;
+    contador_eliminar_tabla(&(p->desbordados));
+    //Se conserva la capacidad del arreglo de caracteres para las próximas inserciones.
+    p->cant_caracteres = 0;
+}
+
+void patricia_eliminar(patricia_t **p){
+    aux_eliminar_descendientes((*p)->raiz);
+    free((*p)->raiz);
+    free((*p)->caracteres);
+    contador_eliminar_tabla(&((*p)->desbordados));
+    free(*p);
+    *p = NULL;
+}
@@ -0,0 +1,90 @@
+/**
+* @file patricia.h
+* @brief Archivo encabezado del TDA Patricia.
+* Un árbol Patricia (o radix trie) es un trie con compresión de caminos: las cadenas de nodos con un único hijo
+* se colapsan en una arista rotulada con una secuencia de caracteres, almacenada en un arreglo común de caracteres.
+* Las palabras que recibe deben estar compuestas solo por caracteres del alfabeto (ver alfabeto.h).
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef PATRICIA_H_INCLUDED
+#define PATRICIA_H_INCLUDED
+
+#include "multiset.h"
+
+#define ERROR_PATRICIA_MEMORIA -14
+
+struct patricia;
+typedef struct patricia patricia_t;
+
+/**
+ * @brief Crea un árbol Patricia vacío y lo devuelve.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra reservar memoria.
+ * @return Puntero al árbol construido.
+*/
+extern patricia_t *patricia_crear();
+
+/**
+ * @brief Incrementa en 'cantidad' las repeticiones de la palabra 's', dividiendo la arista en la que diverja si es necesario.
+ * @param p Puntero al árbol.
+ * @param s Puntero a la palabra (solo caracteres del alfabeto).
+ * @param cantidad Entero positivo a sumar.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra reservar memoria.
+*/
+extern void patricia_insertar(patricia_t *p, char *s, long long cantidad);
+
+/**
+ * @brief Devuelve la cantidad de repeticiones de la palabra 's' en el árbol, o 0 si no está definida.
+ * @param p Puntero al árbol.
+ * @param s Puntero a la palabra (solo caracteres del alfabeto).
+ * @return Entero mayor o igual a 0.
+*/
+extern long long patricia_cantidad(patricia_t *p, char *s);
+
+/**
+ * @brief Recorre las palabras del árbol en orden lexicográfico e invoca a 'visitar' con cada una de ellas.
+ * @param p Puntero al árbol.
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra reservar memoria para la palabra recorrida.
+*/
+extern void patricia_recorrer(patricia_t *p, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Recorre en orden lexicográfico solo las palabras que comienzan con 'prefijo'.
+ * @param p Puntero al árbol.
+ * @param prefijo Puntero al prefijo (solo caracteres del alfabeto).
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador.
+ * @throw ERROR_PATRICIA_MEMORIA si no se logra reservar memoria para la palabra recorrida.
+*/
+extern void patricia_recorrer_prefijo(patricia_t *p, char *prefijo, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Devuelve la cantidad de bytes reservados por los nodos, el arreglo de caracteres y los contadores desbordados del árbol.
+ * @param p Puntero al árbol.
+ * @return Entero positivo con la cantidad de bytes en uso.
+*/
+extern unsigned long patricia_memoria(patricia_t *p);
+
+/**
+ * @brief Devuelve la cantidad de nodos del árbol (incluyendo la raiz).
+ * @param p Puntero al árbol.
+ * @return Entero mayor o igual a 1.
+*/
+extern unsigned long patricia_cantidad_nodos(patricia_t *p);
+
+/**
+ * @brief Remueve todas las palabras del árbol, que queda vacío y puede seguir utilizándose.
+ * @param p Puntero al árbol.
+*/
+extern void patricia_vaciar(patricia_t *p);
+
+/**
+ * @brief Elimina el árbol liberando el espacio de memoria reservado. Luego de la invocacion 'p' debe NULL.
+ * @param p Puntero al puntero del árbol.
+*/
+extern void patricia_eliminar(patricia_t **p);
+
+#endif // PATRICIA_H_INCLUDED
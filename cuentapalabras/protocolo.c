@@ -0,0 +1,112 @@
+/**
+* @file protocolo.c
+* @brief Implementación de las operaciones de envío y recepción del protocolo del servidor de cuentapalabras.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef _WIN32
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "define.h"
+#include "protocolo.h"
+
+int protocolo_escribir(int fd, void *datos, unsigned long n){
+    char *cursor = (char*) datos;
+    int to_return = TRUE;
+
+    while (n>0 && to_return==TRUE){
+        ssize_t escritos = write(fd, cursor, n);
+        if (escritos>=0){
+            cursor = cursor + escritos;
+            n = n - escritos;
+        }
+        else{
+            //Una interrupción por señal no es un error: se reintenta la escritura.
+            if (errno!=EINTR){
+                to_return = FALSE;
+            }
+        }
+    }
+
+    return to_return;
+}
+
+int protocolo_leer(int fd, void *datos, unsigned long n){
+    char *cursor = (char*) datos;
+    int to_return = TRUE;
+
+    while (n>0 && to_return==TRUE){
+        ssize_t leidos = read(fd, cursor, n);
+        if (leidos>0){
+            cursor = cursor + leidos;
+            n = n - leidos;
+        }
+        else{
+            //La conexión se cerró o falló (salvo una interrupción por señal, en cuyo caso se reintenta).
+            if (leidos==0 || errno!=EINTR){
+                to_return = FALSE;
+            }
+        }
+    }
+
+    return to_return;
+}
+
+int protocolo_enviar_solicitud(int fd, uint32_t operacion, char *archivo, char *argumento){
+    encabezado_solicitud_t encabezado;
+    int to_return;
+
+    encabezado.operacion = operacion;
+    encabezado.longitud_archivo = (archivo==NULL) ? 0 : strlen(archivo);
+    encabezado.longitud_argumento = (argumento==NULL) ? 0 : strlen(argumento);
+
+    to_return = protocolo_escribir(fd, &encabezado, sizeof(encabezado));
+    if (to_return==TRUE && encabezado.longitud_archivo>0){
+        to_return = protocolo_escribir(fd, archivo, encabezado.longitud_archivo);
+    }
+    if (to_return==TRUE && encabezado.longitud_argumento>0){
+        to_return = protocolo_escribir(fd, argumento, encabezado.longitud_argumento);
+    }
+
+    return to_return;
+}
+
+int protocolo_recibir_respuesta(int fd, int32_t *estado, funcion_visita_t visitar, void *contexto){
+    encabezado_respuesta_t encabezado;
+    char *palabra = NULL;
+    uint32_t capacidad = 0;
+    int to_return = protocolo_leer(fd, &encabezado, sizeof(encabezado));
+
+    if (to_return==TRUE){
+        *estado = encabezado.estado;
+    }
+    for (uint32_t i=0; i<encabezado.cant_registros && to_return==TRUE; i++){
+        int64_t cantidad;
+        uint32_t longitud;
+
+        to_return = protocolo_leer(fd, &cantidad, sizeof(cantidad)) && protocolo_leer(fd, &longitud, sizeof(longitud));
+        if (to_return==TRUE && longitud+1>capacidad){
+            capacidad = longitud+1;
+            palabra = (char*) realloc(palabra, capacidad);
+            to_return = (palabra!=NULL);
+        }
+        if (to_return==TRUE){
+            to_return = protocolo_leer(fd, palabra, longitud);
+        }
+        if (to_return==TRUE){
+            palabra[longitud] = '\0';
+            if (visitar!=NULL){
+                visitar(palabra, cantidad, contexto);
+            }
+        }
+    }
+    free(palabra);
+
+    return to_return;
+}
+
+#endif // _WIN32
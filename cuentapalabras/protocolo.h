@@ -0,0 +1,89 @@
+/**
+* @file protocolo.h
+* @brief Archivo encabezado del protocolo entre el servidor de cuentapalabras y sus clientes.
+* El protocolo es binario y se utiliza sobre un socket local de dominio Unix, por lo que los enteros viajan en el
+* orden de bytes de la máquina.
+*
+* Solicitud: encabezado_solicitud_t seguido de 'longitud_archivo' bytes con el nombre del archivo a consultar
+* (vacío para consultar los totales) y de 'longitud_argumento' bytes con el argumento de la operación.
+* Respuesta: encabezado_respuesta_t seguido de 'cant_registros' registros, cada uno con la cantidad (int64_t),
+* la longitud de la palabra (uint32_t) y los caracteres de la palabra (sin fin de cadena).
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef PROTOCOLO_H_INCLUDED
+#define PROTOCOLO_H_INCLUDED
+
+#include <stdint.h>
+#include "multiset.h"
+
+//Operaciones de una solicitud.
+#define PROTOCOLO_INGESTAR 1 ///Argumento: ruta de un archivo .txt o de un directorio. Responde un registro con la cantidad de archivos leidos.
+#define PROTOCOLO_CANTIDAD 2 ///Argumento: palabra. Responde un registro con la palabra y su cantidad.
+#define PROTOCOLO_TOP 3 ///Argumento: K en decimal. Responde las K palabras con más repeticiones, de mayor a menor.
+#define PROTOCOLO_PREFIJO 4 ///Argumento: prefijo. Responde las palabras que comienzan con el prefijo, en orden lexicográfico.
+#define PROTOCOLO_DETENER 5 ///Sin argumento. Detiene el servidor.
+
+//Estados de una respuesta.
+#define PROTOCOLO_OK 0
+#define PROTOCOLO_ERROR_SOLICITUD 1 ///Operación desconocida o solicitud mal formada.
+#define PROTOCOLO_ERROR_ARCHIVO 2 ///El archivo a ingestar o consultar no existe.
+
+//Longitud máxima del nombre de archivo y del argumento de una solicitud.
+#define PROTOCOLO_LONGITUD_MAXIMA 4096
+
+/**
+ * @struct encabezado_solicitud
+ * @brief Modela el encabezado de longitud fija de una solicitud.
+*/
+struct encabezado_solicitud {
+    uint32_t operacion;
+    uint32_t longitud_archivo;
+    uint32_t longitud_argumento;
+};
+typedef struct encabezado_solicitud encabezado_solicitud_t;
+
+/**
+ * @struct encabezado_respuesta
+ * @brief Modela el encabezado de longitud fija de una respuesta.
+*/
+struct encabezado_respuesta {
+    int32_t estado;
+    uint32_t cant_registros;
+};
+typedef struct encabezado_respuesta encabezado_respuesta_t;
+
+/**
+ * @brief Escribe los 'n' bytes de 'datos' en el descriptor 'fd', reintentando ante escrituras parciales.
+ * @return TRUE si se escribieron todos los bytes, FALSE si la conexión falló.
+*/
+extern int protocolo_escribir(int fd, void *datos, unsigned long n);
+
+/**
+ * @brief Lee exactamente 'n' bytes del descriptor 'fd' en 'datos', reintentando ante lecturas parciales.
+ * @return TRUE si se leyeron todos los bytes, FALSE si la conexión se cerró o falló.
+*/
+extern int protocolo_leer(int fd, void *datos, unsigned long n);
+
+/**
+ * @brief Envía una solicitud con la operación, el archivo y el argumento dados.
+ * @param fd Descriptor del socket conectado.
+ * @param operacion Una de las constantes PROTOCOLO_INGESTAR, PROTOCOLO_CANTIDAD, etc.
+ * @param archivo Nombre del archivo a consultar o NULL para los totales.
+ * @param argumento Argumento de la operación o NULL.
+ * @return TRUE si la solicitud se envió, FALSE si la conexión falló.
+*/
+extern int protocolo_enviar_solicitud(int fd, uint32_t operacion, char *archivo, char *argumento);
+
+/**
+ * @brief Recibe una respuesta e invoca a 'visitar' con cada uno de sus registros.
+ * @param fd Descriptor del socket conectado.
+ * @param estado Puntero donde se almacena el estado de la respuesta.
+ * @param visitar Función que recibe cada palabra y su cantidad, o NULL para descartar los registros.
+ * @param contexto Puntero a datos del invocador.
+ * @return TRUE si la respuesta se recibió completa, FALSE si la conexión falló.
+*/
+extern int protocolo_recibir_respuesta(int fd, int32_t *estado, funcion_visita_t visitar, void *contexto);
+
+#endif // PROTOCOLO_H_INCLUDED
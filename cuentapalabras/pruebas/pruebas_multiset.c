@@ -0,0 +1,313 @@
+/**
+* @file pruebas_multiset.c
+* @brief Pruebas del TDA Multiset en MULTISET_MODO_TRIE: aislamiento de las instantáneas respecto de las inserciones
+* posteriores, orden en que se liberan los nodos retirados, deshacer los nodos de una palabra inválida al insertar un
+* texto en una pasada, y reutilizar un multiset reiniciado. Informa cada verificación que falla y finaliza con un valor
+* distinto de 0 si alguna falló.
+* Las reservas y liberaciones se cuentan interceptando malloc y free en el enlazado, por lo que requiere el enlazador
+* de GNU y Linux.
+*
+* Compilación (desde este directorio):
+*   gcc -Wall -O2 -o pruebas_multiset pruebas_multiset.c ../multiset.c ../patricia.c ../rafaga.c ../contador.c ../aproximado.c ../lista.c ../alfabeto.c -lpthread -Wl,--wrap=malloc -Wl,--wrap=free
+*
+* Uso:
+*   pruebas_multiset
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../define.h"
+#include "../multiset.h"
+
+//Cantidad de invocaciones a malloc y de liberaciones de punteros no nulos desde el inicio del programa.
+static unsigned long cant_reservas = 0;
+static unsigned long cant_liberaciones = 0;
+//Cantidad de verificaciones realizadas y de verificaciones que fallaron.
+static int cant_verificaciones = 0;
+static int cant_fallas = 0;
+
+extern void *__real_malloc(size_t tamanio);
+extern void __real_free(void *puntero);
+
+/**
+ * @brief Reemplaza a malloc en el enlazado (-Wl,--wrap=malloc) para contar las reservas.
+*/
+void *__wrap_malloc(size_t tamanio){
+    cant_reservas++;
+    return __real_malloc(tamanio);
+}
+
+/**
+ * @brief Reemplaza a free en el enlazado (-Wl,--wrap=free) para contar las liberaciones.
+*/
+void __wrap_free(void *puntero){
+    if (puntero!=NULL){
+        cant_liberaciones++;
+    }
+    __real_free(puntero);
+}
+
+/**
+ * @brief Registra el resultado de una verificación, informándola si falló.
+ * @param prueba Nombre de la prueba.
+ * @param condicion TRUE si la verificación se cumple.
+ * @param descripcion Descripción de lo que se verifica.
+*/
+static void aux_verificar(char *prueba, int condicion, char *descripcion){
+    cant_verificaciones++;
+    if (!condicion){
+        cant_fallas++;
+        printf("FALLA [%s]: %s\n", prueba, descripcion);
+    }
+}
+
+/**
+ * @brief Función de visita que concatena "palabra:cantidad " a la cadena recibida como contexto.
+*/
+static void aux_visitar_concatenar(char *palabra, long long cantidad, void *contexto){
+    char *destino = (char*) contexto;
+    sprintf(destino + strlen(destino), "%s:%lld ", palabra, cantidad);
+}
+
+/**
+ * @brief Escribe en 'destino' las palabras del multiset y sus cantidades, en orden lexicográfico.
+ * @return El mismo puntero 'destino'.
+*/
+static char *aux_contenido(multiset_t *m, char *destino){
+    destino[0] = '\0';
+    multiset_recorrer(m, aux_visitar_concatenar, destino);
+    return destino;
+}
+
+/**
+ * @brief Inserta en el multiset, en una pasada, las palabras del texto dado.
+ * @return Cantidad de palabras insertadas (ver multiset_insertar_texto).
+*/
+static long aux_insertar_texto(multiset_t *m, const char *texto){
+    return multiset_insertar_texto(m, texto, strlen(texto));
+}
+
+/**
+ * @brief Una instantánea conserva las palabras del momento en que se tomó mientras el multiset recibe inserciones,
+ * incluso de contadores desbordados, se vacía o se compacta, y sus propias instantáneas muestran lo mismo.
+*/
+static void prueba_instantanea_aislada(){
+    char *prueba = "instantanea aislada";
+    char contenido[512];
+    multiset_t *m = multiset_crear();
+
+    multiset_insertar(m, "casa");
+    multiset_insertar(m, "casa");
+    multiset_insertar(m, "cosa");
+    multiset_insertar_cantidad(m, "perro", 100000);
+
+    multiset_t *s = multiset_instantanea(m);
+    aux_verificar(prueba, strcmp(aux_contenido(s, contenido), "casa:2 cosa:1 perro:100000 ")==0, "la instantanea muestra las palabras del multiset");
+
+    multiset_insertar(m, "casa");
+    multiset_insertar(m, "casas");
+    multiset_insertar(m, "ca");
+    multiset_insertar_cantidad(m, "perro", 100000);
+    multiset_t *s_de_s = multiset_instantanea(s);
+
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "ca:1 casa:3 casas:1 cosa:1 perro:200000 ")==0, "el multiset recibe las inserciones");
+    aux_verificar(prueba, strcmp(aux_contenido(s, contenido), "casa:2 cosa:1 perro:100000 ")==0, "la instantanea no ve las inserciones posteriores");
+    aux_verificar(prueba, multiset_cantidad(s, "perro")==100000, "la instantanea conserva el contador desbordado");
+    aux_verificar(prueba, multiset_cantidad_palabras(s)==3 && multiset_cantidad_palabras(m)==5, "cada uno conserva su cantidad de palabras");
+    aux_verificar(prueba, strcmp(aux_contenido(s_de_s, contenido), "casa:2 cosa:1 perro:100000 ")==0, "la instantanea de una instantanea muestra lo mismo");
+
+    multiset_compactar(m);
+    multiset_insertar(m, "cosa");
+    aux_verificar(prueba, strcmp(aux_contenido(s, contenido), "casa:2 cosa:1 perro:100000 ")==0, "la instantanea no cambia al compactar el multiset");
+
+    multiset_vaciar(m);
+    multiset_insertar(m, "gato");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "gato:1 ")==0, "el multiset vaciado solo tiene lo insertado luego");
+    aux_verificar(prueba, strcmp(aux_contenido(s, contenido), "casa:2 cosa:1 perro:100000 ")==0, "la instantanea no cambia al vaciar el multiset");
+
+    //Se elimina el multiset antes que sus instantáneas, que deben seguir siendo legibles.
+    multiset_eliminar(&m);
+    aux_verificar(prueba, multiset_cantidad(s_de_s, "casa")==2, "la instantanea sobrevive al multiset");
+    multiset_eliminar(&s);
+    aux_verificar(prueba, strcmp(aux_contenido(s_de_s, contenido), "casa:2 cosa:1 perro:100000 ")==0, "la ultima instantanea sobrevive a las demas");
+    multiset_eliminar(&s_de_s);
+}
+
+/**
+ * @brief Construye el escenario de la prueba de liberación: el multiset tiene "casa" y "cosa" (8 nodos) al tomar la
+ * instantánea 'anterior'; luego se inserta "casa", que copia sus 5 nodos (raiz, c, a, s, a) retirando los originales
+ * hasta la versión de 'anterior'; se toma la instantánea 'posterior' y se inserta "cosa", que retira otros 5 nodos
+ * hasta la versión de 'posterior'.
+*/
+static multiset_t *aux_escenario_liberacion(multiset_t **anterior, multiset_t **posterior){
+    multiset_t *m = multiset_crear();
+
+    multiset_insertar(m, "casa");
+    multiset_insertar(m, "cosa");
+    *anterior = multiset_instantanea(m);
+    multiset_insertar(m, "casa");
+    *posterior = multiset_instantanea(m);
+    multiset_insertar(m, "cosa");
+
+    return m;
+}
+
+/**
+ * @brief Los nodos retirados se liberan en cuanto no queda ninguna instantánea que pueda verlos, y no antes: eliminar
+ * la instantánea más nueva no libera los nodos que ve la más vieja. Al eliminar una instantánea se libera, además de los
+ * nodos, su propia estructura.
+*/
+static void prueba_orden_liberacion(){
+    char *prueba = "orden de liberacion";
+    char contenido[512];
+    unsigned long liberaciones;
+    multiset_t *anterior, *posterior, *nueva;
+
+    //Primero se elimina la instantánea más vieja.
+    multiset_t *m = aux_escenario_liberacion(&anterior, &posterior);
+    liberaciones = cant_liberaciones;
+    multiset_eliminar(&anterior);
+    aux_verificar(prueba, cant_liberaciones-liberaciones==1+5, "eliminar la instantanea mas vieja libera los 5 nodos que solo ella veia");
+    aux_verificar(prueba, strcmp(aux_contenido(posterior, contenido), "casa:2 cosa:1 ")==0, "la instantanea mas nueva sigue intacta");
+    liberaciones = cant_liberaciones;
+    multiset_eliminar(&posterior);
+    aux_verificar(prueba, cant_liberaciones-liberaciones==1, "los nodos retirados por el hilo que inserta esperan a la siguiente instantanea");
+    liberaciones = cant_liberaciones;
+    nueva = multiset_instantanea(m);
+    aux_verificar(prueba, cant_liberaciones-liberaciones==5, "la siguiente instantanea libera los 5 nodos que veia la mas nueva");
+    multiset_eliminar(&nueva);
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "casa:2 cosa:2 ")==0, "el multiset conserva sus palabras");
+    multiset_eliminar(&m);
+
+    //Primero se elimina la instantánea más nueva.
+    m = aux_escenario_liberacion(&anterior, &posterior);
+    liberaciones = cant_liberaciones;
+    multiset_eliminar(&posterior);
+    aux_verificar(prueba, cant_liberaciones-liberaciones==1, "eliminar la instantanea mas nueva no libera los nodos que ve la mas vieja");
+    aux_verificar(prueba, strcmp(aux_contenido(anterior, contenido), "casa:1 cosa:1 ")==0, "la instantanea mas vieja sigue intacta");
+    liberaciones = cant_liberaciones;
+    multiset_eliminar(&anterior);
+    aux_verificar(prueba, cant_liberaciones-liberaciones==1+5, "eliminar la instantanea mas vieja libera sus 5 nodos");
+    multiset_eliminar(&m);
+
+    //El multiset se elimina antes que su instantánea: el trie queda retirado hasta que se elimine ella.
+    m = aux_escenario_liberacion(&anterior, &posterior);
+    multiset_eliminar(&posterior);
+    multiset_eliminar(&m);
+    aux_verificar(prueba, strcmp(aux_contenido(anterior, contenido), "casa:1 cosa:1 ")==0, "la instantanea sobrevive al multiset");
+    liberaciones = cant_liberaciones;
+    multiset_eliminar(&anterior);
+    //Se liberan la instantánea, los 10 nodos retirados, los 8 del trie final y el registro de versiones con sus 3 arreglos.
+    aux_verificar(prueba, cant_liberaciones-liberaciones==1+10+8+4, "eliminar la ultima instantanea libera todos los nodos retirados y el trie");
+}
+
+/**
+ * @brief Al insertar un texto en una pasada, los nodos creados para una palabra inválida se quitan del trie y se
+ * reutilizan en las inserciones siguientes, sin alterar las palabras que comparten su camino.
+*/
+static void prueba_deshacer_insercion(){
+    char *prueba = "deshacer insercion";
+    char contenido[512];
+    unsigned long reservas;
+    multiset_t *m = multiset_crear();
+    multiset_t *referencia = multiset_crear();
+
+    aux_verificar(prueba, aux_insertar_texto(m, "casa cosa casas1")==2, "solo se cuentan las palabras validas");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "casa:1 cosa:1 ")==0, "la palabra invalida no deja rastro");
+    aux_verificar(prueba, multiset_cantidad(m, "casa")==1 && multiset_cantidad(m, "casas")==0, "la palabra que comparte el camino se conserva");
+    aux_verificar(prueba, multiset_cantidad_palabras(m)==2 && multiset_buscar_id(m, "cosa")==1, "la palabra invalida no consume un identificador");
+    contenido[0] = '\0';
+    multiset_recorrer_prefijo(m, "casas", aux_visitar_concatenar, contenido);
+    aux_verificar(prueba, contenido[0]=='\0', "no quedan nodos bajo el camino deshecho");
+    //El nodo de la 's' de "casas" queda libre y lo toma la 's' de "cosas", sin reservar memoria.
+    reservas = cant_reservas;
+    aux_insertar_texto(m, "cosas");
+    aux_verificar(prueba, cant_reservas==reservas && multiset_cantidad(m, "cosas")==1, "el nodo deshecho se reutiliza");
+    multiset_eliminar(&m);
+
+    //Palabras inválidas al inicio y al final del texto, sin separador final.
+    m = multiset_crear();
+    aux_verificar(prueba, aux_insertar_texto(m, "1abc gato abc2")==1, "se cuentan las palabras validas entre las invalidas");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "gato:1 ")==0, "las palabras invalidas de los extremos no dejan rastro");
+    multiset_eliminar(&m);
+
+    //Los 3 nodos de "abc" vuelven a la lista de libres y los toma "xyz": la memoria es la de contar solo "xyz".
+    m = multiset_crear();
+    aux_verificar(prueba, aux_insertar_texto(m, "abc1 xyz")==1, "se cuenta la palabra valida");
+    aux_insertar_texto(referencia, "xyz");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "xyz:1 ")==0, "el multiset solo tiene la palabra valida");
+    aux_verificar(prueba, multiset_memoria(m)==multiset_memoria(referencia), "los nodos deshechos se reutilizan");
+    multiset_eliminar(&m);
+    multiset_eliminar(&referencia);
+
+    //Con instantáneas la inserción en una pasada no está disponible y el texto no se procesa.
+    m = multiset_crear();
+    multiset_t *s = multiset_instantanea(m);
+    aux_verificar(prueba, aux_insertar_texto(m, "casa")==-1 && multiset_cantidad(m, "casa")==0, "con instantaneas se rechaza la insercion en una pasada");
+    multiset_eliminar(&s);
+    multiset_eliminar(&m);
+}
+
+/**
+ * @brief Un multiset reiniciado queda vacío, conserva sus nodos y cuenta el archivo siguiente como uno nuevo, sin
+ * reservar memoria mientras le alcancen los nodos conservados. Con instantáneas, reiniciar equivale a vaciar.
+*/
+static void prueba_reiniciar(){
+    char *prueba = "reiniciar";
+    char contenido[512];
+    char esperado[512];
+    unsigned long reservas;
+    multiset_t *m = multiset_crear();
+    multiset_t *referencia = multiset_crear();
+
+    aux_insertar_texto(m, "el perro y el gato y el raton");
+    multiset_insertar_cantidad(m, "perro", 100000);
+    unsigned long memoria = multiset_memoria(m);
+
+    multiset_reiniciar(m);
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "")==0, "el multiset reiniciado esta vacio");
+    aux_verificar(prueba, multiset_cantidad_palabras(m)==0 && multiset_cantidad(m, "perro")==0 && multiset_buscar_id(m, "el")==-1, "no quedan cantidades ni identificadores");
+    //Solo se libera la tabla de contadores desbordados; los nodos se conservan.
+    aux_verificar(prueba, multiset_memoria(m)<memoria, "reiniciar libera los contadores desbordados");
+    memoria = multiset_memoria(m);
+
+    reservas = cant_reservas;
+    aux_insertar_texto(m, "la gata y la rata");
+    aux_verificar(prueba, cant_reservas==reservas, "contar con los nodos conservados no reserva memoria");
+    aux_insertar_texto(referencia, "la gata y la rata");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), aux_contenido(referencia, esperado))==0, "cuenta igual que un multiset nuevo");
+    aux_verificar(prueba, multiset_buscar_id(m, "la")==0 && multiset_buscar_id(m, "rata")==3, "los identificadores comienzan de nuevo");
+    aux_verificar(prueba, multiset_memoria(m)==memoria, "la memoria sigue siendo la de los nodos conservados");
+
+    //Un segundo reinicio, ahora con más palabras de las que entran en los nodos conservados.
+    multiset_reiniciar(m);
+    multiset_vaciar(referencia);
+    aux_insertar_texto(m, "murcielago hipopotamo cocodrilo");
+    aux_insertar_texto(referencia, "murcielago hipopotamo cocodrilo");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), aux_contenido(referencia, esperado))==0, "cuenta igual tras reiniciar otra vez");
+
+    //Con una instantánea viva, reiniciar vacía el multiset sin alterar la instantánea.
+    multiset_t *s = multiset_instantanea(m);
+    multiset_reiniciar(m);
+    multiset_insertar(m, "sapo");
+    aux_verificar(prueba, strcmp(aux_contenido(m, contenido), "sapo:1 ")==0, "con instantaneas el multiset reiniciado solo tiene lo insertado luego");
+    aux_verificar(prueba, strcmp(aux_contenido(s, contenido), esperado)==0, "la instantanea no cambia al reiniciar el multiset");
+    multiset_eliminar(&s);
+
+    multiset_eliminar(&m);
+    multiset_eliminar(&referencia);
+}
+
+int main(){
+    prueba_instantanea_aislada();
+    prueba_orden_liberacion();
+    prueba_deshacer_insercion();
+    prueba_reiniciar();
+
+    printf("%d verificaciones, %d fallas.\n", cant_verificaciones, cant_fallas);
+
+    return (cant_fallas==0) ? 0 : 1;
+}
@@ -0,0 +1,446 @@
+/**
+* @file rafaga.c
+* @brief Implementación del TDA Rafaga.
+* Cada cubeta es un único bloque de memoria con su encabezado y sus entradas, una a continuación de la otra: el sufijo
+* terminado en '\0' seguido de su cantidad de repeticiones (sin alinear, por lo que se lee y escribe con memcpy).
+* Como las entradas cambian de dirección al ampliar la cubeta, sus cantidades no utilizan los contadores angostos de
+* contador.h; estos solo se usan para las palabras que terminan exactamente en un nodo.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "rafaga.h"
+#include "contador.h"
+#include "alfabeto.h"
+
+/**
+ * @struct cubeta
+ * @brief Modela una cubeta de sufijos con sus cantidades, sin un orden establecido.
+*/
+struct cubeta {
+    unsigned int cant_sufijos; //Cantidad de entradas de la cubeta.
+    unsigned int cant_bytes; //Bytes ocupados por las entradas.
+    unsigned int capacidad; //Bytes reservados para las entradas.
+    char entradas[]; //Entradas de la cubeta: sufijo, '\0' y cantidad (long long).
+};
+
+/**
+ * @struct nodo_rafaga
+ * @brief Modela un nodo del trie, cuyos hasta ALFABETO_TAMANIO hijos pueden ser nodos o cubetas según la máscara 'nodos'.
+*/
+struct nodo_rafaga {
+    contador_t cantidad; //Cantidad de veces que aparece la palabra que termina en este nodo (ver contador.h).
+    alfabeto_mascara_t nodos; //El bit i indica si siguiente[i] es un nodo (1) o una cubeta (0).
+    void *siguiente[ALFABETO_TAMANIO];
+};
+
+/**
+ * @struct rafaga
+ * @brief Modela el trie como su raiz (que representa a la cadena vacía) junto a la memoria reservada por sus partes.
+*/
+struct rafaga {
+    struct nodo_rafaga *raiz;
+    unsigned long cant_nodos; //Cantidad de nodos reservados (incluyendo la raiz).
+    unsigned long cant_cubetas; //Cantidad de cubetas reservadas.
+    unsigned long bytes_cubetas; //Bytes reservados por las cubetas, incluyendo sus encabezados.
+    tabla_contadores_t *desbordados; //Contadores de los nodos que no entran en su campo (NULL si no hay).
+};
+
+//Bytes que ocupa la entrada del sufijo dado.
+#define RAFAGA_BYTES_ENTRADA(sufijo) (strlen(sufijo) + 1 + sizeof(long long))
+
+/**
+ * @brief Construye un nodo sin hijos.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria.
+*/
+static struct nodo_rafaga *aux_crear_nodo(rafaga_t *r){
+    struct nodo_rafaga *N = (struct nodo_rafaga*) malloc(sizeof(struct nodo_rafaga));
+    if (N==NULL){
+        printf("Error %d: No se pudo reservar memoria para el nodo.\n", ERROR_RAFAGA_MEMORIA);
+        exit(ERROR_RAFAGA_MEMORIA);
+    }
+    N->cantidad = 0;
+    N->nodos = 0;
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        N->siguiente[i] = NULL;
+    }
+    r->cant_nodos = r->cant_nodos + 1;
+
+    return N;
+}
+
+/**
+ * @brief Agrega al final de la cubeta '*C' una entrada con el sufijo y la cantidad dados, sin comprobar si el sufijo ya
+ * estaba en ella. Si '*C' es NULL se crea la cubeta; si no hay espacio, se duplica su capacidad (por lo que '*C' puede cambiar).
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria.
+*/
+static void aux_agregar_entrada(rafaga_t *r, struct cubeta **C, char *sufijo, long long cantidad){
+    unsigned int longitud = strlen(sufijo);
+    unsigned int bytes = longitud + 1 + sizeof(long long);
+    struct cubeta *cubeta = *C;
+    unsigned int ocupados = (cubeta==NULL) ? 0 : cubeta->cant_bytes;
+    unsigned int capacidad = (cubeta==NULL) ? 0 : cubeta->capacidad;
+
+    if (ocupados + bytes > capacidad){
+        unsigned int capacidad_nueva = (capacidad==0) ? 32 : 2*capacidad;
+        while (ocupados + bytes > capacidad_nueva){
+            capacidad_nueva = 2*capacidad_nueva;
+        }
+        cubeta = (struct cubeta*) realloc(cubeta, sizeof(struct cubeta) + capacidad_nueva);
+        if (cubeta==NULL){
+            printf("Error %d: No se pudo reservar memoria para la cubeta.\n", ERROR_RAFAGA_MEMORIA);
+            exit(ERROR_RAFAGA_MEMORIA);
+        }
+        if (capacidad==0){
+            cubeta->cant_sufijos = 0;
+            cubeta->cant_bytes = 0;
+            r->cant_cubetas = r->cant_cubetas + 1;
+            r->bytes_cubetas = r->bytes_cubetas + sizeof(struct cubeta);
+        }
+        cubeta->capacidad = capacidad_nueva;
+        r->bytes_cubetas = r->bytes_cubetas + (capacidad_nueva - capacidad);
+        *C = cubeta;
+    }
+
+    memcpy(cubeta->entradas + cubeta->cant_bytes, sufijo, longitud + 1);
+    memcpy(cubeta->entradas + cubeta->cant_bytes + longitud + 1, &cantidad, sizeof(long long));
+    cubeta->cant_bytes = cubeta->cant_bytes + bytes;
+    cubeta->cant_sufijos = cubeta->cant_sufijos + 1;
+}
+
+/**
+ * @brief Busca el sufijo 's' en la cubeta C.
+ * @return Puntero a la cantidad (sin alinear) de la entrada del sufijo, o NULL si no está en la cubeta.
+*/
+static char *aux_buscar_entrada(struct cubeta *C, char *s){
+    char *to_return = NULL;
+    char *entrada = C->entradas;
+    char *fin = C->entradas + C->cant_bytes;
+
+    while (to_return==NULL && entrada<fin){
+        char *a = entrada;
+        char *b = s;
+        while (*a!='\0' && *a==*b){
+            a++;
+            b++;
+        }
+        if (*a==*b){
+            to_return = a + 1;
+        }
+        else{
+            //Se saltea el resto del sufijo y su cantidad.
+            while (*a!='\0'){
+                a++;
+            }
+            entrada = a + 1 + sizeof(long long);
+        }
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Reemplaza la cubeta C por un nodo, distribuyendo sus entradas en cubetas nuevas según su primer caracter.
+ * Las cubetas nuevas que a su vez superen el umbral también estallan.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria.
+ * @return Puntero al nodo que reemplaza a la cubeta (que se libera).
+*/
+static struct nodo_rafaga *aux_estallar(rafaga_t *r, struct cubeta *C){
+    struct nodo_rafaga *N = aux_crear_nodo(r);
+    char *entrada = C->entradas;
+    char *fin = C->entradas + C->cant_bytes;
+
+    while (entrada<fin){
+        unsigned int longitud = strlen(entrada);
+        long long cantidad;
+        memcpy(&cantidad, entrada + longitud + 1, sizeof(long long));
+
+        //El sufijo vacío corresponde a la palabra que termina en el nodo nuevo.
+        if (longitud==0){
+            contador_sumar(&(r->desbordados), &(N->cantidad), cantidad);
+        }
+        else{
+            struct cubeta *H = (struct cubeta*) N->siguiente[ALFABETO_POSICION(*entrada)];
+            aux_agregar_entrada(r, &H, entrada + 1, cantidad);
+            N->siguiente[ALFABETO_POSICION(*entrada)] = H;
+        }
+        entrada = entrada + longitud + 1 + sizeof(long long);
+    }
+
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        struct cubeta *H = (struct cubeta*) N->siguiente[i];
+        if (H!=NULL && H->cant_sufijos>RAFAGA_UMBRAL){
+            N->siguiente[i] = aux_estallar(r, H);
+            N->nodos = N->nodos | ((alfabeto_mascara_t) 1 << i);
+        }
+    }
+
+    r->cant_cubetas = r->cant_cubetas - 1;
+    r->bytes_cubetas = r->bytes_cubetas - (sizeof(struct cubeta) + C->capacidad);
+    free(C);
+
+    return N;
+}
+
+rafaga_t *rafaga_crear(){
+    rafaga_t *R = (struct rafaga*) malloc(sizeof(struct rafaga));
+    if (R==NULL){
+        printf("Error %d: No se pudo reservar memoria para el trie.\n", ERROR_RAFAGA_MEMORIA);
+        exit(ERROR_RAFAGA_MEMORIA);
+    }
+    R->cant_nodos = 0;
+    R->cant_cubetas = 0;
+    R->bytes_cubetas = 0;
+    R->desbordados = NULL;
+    R->raiz = aux_crear_nodo(R);
+
+    return R;
+}
+
+void rafaga_insertar(rafaga_t *r, char *s, long long cantidad){
+    struct nodo_rafaga *T = r->raiz;
+    int en_cubeta = FALSE;
+
+    ///Se desciende por los nodos mientras queden caracteres; el resto de la palabra se busca en la cubeta alcanzada.
+    while (en_cubeta==FALSE && *s!='\0'){
+        int pos = ALFABETO_POSICION(*s);
+        s++;
+        if ((T->nodos >> pos) & 1){
+            T = (struct nodo_rafaga*) T->siguiente[pos];
+        }
+        else{
+            struct cubeta *C = (struct cubeta*) T->siguiente[pos];
+            char *entrada = (C==NULL) ? NULL : aux_buscar_entrada(C, s);
+
+            if (entrada!=NULL){
+                long long valor;
+                memcpy(&valor, entrada, sizeof(long long));
+                valor = valor + cantidad;
+                memcpy(entrada, &valor, sizeof(long long));
+            }
+            else{
+                aux_agregar_entrada(r, &C, s, cantidad);
+                if (C->cant_sufijos>RAFAGA_UMBRAL){
+                    T->siguiente[pos] = aux_estallar(r, C);
+                    T->nodos = T->nodos | ((alfabeto_mascara_t) 1 << pos);
+                }
+                else{
+                    T->siguiente[pos] = C;
+                }
+            }
+            en_cubeta = TRUE;
+        }
+    }
+
+    if (en_cubeta==FALSE){
+        contador_sumar(&(r->desbordados), &(T->cantidad), cantidad);
+    }
+}
+
+long long rafaga_cantidad(rafaga_t *r, char *s){
+    long long cant_repeticiones = 0;
+    struct nodo_rafaga *T = r->raiz;
+    int en_cubeta = FALSE;
+
+    while (T!=NULL && en_cubeta==FALSE && *s!='\0'){
+        int pos = ALFABETO_POSICION(*s);
+        s++;
+        if ((T->nodos >> pos) & 1){
+            T = (struct nodo_rafaga*) T->siguiente[pos];
+        }
+        else{
+            struct cubeta *C = (struct cubeta*) T->siguiente[pos];
+            char *entrada = (C==NULL) ? NULL : aux_buscar_entrada(C, s);
+            if (entrada!=NULL){
+                memcpy(&cant_repeticiones, entrada, sizeof(long long));
+            }
+            en_cubeta = TRUE;
+        }
+    }
+
+    if (en_cubeta==FALSE){
+        cant_repeticiones = contador_valor(r->desbordados, &(T->cantidad));
+    }
+
+    return cant_repeticiones;
+}
+
+/**
+ * @struct recorrido_rafaga
+ * @brief Modela el estado del recorrido: la palabra construida hasta el momento, el arreglo en el que se ordenan los
+ * sufijos de una cubeta y la función a invocar.
+*/
+struct recorrido_rafaga {
+    rafaga_t *r;
+    char *palabra; //Palabra del nodo o cubeta actual.
+    unsigned long capacidad; //Capacidad del arreglo 'palabra'.
+    char **sufijos; //Entradas de la cubeta actual que se visitan, ordenadas por sufijo.
+    funcion_visita_t *visitar;
+    void *contexto;
+};
+
+/**
+ * @brief Amplía el arreglo de la palabra del recorrido para que admita 'longitud' caracteres más el '\0'.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra ampliar el arreglo.
+*/
+static void aux_asegurar_capacidad(struct recorrido_rafaga *R, unsigned long longitud){
+    if (longitud + 1 > R->capacidad){
+        while (longitud + 1 > R->capacidad){
+            R->capacidad = 2*R->capacidad;
+        }
+        R->palabra = (char*) realloc(R->palabra, R->capacidad*sizeof(char));
+        if (R->palabra==NULL){
+            printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_RAFAGA_MEMORIA);
+            exit(ERROR_RAFAGA_MEMORIA);
+        }
+    }
+}
+
+/**
+ * @brief Función de comparación de qsort para dos entradas de una cubeta, según el orden de strcmp de sus sufijos.
+*/
+static int aux_comparar_entradas(const void *a, const void *b){
+    return strcmp(*(char**) a, *(char**) b);
+}
+
+/**
+ * @brief Visita en orden lexicográfico las entradas de la cubeta C cuyo sufijo comienza con 'filtro'. La palabra de la
+ * cubeta ocupa los primeros 'longitud' caracteres de la palabra del recorrido.
+*/
+static void aux_recorrer_cubeta(struct recorrido_rafaga *R, struct cubeta *C, unsigned long longitud, char *filtro){
+    unsigned long longitud_filtro = strlen(filtro);
+    char *entrada = C->entradas;
+    char *fin = C->entradas + C->cant_bytes;
+    int cantidad = 0;
+
+    while (entrada<fin){
+        if (strncmp(entrada, filtro, longitud_filtro)==0){
+            R->sufijos[cantidad] = entrada;
+            cantidad++;
+        }
+        entrada = entrada + RAFAGA_BYTES_ENTRADA(entrada);
+    }
+    qsort(R->sufijos, cantidad, sizeof(char*), aux_comparar_entradas);
+
+    for (int i=0; i<cantidad; i++){
+        unsigned long longitud_sufijo = strlen(R->sufijos[i]);
+        long long valor;
+
+        aux_asegurar_capacidad(R, longitud + longitud_sufijo);
+        memcpy(R->palabra + longitud, R->sufijos[i], longitud_sufijo + 1);
+        memcpy(&valor, R->sufijos[i] + longitud_sufijo + 1, sizeof(long long));
+        R->visitar(R->palabra, valor, R->contexto);
+    }
+}
+
+/**
+ * @brief Recorre en orden lexicográfico el subárbol del nodo T, cuya palabra ocupa los primeros 'longitud' caracteres
+ * de la palabra del recorrido.
+*/
+static void aux_recorrer_nodo(struct recorrido_rafaga *R, struct nodo_rafaga *T, unsigned long longitud){
+    aux_asegurar_capacidad(R, longitud + 1);
+    R->palabra[longitud] = '\0';
+
+    //El prefijo se visita antes que sus extensiones, respetando el orden de strcmp.
+    if (T->cantidad>0){
+        R->visitar(R->palabra, contador_valor(R->r->desbordados, &(T->cantidad)), R->contexto);
+    }
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        if (T->siguiente[i]!=NULL){
+            R->palabra[longitud] = ALFABETO_CARACTER(i);
+            if ((T->nodos >> i) & 1){
+                aux_recorrer_nodo(R, (struct nodo_rafaga*) T->siguiente[i], longitud + 1);
+            }
+            else{
+                aux_recorrer_cubeta(R, (struct cubeta*) T->siguiente[i], longitud + 1, "");
+            }
+        }
+    }
+}
+
+void rafaga_recorrer(rafaga_t *r, funcion_visita_t visitar, void *contexto){
+    rafaga_recorrer_prefijo(r, "", visitar, contexto);
+}
+
+void rafaga_recorrer_prefijo(rafaga_t *r, char *prefijo, funcion_visita_t visitar, void *contexto){
+    unsigned long longitud_prefijo = strlen(prefijo);
+    struct recorrido_rafaga R = {r, NULL, longitud_prefijo+64, NULL, visitar, contexto};
+    struct nodo_rafaga *T = r->raiz;
+    unsigned long consumidos = 0;
+
+    //Ninguna cubeta supera el umbral más un sufijo, por lo que el arreglo de sufijos no necesita ampliarse.
+    R.palabra = (char*) malloc(R.capacidad*sizeof(char));
+    R.sufijos = (char**) malloc((RAFAGA_UMBRAL+1)*sizeof(char*));
+    if (R.palabra==NULL || R.sufijos==NULL){
+        printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_RAFAGA_MEMORIA);
+        exit(ERROR_RAFAGA_MEMORIA);
+    }
+    memcpy(R.palabra, prefijo, longitud_prefijo);
+
+    ///Se desciende por los nodos del prefijo; si se alcanza una cubeta, se visitan sus sufijos que continúan el prefijo.
+    while (T!=NULL && consumidos<longitud_prefijo){
+        int pos = ALFABETO_POSICION(prefijo[consumidos]);
+        consumidos++;
+        if ((T->nodos >> pos) & 1){
+            T = (struct nodo_rafaga*) T->siguiente[pos];
+        }
+        else{
+            if (T->siguiente[pos]!=NULL){
+                aux_recorrer_cubeta(&R, (struct cubeta*) T->siguiente[pos], consumidos, prefijo + consumidos);
+            }
+            T = NULL;
+        }
+    }
+    if (T!=NULL){
+        aux_recorrer_nodo(&R, T, longitud_prefijo);
+    }
+
+    free(R.palabra);
+    free(R.sufijos);
+}
+
+unsigned long rafaga_memoria(rafaga_t *r){
+    return r->cant_nodos*sizeof(struct nodo_rafaga) + r->bytes_cubetas + sizeof(struct rafaga) + contador_memoria(r->desbordados);
+}
+
+void rafaga_estadisticas(rafaga_t *r, unsigned long *cant_nodos, unsigned long *cant_cubetas){
+    *cant_nodos = r->cant_nodos;
+    *cant_cubetas = r->cant_cubetas;
+}
+
+/**
+ * @brief Elimina los nodos y cubetas descendientes del nodo dado de manera recursiva, dejando al nodo sin hijos.
+*/
+static void aux_eliminar_descendientes(struct nodo_rafaga *nodo){
+    for (int i=0; i<ALFABETO_TAMANIO; i++){
+        if (nodo->siguiente[i]!=NULL){
+            if ((nodo->nodos >> i) & 1){
+                aux_eliminar_descendientes((struct nodo_rafaga*) nodo->siguiente[i]);
+            }
+            free(nodo->siguiente[i]);
+            nodo->siguiente[i] = NULL;
+        }
+    }
+    nodo->nodos = 0;
+}
+
+void rafaga_vaciar(rafaga_t *r){
+    aux_eliminar_descendientes(r->raiz);
+    r->raiz->cantidad = 0;
+    r->cant_nodos = 1;
+    r->cant_cubetas = 0;
+    r->bytes_cubetas = 0;
+    contador_eliminar_tabla(&(r->desbordados));
+}
+
+void rafaga_eliminar(rafaga_t **r){
+    aux_eliminar_descendientes((*r)->raiz);
+    free((*r)->raiz);
+    contador_eliminar_tabla(&((*r)->desbordados));
+    free(*r);
+    *r = NULL;
+}
@@ -0,0 +1,99 @@
+/**
+* @file rafaga.h
+* @brief Archivo encabezado del TDA Rafaga.
+* Un trie de ráfagas (burst trie) conserva los primeros caracteres de las palabras en nodos con un hijo por caracter del
+* alfabeto, como el trie, pero guarda el resto de cada palabra junto a su cantidad en una cubeta: un arreglo contiguo de
+* sufijos en el que se busca linealmente. Cuando una cubeta supera RAFAGA_UMBRAL sufijos, estalla en un nodo cuyos hijos son cubetas nuevas,
+* una por cada primer caracter de sus sufijos. Así las regiones poco pobladas ocupan una cubeta en lugar de un nodo por
+* caracter, y los recorridos conservan el orden lexicográfico ordenando cada cubeta al visitarla.
+* Las palabras que recibe deben estar compuestas solo por caracteres del alfabeto (ver alfabeto.h).
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef RAFAGA_H_INCLUDED
+#define RAFAGA_H_INCLUDED
+
+#include "multiset.h"
+
+#define ERROR_RAFAGA_MEMORIA -29
+
+//Cantidad de sufijos a partir de la cual una cubeta estalla en un nodo. Puede redefinirse al compilar.
+#ifndef RAFAGA_UMBRAL
+#define RAFAGA_UMBRAL 64
+#endif
+
+struct rafaga;
+typedef struct rafaga rafaga_t;
+
+/**
+ * @brief Crea un trie de ráfagas vacío y lo devuelve.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria.
+ * @return Puntero al trie construido.
+*/
+extern rafaga_t *rafaga_crear();
+
+/**
+ * @brief Incrementa en 'cantidad' las repeticiones de la palabra 's', haciendo estallar su cubeta si supera el umbral.
+ * @param r Puntero al trie.
+ * @param s Puntero a la palabra (solo caracteres del alfabeto).
+ * @param cantidad Entero positivo a sumar.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria.
+*/
+extern void rafaga_insertar(rafaga_t *r, char *s, long long cantidad);
+
+/**
+ * @brief Devuelve la cantidad de repeticiones de la palabra 's' en el trie, o 0 si no está definida.
+ * @param r Puntero al trie.
+ * @param s Puntero a la palabra (solo caracteres del alfabeto).
+ * @return Entero mayor o igual a 0.
+*/
+extern long long rafaga_cantidad(rafaga_t *r, char *s);
+
+/**
+ * @brief Recorre las palabras del trie en orden lexicográfico e invoca a 'visitar' con cada una de ellas.
+ * @param r Puntero al trie.
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria para ordenar una cubeta.
+*/
+extern void rafaga_recorrer(rafaga_t *r, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Recorre en orden lexicográfico solo las palabras que comienzan con 'prefijo'.
+ * @param r Puntero al trie.
+ * @param prefijo Puntero al prefijo (solo caracteres del alfabeto).
+ * @param visitar Función que recibe cada palabra, su cantidad de repeticiones y el contexto dado.
+ * @param contexto Puntero a datos del invocador.
+ * @throw ERROR_RAFAGA_MEMORIA si no se logra reservar memoria para ordenar una cubeta.
+*/
+extern void rafaga_recorrer_prefijo(rafaga_t *r, char *prefijo, funcion_visita_t visitar, void *contexto);
+
+/**
+ * @brief Devuelve la cantidad de bytes reservados por los nodos, las cubetas y los contadores desbordados del trie.
+ * @param r Puntero al trie.
+ * @return Entero positivo con la cantidad de bytes en uso.
+*/
+extern unsigned long rafaga_memoria(rafaga_t *r);
+
+/**
+ * @brief Devuelve la cantidad de nodos (incluyendo la raiz) y de cubetas del trie.
+ * @param r Puntero al trie.
+ * @param cant_nodos Puntero donde se almacena la cantidad de nodos.
+ * @param cant_cubetas Puntero donde se almacena la cantidad de cubetas.
+*/
+extern void rafaga_estadisticas(rafaga_t *r, unsigned long *cant_nodos, unsigned long *cant_cubetas);
+
+/**
+ * @brief Remueve todas las palabras del trie, que queda vacío y puede seguir utilizándose.
+ * @param r Puntero al trie.
+*/
+extern void rafaga_vaciar(rafaga_t *r);
+
+/**
+ * @brief Elimina el trie liberando el espacio de memoria reservado. Luego de la invocacion 'r' debe NULL.
+ * @param r Puntero al puntero del trie.
+*/
+extern void rafaga_eliminar(rafaga_t **r);
+
+#endif // RAFAGA_H_INCLUDED
@@ -0,0 +1,639 @@
+/**
+* @file servidor.c
+* @brief Implementación del servidor de cuentapalabras.
+* Las ingestas leen cada archivo en un multiset propio sin tomar el candado, y solo toman el candado de escritura
+* para sumar dicho multiset a los totales y registrarlo, de modo que las consultas se bloqueen lo menos posible.
+* Si los multisets admiten instantáneas (ver multiset_instantanea), luego de cada archivo se publica una instantánea de
+* los totales y las consultas sobre ellos se resuelven en una instantánea propia, sin tomar el candado: las ingestas no
+* bloquean a las consultas de los totales, que nunca ven un archivo sumado a medias.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "servidor.h"
+
+#ifndef _WIN32
+
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "multiset.h"
+#include "lector.h"
+#include "protocolo.h"
+
+/**
+ * @struct servidor
+ * @brief Modela el estado residente del servidor.
+*/
+struct servidor {
+    multiset_t *total; ///Multiset con las palabras de todos los archivos ingestados.
+    char **nombres; ///Rutas de los archivos ingestados.
+    multiset_t **archivos; ///Multiset de cada archivo ingestado.
+    int cant_archivos; ///Cantidad de archivos ingestados.
+    int modo_multiset; ///Implementación de los multisets.
+    int fd_escucha; ///Socket en el que se aceptan conexiones.
+    volatile int detenido; ///TRUE una vez recibida una solicitud PROTOCOLO_DETENER.
+    pthread_rwlock_t candado; ///Candado de lectores y escritores sobre los multisets.
+    multiset_t *publicada; ///Última instantánea publicada de los totales (NULL si los multisets no admiten instantáneas).
+    pthread_mutex_t candado_ingesta; ///Candado que ordena las modificaciones de los totales cuando hay instantáneas.
+    pthread_mutex_t candado_publicada; ///Candado sobre el reemplazo de la instantánea publicada.
+    int cant_conexiones; ///Cantidad de conexiones atendidas, a lo sumo SERVIDOR_MAXIMO_CONEXIONES.
+    pthread_mutex_t candado_conexiones; ///Candado sobre 'cant_conexiones'.
+    pthread_cond_t hay_lugar; ///Se señala cuando termina la atención de una conexión.
+};
+typedef struct servidor servidor_t;
+
+/**
+ * @struct conexion
+ * @brief Modela los datos que recibe el hilo que atiende una conexión.
+*/
+struct conexion {
+    servidor_t *servidor;
+    int fd;
+};
+
+/**
+ * @struct respuesta
+ * @brief Modela el buffer donde se arma una respuesta antes de enviarla con una única escritura.
+*/
+struct respuesta {
+    char *datos;
+    unsigned long longitud;
+    unsigned long capacidad;
+    encabezado_respuesta_t encabezado;
+};
+
+/**
+ * @brief Agrega 'n' bytes al buffer de la respuesta.
+ * @throw ERROR_SERVIDOR_MEMORIA si no se pudo ampliar el buffer.
+*/
+static void aux_respuesta_agregar(struct respuesta *r, void *datos, unsigned long n){
+    if (r->longitud + n > r->capacidad){
+        while (r->longitud + n > r->capacidad){
+            r->capacidad = (r->capacidad==0) ? 4096 : 2*r->capacidad;
+        }
+        r->datos = (char*) realloc(r->datos, r->capacidad);
+        if (r->datos==NULL){
+            printf("Error %d: No se pudo reservar memoria para la respuesta.\n", ERROR_SERVIDOR_MEMORIA);
+            exit(ERROR_SERVIDOR_MEMORIA);
+        }
+    }
+    memcpy(r->datos + r->longitud, datos, n);
+    r->longitud = r->longitud + n;
+}
+
+/**
+ * @brief Función de visita que agrega la palabra y su cantidad como un registro de la respuesta recibida como contexto.
+*/
+static void aux_visitar_respuesta(char *palabra, long long cantidad, void *contexto){
+    struct respuesta *r = (struct respuesta*) contexto;
+    int64_t cantidad_64 = cantidad;
+    uint32_t longitud = strlen(palabra);
+
+    aux_respuesta_agregar(r, &cantidad_64, sizeof(cantidad_64));
+    aux_respuesta_agregar(r, &longitud, sizeof(longitud));
+    aux_respuesta_agregar(r, palabra, longitud);
+    r->encabezado.cant_registros = r->encabezado.cant_registros + 1;
+}
+
+//----INGESTA----
+
+/**
+ * @brief Función que recibe cada palabra leida y la inserta en el multiset recibido como contexto.
+*/
+static void aux_procesar_palabra(char *palabra, void *contexto){
+    multiset_insertar((multiset_t*) contexto, palabra);
+}
+
+/**
+ * @brief Función de visita que suma la palabra al multiset de totales recibido como contexto.
+*/
+static void aux_visitar_suma_total(char *palabra, long long cantidad, void *contexto){
+    multiset_insertar_cantidad((multiset_t*) contexto, palabra, cantidad);
+}
+
+/**
+ * @brief Toma el candado con el que se modifican los totales: si se publican instantáneas, las consultas no lo
+ * necesitan, por lo que solo se excluye a las demás ingestas; si no, se toma el candado de escritura.
+*/
+static void aux_bloquear_totales(servidor_t *S){
+    if (S->publicada!=NULL){
+        pthread_mutex_lock(&(S->candado_ingesta));
+    }
+    else{
+        pthread_rwlock_wrlock(&(S->candado));
+    }
+}
+
+/**
+ * @brief Libera el candado tomado con aux_bloquear_totales, publicando antes una instantánea de los totales si corresponde.
+*/
+static void aux_desbloquear_totales(servidor_t *S){
+    if (S->publicada!=NULL){
+        multiset_t *nueva = multiset_instantanea(S->total);
+        multiset_t *anterior;
+
+        pthread_mutex_lock(&(S->candado_publicada));
+        anterior = S->publicada;
+        S->publicada = nueva;
+        pthread_mutex_unlock(&(S->candado_publicada));
+        pthread_mutex_unlock(&(S->candado_ingesta));
+        //Las consultas que aún leen la instantánea anterior conservan la propia, por lo que puede eliminarse.
+        multiset_eliminar(&anterior);
+    }
+    else{
+        pthread_rwlock_unlock(&(S->candado));
+    }
+}
+
+/**
+ * @brief Lee el archivo de la ruta dada y lo registra en el servidor, sumando sus palabras a los totales.
+ * @return TRUE si el archivo se ingestó, FALSE si no se pudo abrir.
+*/
+static int aux_ingestar_archivo(servidor_t *S, char *path){
+    multiset_t *m = multiset_crear_modo(S->modo_multiset);
+    int to_return = lector_leer_archivo(path, aux_procesar_palabra, m);
+
+    if (to_return==TRUE){
+        //El multiset del archivo ya no recibe inserciones y solo será consultado: se reubica antes de compartirlo.
+        multiset_compactar(m);
+        char *nombre = (char*) malloc(strlen(path)+1);
+        if (nombre==NULL){
+            printf("Error %d: No se pudo reservar memoria para el nombre del archivo.\n", ERROR_SERVIDOR_MEMORIA);
+            exit(ERROR_SERVIDOR_MEMORIA);
+        }
+        strcpy(nombre, path);
+
+        aux_bloquear_totales(S);
+        multiset_recorrer(m, aux_visitar_suma_total, S->total);
+        aux_desbloquear_totales(S);
+
+        pthread_rwlock_wrlock(&(S->candado));
+        S->nombres = (char**) realloc(S->nombres, (S->cant_archivos+1)*sizeof(char*));
+        S->archivos = (multiset_t**) realloc(S->archivos, (S->cant_archivos+1)*sizeof(multiset_t*));
+        if (S->nombres==NULL || S->archivos==NULL){
+            printf("Error %d: No se pudo reservar memoria para los archivos.\n", ERROR_SERVIDOR_MEMORIA);
+            exit(ERROR_SERVIDOR_MEMORIA);
+        }
+        S->nombres[S->cant_archivos] = nombre;
+        S->archivos[S->cant_archivos] = m;
+        S->cant_archivos = S->cant_archivos + 1;
+        pthread_rwlock_unlock(&(S->candado));
+    }
+    else{
+        multiset_eliminar(&m);
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Ingesta la ruta dada: si es un directorio, cada archivo .txt que contiene; en caso contrario, el archivo en si mismo.
+ * @return Cantidad de archivos ingestados, o -1 si la ruta no existe.
+*/
+static int aux_ingestar(servidor_t *S, char *path){
+    int to_return = 0;
+    DIR *d = opendir(path);
+
+    if (d!=NULL){
+        struct dirent *dir = readdir(d);
+        while (dir!=NULL){
+            if (lector_es_archivo_txt(dir->d_name)==TRUE){
+                char ruta[strlen(path) + strlen(dir->d_name) + 2];
+                sprintf(ruta, "%s/%s", path, dir->d_name);
+                if (aux_ingestar_archivo(S, ruta)==TRUE){
+                    to_return = to_return + 1;
+                }
+            }
+            dir = readdir(d);
+        }
+        closedir(d);
+    }
+    else{
+        to_return = (aux_ingestar_archivo(S, path)==TRUE) ? 1 : -1;
+    }
+
+    //Los totales se reubican una vez por ingesta, y no por archivo, ya que la copia recorre el trie completo.
+    if (to_return>0){
+        aux_bloquear_totales(S);
+        multiset_compactar(S->total);
+        aux_desbloquear_totales(S);
+    }
+
+    return to_return;
+}
+
+//----CONSULTAS----
+
+/**
+ * @brief Devuelve una instantánea propia de los totales si el nombre del archivo es vacío y se publican instantáneas,
+ * que el invocador consulta sin tomar el candado y luego elimina.
+ * @return Puntero a la instantánea o NULL si la consulta requiere el candado.
+*/
+static multiset_t *aux_instantanea_consultada(servidor_t *S, char *archivo){
+    multiset_t *to_return = NULL;
+
+    if (archivo[0]=='\0' && S->publicada!=NULL){
+        pthread_mutex_lock(&(S->candado_publicada));
+        to_return = multiset_instantanea(S->publicada);
+        pthread_mutex_unlock(&(S->candado_publicada));
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Devuelve el multiset a consultar: el del archivo de nombre dado, o el de totales si el nombre es vacío.
+ * Requiere que el invocador tenga tomado el candado.
+ * @return Puntero al multiset o NULL si no hay un archivo con dicho nombre.
+*/
+static multiset_t *aux_multiset_consultado(servidor_t *S, char *archivo){
+    multiset_t *to_return = NULL;
+
+    if (archivo[0]=='\0'){
+        to_return = S->total;
+    }
+    else{
+        for (int i=0; i<S->cant_archivos && to_return==NULL; i++){
+            if (strcmp(S->nombres[i], archivo)==0){
+                to_return = S->archivos[i];
+            }
+        }
+    }
+
+    return to_return;
+}
+
+/**
+ * @struct top_k
+ * @brief Modela un heap de mínimos con las K mejores palabras vistas, donde la raiz es la peor de ellas.
+*/
+struct top_k {
+    elemento_t *elementos;
+    int cantidad;
+    int k;
+};
+
+/**
+ * @brief Indica si el elemento 'e1' es peor que 'e2': menos repeticiones o, a igual cantidad, lexicográficamente mayor.
+*/
+static int aux_es_peor(elemento_t *e1, elemento_t *e2){
+    return (e1->a < e2->a) || (e1->a==e2->a && strcmp(e1->b, e2->b)>0);
+}
+
+/**
+ * @brief Restablece la propiedad de heap a partir de la posición 'pos' hacia abajo.
+*/
+static void aux_top_hundir(struct top_k *T, int pos){
+    int terminado = FALSE;
+
+    while (terminado==FALSE){
+        int peor = pos;
+        int izq = 2*pos+1;
+        int der = 2*pos+2;
+        if (izq<T->cantidad && aux_es_peor(&T->elementos[izq], &T->elementos[peor])){
+            peor = izq;
+        }
+        if (der<T->cantidad && aux_es_peor(&T->elementos[der], &T->elementos[peor])){
+            peor = der;
+        }
+        if (peor==pos){
+            terminado = TRUE;
+        }
+        else{
+            elemento_t aux = T->elementos[pos];
+            T->elementos[pos] = T->elementos[peor];
+            T->elementos[peor] = aux;
+            pos = peor;
+        }
+    }
+}
+
+/**
+ * @brief Función de visita que conserva la palabra si está entre las K mejores vistas hasta el momento.
+*/
+static void aux_visitar_top(char *palabra, long long cantidad, void *contexto){
+    struct top_k *T = (struct top_k*) contexto;
+    elemento_t e = {cantidad, palabra};
+
+    if (T->cantidad<T->k || aux_es_peor(&T->elementos[0], &e)){
+        char *copia = (char*) malloc(strlen(palabra)+1);
+        if (copia==NULL){
+            printf("Error %d: No se pudo reservar memoria para la palabra.\n", ERROR_SERVIDOR_MEMORIA);
+            exit(ERROR_SERVIDOR_MEMORIA);
+        }
+        strcpy(copia, palabra);
+        e.b = copia;
+
+        if (T->cantidad<T->k){
+            //Se inserta al final y se reconstruye el heap cuando se completan los K lugares.
+            T->elementos[T->cantidad] = e;
+            T->cantidad = T->cantidad + 1;
+            if (T->cantidad==T->k){
+                for (int i=T->k/2-1; i>=0; i--){
+                    aux_top_hundir(T, i);
+                }
+            }
+        }
+        else{
+            free(T->elementos[0].b);
+            T->elementos[0] = e;
+            aux_top_hundir(T, 0);
+        }
+    }
+}
+
+/**
+ * @brief Agrega a la respuesta las K palabras del multiset con más repeticiones, de mayor a menor.
+*/
+static void aux_consultar_top(multiset_t *m, int k, struct respuesta *r){
+    struct top_k T = {NULL, 0, k};
+
+    T.elementos = (elemento_t*) malloc(k*sizeof(elemento_t) + 1);
+    if (T.elementos==NULL){
+        printf("Error %d: No se pudo reservar memoria para la consulta.\n", ERROR_SERVIDOR_MEMORIA);
+        exit(ERROR_SERVIDOR_MEMORIA);
+    }
+    multiset_recorrer(m, aux_visitar_top, &T);
+
+    //Si no se completaron los K lugares, el heap aún no fue construido.
+    if (T.cantidad<T.k){
+        for (int i=T.cantidad/2-1; i>=0; i--){
+            aux_top_hundir(&T, i);
+        }
+    }
+    //Se extrae la peor palabra repetidamente, ubicándola al final del arreglo.
+    int n = T.cantidad;
+    while (T.cantidad>1){
+        elemento_t aux = T.elementos[0];
+        T.elementos[0] = T.elementos[T.cantidad-1];
+        T.elementos[T.cantidad-1] = aux;
+        T.cantidad = T.cantidad - 1;
+        aux_top_hundir(&T, 0);
+    }
+    for (int i=0; i<n; i++){
+        aux_visitar_respuesta(T.elementos[i].b, T.elementos[i].a, r);
+        free(T.elementos[i].b);
+    }
+    free(T.elementos);
+}
+
+/**
+ * @brief Resuelve una solicitud y arma su respuesta.
+ * @param S Puntero al servidor.
+ * @param operacion Operación solicitada.
+ * @param archivo Nombre del archivo a consultar (vacío para los totales).
+ * @param argumento Argumento de la operación.
+ * @param r Puntero a la respuesta a armar.
+*/
+static void aux_resolver_solicitud(servidor_t *S, uint32_t operacion, char *archivo, char *argumento, struct respuesta *r){
+    if (operacion==PROTOCOLO_INGESTAR){
+        int cant_archivos = aux_ingestar(S, argumento);
+        if (cant_archivos<0){
+            r->encabezado.estado = PROTOCOLO_ERROR_ARCHIVO;
+        }
+        else{
+            aux_visitar_respuesta("", cant_archivos, r);
+        }
+    }
+    else if (operacion==PROTOCOLO_CANTIDAD || operacion==PROTOCOLO_TOP || operacion==PROTOCOLO_PREFIJO){
+        multiset_t *instantanea = aux_instantanea_consultada(S, archivo);
+        multiset_t *m = instantanea;
+        if (instantanea==NULL){
+            pthread_rwlock_rdlock(&(S->candado));
+            m = aux_multiset_consultado(S, archivo);
+        }
+
+        if (m==NULL){
+            r->encabezado.estado = PROTOCOLO_ERROR_ARCHIVO;
+        }
+        else if (operacion==PROTOCOLO_CANTIDAD){
+            aux_visitar_respuesta(argumento, multiset_cantidad(m, argumento), r);
+        }
+        else if (operacion==PROTOCOLO_TOP){
+            int k = atoi(argumento);
+            if (k>0){
+                aux_consultar_top(m, k, r);
+            }
+            else{
+                r->encabezado.estado = PROTOCOLO_ERROR_SOLICITUD;
+            }
+        }
+        else{
+            multiset_recorrer_prefijo(m, argumento, aux_visitar_respuesta, r);
+        }
+
+        if (instantanea!=NULL){
+            multiset_eliminar(&instantanea);
+        }
+        else{
+            pthread_rwlock_unlock(&(S->candado));
+        }
+    }
+    else if (operacion==PROTOCOLO_DETENER){
+        //La espera de nuevas conexiones se interrumpe luego de enviar la respuesta (ver aux_atender_conexion).
+        S->detenido = TRUE;
+    }
+    else{
+        r->encabezado.estado = PROTOCOLO_ERROR_SOLICITUD;
+    }
+}
+
+/**
+ * @brief Atiende las solicitudes de una conexión hasta que el cliente la cierre.
+ * @param datos Puntero a la estructura conexion del hilo, que se libera al finalizar.
+*/
+static void *aux_atender_conexion(void *datos){
+    struct conexion *C = (struct conexion*) datos;
+    encabezado_solicitud_t encabezado;
+    struct respuesta r = {NULL, 0, 0, {PROTOCOLO_OK, 0}};
+    char archivo[PROTOCOLO_LONGITUD_MAXIMA+1];
+    char argumento[PROTOCOLO_LONGITUD_MAXIMA+1];
+    int activa = TRUE;
+
+    while (activa==TRUE && protocolo_leer(C->fd, &encabezado, sizeof(encabezado))==TRUE){
+        if (encabezado.longitud_archivo>PROTOCOLO_LONGITUD_MAXIMA || encabezado.longitud_argumento>PROTOCOLO_LONGITUD_MAXIMA){
+            activa = FALSE;
+        }
+        else if (protocolo_leer(C->fd, archivo, encabezado.longitud_archivo)==FALSE || protocolo_leer(C->fd, argumento, encabezado.longitud_argumento)==FALSE){
+            activa = FALSE;
+        }
+        else{
+            archivo[encabezado.longitud_archivo] = '\0';
+            argumento[encabezado.longitud_argumento] = '\0';
+
+            //El buffer de la respuesta se reutiliza entre solicitudes; el encabezado ocupa sus primeros bytes.
+            r.longitud = 0;
+            r.encabezado.estado = PROTOCOLO_OK;
+            r.encabezado.cant_registros = 0;
+            aux_respuesta_agregar(&r, &(r.encabezado), sizeof(encabezado_respuesta_t));
+            aux_resolver_solicitud(C->servidor, encabezado.operacion, archivo, argumento, &r);
+            memcpy(r.datos, &(r.encabezado), sizeof(encabezado_respuesta_t));
+
+            activa = protocolo_escribir(C->fd, r.datos, r.longitud);
+            if (encabezado.operacion==PROTOCOLO_DETENER){
+                //Se interrumpe la espera de nuevas conexiones una vez confirmada la detención al cliente.
+                shutdown(C->servidor->fd_escucha, SHUT_RDWR);
+                activa = FALSE;
+            }
+        }
+    }
+
+    close(C->fd);
+    free(r.datos);
+
+    pthread_mutex_lock(&(C->servidor->candado_conexiones));
+    C->servidor->cant_conexiones = C->servidor->cant_conexiones - 1;
+    pthread_cond_signal(&(C->servidor->hay_lugar));
+    pthread_mutex_unlock(&(C->servidor->candado_conexiones));
+    free(C);
+
+    return NULL;
+}
+
+/**
+ * @brief Espera a que la cantidad de conexiones atendidas sea menor que SERVIDOR_MAXIMO_CONEXIONES y reserva un lugar.
+*/
+static void aux_reservar_conexion(servidor_t *S){
+    pthread_mutex_lock(&(S->candado_conexiones));
+    while (S->cant_conexiones>=SERVIDOR_MAXIMO_CONEXIONES){
+        pthread_cond_wait(&(S->hay_lugar), &(S->candado_conexiones));
+    }
+    S->cant_conexiones = S->cant_conexiones + 1;
+    pthread_mutex_unlock(&(S->candado_conexiones));
+}
+
+/**
+ * @brief Libera el lugar reservado para una conexión que no llegó a atenderse.
+*/
+static void aux_liberar_conexion(servidor_t *S){
+    pthread_mutex_lock(&(S->candado_conexiones));
+    S->cant_conexiones = S->cant_conexiones - 1;
+    pthread_mutex_unlock(&(S->candado_conexiones));
+}
+
+/**
+ * @brief Acepta una conexión en el socket de escucha. Los errores transitorios se reintentan: los de interrupción de
+ * inmediato y los de falta de recursos (descriptores o memoria del sistema) luego de una espera que se duplica en cada
+ * intento, hasta un segundo, avisándolo una vez.
+ * @throw ERROR_SERVIDOR_SOCKET si el socket dejó de poder aceptar conexiones sin que se haya pedido la detención.
+ * @return Descriptor de la conexión, o -1 si el servidor se detuvo.
+*/
+static int aux_aceptar(servidor_t *S){
+    int to_return = -1;
+    long espera_ms = 0;
+
+    while (to_return<0 && S->detenido==FALSE){
+        to_return = accept(S->fd_escucha, NULL, NULL);
+        if (to_return<0 && S->detenido==FALSE){
+            if (errno==EMFILE || errno==ENFILE || errno==ENOBUFS || errno==ENOMEM){
+                struct timespec t;
+                if (espera_ms==0){
+                    printf("Aviso: No se pueden aceptar conexiones por falta de recursos (errno %d); se reintentara.\n", errno);
+                    fflush(stdout);
+                }
+                espera_ms = (espera_ms==0) ? 10 : ((2*espera_ms>1000) ? 1000 : 2*espera_ms);
+                t.tv_sec = espera_ms/1000;
+                t.tv_nsec = (espera_ms%1000)*1000000L;
+                nanosleep(&t, NULL);
+            }
+            else if (errno!=EINTR && errno!=ECONNABORTED){
+                printf("Error %d: No se pudo aceptar una conexion (errno %d).\n", ERROR_SERVIDOR_SOCKET, errno);
+                exit(ERROR_SERVIDOR_SOCKET);
+            }
+        }
+    }
+
+    return to_return;
+}
+
+void servidor_ejecutar(char *path_socket, int modo_multiset){
+    servidor_t S;
+    struct sockaddr_un direccion;
+
+    S.total = multiset_crear_modo(modo_multiset);
+    S.nombres = NULL;
+    S.archivos = NULL;
+    S.cant_archivos = 0;
+    S.modo_multiset = modo_multiset;
+    S.detenido = FALSE;
+    pthread_rwlock_init(&(S.candado), NULL);
+    pthread_mutex_init(&(S.candado_ingesta), NULL);
+    pthread_mutex_init(&(S.candado_publicada), NULL);
+    S.cant_conexiones = 0;
+    pthread_mutex_init(&(S.candado_conexiones), NULL);
+    pthread_cond_init(&(S.hay_lugar), NULL);
+    //Es NULL si los multisets no admiten instantáneas, en cuyo caso las consultas de los totales toman el candado.
+    S.publicada = multiset_instantanea(S.total);
+
+    ///Crea el socket de escucha en la ruta dada, reemplazando un socket previo si existe.
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (strlen(path_socket)>=sizeof(direccion.sun_path)){
+        printf("Error %d: La ruta del socket es demasiado larga.\n", ERROR_SERVIDOR_SOCKET);
+        exit(ERROR_SERVIDOR_SOCKET);
+    }
+    strcpy(direccion.sun_path, path_socket);
+    unlink(path_socket);
+
+    S.fd_escucha = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (S.fd_escucha<0 || bind(S.fd_escucha, (struct sockaddr*) &direccion, sizeof(direccion))<0 || listen(S.fd_escucha, 128)<0){
+        printf("Error %d: No se pudo crear el socket '%s'.\n", ERROR_SERVIDOR_SOCKET, path_socket);
+        exit(ERROR_SERVIDOR_SOCKET);
+    }
+    printf("Servidor escuchando en '%s'.\n", path_socket);
+    fflush(stdout);
+
+    ///Cada conexión aceptada se atiende en un hilo propio, reservando antes su lugar entre las atendidas.
+    while (S.detenido==FALSE){
+        int fd;
+        aux_reservar_conexion(&S);
+        fd = aux_aceptar(&S);
+        if (fd<0){
+            aux_liberar_conexion(&S);
+        }
+        else{
+            struct conexion *C = (struct conexion*) malloc(sizeof(struct conexion));
+            pthread_t hilo;
+            if (C==NULL){
+                printf("Error %d: No se pudo reservar memoria para la conexion.\n", ERROR_SERVIDOR_MEMORIA);
+                exit(ERROR_SERVIDOR_MEMORIA);
+            }
+            C->servidor = &S;
+            C->fd = fd;
+            if (pthread_create(&hilo, NULL, aux_atender_conexion, C)==0){
+                pthread_detach(hilo);
+            }
+            else{
+                close(fd);
+                free(C);
+                aux_liberar_conexion(&S);
+            }
+        }
+    }
+
+    close(S.fd_escucha);
+    unlink(path_socket);
+    printf("Servidor detenido.\n");
+
+    //Los hilos de conexiones aún abiertas pueden seguir consultando los multisets, por lo que no se liberan.
+    //El sistema operativo recupera la memoria al finalizar el proceso.
+}
+
+#else
+
+void servidor_ejecutar(char *path_socket, int modo_multiset){
+    printf("Error %d: El modo servidor requiere sockets de dominio Unix, no disponibles en esta plataforma.\n", ERROR_SERVIDOR_SOCKET);
+    exit(ERROR_SERVIDOR_SOCKET);
+}
+
+#endif // _WIN32
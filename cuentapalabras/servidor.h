@@ -0,0 +1,32 @@
+/**
+* @file servidor.h
+* @brief Archivo encabezado del servidor de cuentapalabras.
+* El servidor mantiene en memoria un multiset por cada archivo ingestado y el multiset de totales, y atiende
+* solicitudes de ingesta y de consulta sobre un socket local de dominio Unix (ver protocolo.h).
+* Cada conexión es atendida por un hilo propio; las consultas se realizan en paralelo y las ingestas de forma exclusiva.
+* Se atienden a lo sumo SERVIDOR_MAXIMO_CONEXIONES conexiones a la vez: las demás esperan en la cola del socket.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef SERVIDOR_H_INCLUDED
+#define SERVIDOR_H_INCLUDED
+
+#define ERROR_SERVIDOR_SOCKET -17
+#define ERROR_SERVIDOR_MEMORIA -18
+
+//Cantidad máxima de conexiones atendidas a la vez. Puede redefinirse al compilar.
+#ifndef SERVIDOR_MAXIMO_CONEXIONES
+#define SERVIDOR_MAXIMO_CONEXIONES 64
+#endif
+
+/**
+ * @brief Ejecuta el servidor escuchando en el socket de la ruta dada, hasta recibir una solicitud PROTOCOLO_DETENER.
+ * @param path_socket Puntero a cadena de caracteres con la ruta del socket a crear.
+ * @param modo_multiset Implementación de los multisets (MULTISET_MODO_TRIE o MULTISET_MODO_COMPACTO).
+ * @throw ERROR_SERVIDOR_SOCKET si no se pudo crear el socket o dejó de poder aceptar conexiones.
+ * @throw ERROR_SERVIDOR_MEMORIA si no se pudo reservar memoria.
+*/
+extern void servidor_ejecutar(char *path_socket, int modo_multiset);
+
+#endif // SERVIDOR_H_INCLUDED
@@ -0,0 +1,219 @@
+/**
+* @file topologia.c
+* @brief Implementación del TDA Topologia.
+* No depende de libnuma: los nodos se leen de sysfs y las páginas se consultan con la llamada al sistema move_pages,
+* que sin nodos de destino solo informa la ubicación de cada página.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "define.h"
+#include "topologia.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//Mayor cantidad de nodos que se buscan en sysfs.
+#define TOPOLOGIA_MAXIMO_NODOS 256
+//Mayor cantidad de páginas que se consultan por región.
+#define TOPOLOGIA_MUESTRA_PAGINAS 4096
+
+/**
+ * @struct topologia
+ * @brief Modela los nodos de la máquina, cada uno con la lista de sus procesadores.
+*/
+struct topologia {
+    int cant_nodos;
+    int *cant_cpus; //Cantidad de procesadores de cada nodo.
+    int **cpus; //Procesadores de cada nodo.
+    int *ids; //Número de cada nodo en el sistema (los nodos pueden no ser consecutivos).
+};
+
+/**
+ * @brief Operación Agrega el procesador 'cpu' al último nodo de la topología.
+ * @throw ERROR_TOPOLOGIA_MEMORIA si no se logra reservar memoria.
+*/
+static void aux_agregar_cpu(topologia_t *t, int cpu){
+    int n = t->cant_nodos-1;
+    t->cpus[n] = (int*) realloc(t->cpus[n], (t->cant_cpus[n]+1)*sizeof(int));
+    if (t->cpus[n]==NULL){
+        printf("Error %d: No se pudo reservar memoria para la topologia.\n", ERROR_TOPOLOGIA_MEMORIA);
+        exit(ERROR_TOPOLOGIA_MEMORIA);
+    }
+    t->cpus[n][t->cant_cpus[n]] = cpu;
+    t->cant_cpus[n] = t->cant_cpus[n] + 1;
+}
+
+/**
+ * @brief Operación Agrega a la topología un nodo sin procesadores.
+ * @throw ERROR_TOPOLOGIA_MEMORIA si no se logra reservar memoria.
+*/
+static void aux_agregar_nodo(topologia_t *t, int id){
+    t->cant_cpus = (int*) realloc(t->cant_cpus, (t->cant_nodos+1)*sizeof(int));
+    t->cpus = (int**) realloc(t->cpus, (t->cant_nodos+1)*sizeof(int*));
+    t->ids = (int*) realloc(t->ids, (t->cant_nodos+1)*sizeof(int));
+    if (t->cant_cpus==NULL || t->cpus==NULL || t->ids==NULL){
+        printf("Error %d: No se pudo reservar memoria para la topologia.\n", ERROR_TOPOLOGIA_MEMORIA);
+        exit(ERROR_TOPOLOGIA_MEMORIA);
+    }
+    t->cant_cpus[t->cant_nodos] = 0;
+    t->cpus[t->cant_nodos] = NULL;
+    t->ids[t->cant_nodos] = id;
+    t->cant_nodos = t->cant_nodos + 1;
+}
+
+/**
+ * @brief Operación Lee la lista de procesadores de un nodo (por ejemplo, "0-3,8-11") y los agrega al último nodo.
+ * @return TRUE si el archivo existe, FALSE en caso contrario.
+*/
+static int aux_leer_lista_cpus(topologia_t *t, char *path){
+    FILE *f = fopen(path, "r");
+    int to_return = FALSE;
+
+    if (f!=NULL){
+        int desde, hasta;
+        char separador = ',';
+        to_return = TRUE;
+        while (separador==',' && fscanf(f, "%d", &desde)==1){
+            hasta = desde;
+            if (fscanf(f, "%c", &separador)==1 && separador=='-'){
+                if (fscanf(f, "%d", &hasta)!=1 || fscanf(f, "%c", &separador)!=1){
+                    separador = '\n';
+                }
+            }
+            for (int cpu=desde; cpu<=hasta; cpu++){
+                aux_agregar_cpu(t, cpu);
+            }
+        }
+        fclose(f);
+    }
+
+    return to_return;
+}
+
+topologia_t *topologia_detectar(){
+    topologia_t *t = (topologia_t*) malloc(sizeof(struct topologia));
+    if (t==NULL){
+        printf("Error %d: No se pudo reservar memoria para la topologia.\n", ERROR_TOPOLOGIA_MEMORIA);
+        exit(ERROR_TOPOLOGIA_MEMORIA);
+    }
+    t->cant_nodos = 0;
+    t->cant_cpus = NULL;
+    t->cpus = NULL;
+    t->ids = NULL;
+
+#ifdef __linux__
+    for (int id=0; id<TOPOLOGIA_MAXIMO_NODOS; id++){
+        char path[64];
+        sprintf(path, "/sys/devices/system/node/node%d/cpulist", id);
+        aux_agregar_nodo(t, id);
+        //Los nodos inexistentes o sin procesadores (solo memoria) se descartan.
+        if (aux_leer_lista_cpus(t, path)==FALSE || t->cant_cpus[t->cant_nodos-1]==0){
+            free(t->cpus[t->cant_nodos-1]);
+            t->cant_nodos = t->cant_nodos - 1;
+        }
+    }
+#endif
+
+    //Sin información de nodos, se modela un único nodo con todos los procesadores.
+    if (t->cant_nodos==0){
+        int cant_cpus = 1;
+#ifndef _WIN32
+        cant_cpus = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        aux_agregar_nodo(t, 0);
+        for (int cpu=0; cpu<cant_cpus || cpu==0; cpu++){
+            aux_agregar_cpu(t, cpu);
+        }
+    }
+
+    return t;
+}
+
+int topologia_cantidad_nodos(topologia_t *t){
+    return t->cant_nodos;
+}
+
+int topologia_ubicar_trabajador(topologia_t *t, int trabajador, int cant_trabajadores, int *cpu){
+    //Los trabajadores se reparten en bloques contiguos por nodo; si hay más nodos que trabajadores, se usan los primeros.
+    int nodos_en_uso = (cant_trabajadores<t->cant_nodos) ? cant_trabajadores : t->cant_nodos;
+    int n = (int) (((long) trabajador * nodos_en_uso) / cant_trabajadores);
+    int primero_del_nodo = (int) (((long) n * cant_trabajadores + nodos_en_uso - 1) / nodos_en_uso);
+
+    *cpu = t->cpus[n][(trabajador - primero_del_nodo) % t->cant_cpus[n]];
+
+    return t->ids[n];
+}
+
+int topologia_fijar_cpu(int cpu){
+    int to_return = FALSE;
+
+#ifdef __linux__
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpu, &conjunto);
+    to_return = (sched_setaffinity(0, sizeof(conjunto), &conjunto)==0) ? TRUE : FALSE;
+#else
+    (void) cpu;
+#endif
+
+    return to_return;
+}
+
+void topologia_contar_paginas(void *inicio, unsigned long bytes, int nodo, unsigned long *locales, unsigned long *remotas){
+    *locales = 0;
+    *remotas = 0;
+
+#if defined(__linux__) && defined(__NR_move_pages)
+    unsigned long tamanio_pagina = (unsigned long) sysconf(_SC_PAGESIZE);
+    unsigned long primera = ((unsigned long) inicio) / tamanio_pagina;
+    unsigned long cant_paginas = (bytes==0) ? 0 : (((unsigned long) inicio) + bytes - 1) / tamanio_pagina - primera + 1;
+    unsigned long cant_muestra = (cant_paginas<TOPOLOGIA_MUESTRA_PAGINAS) ? cant_paginas : TOPOLOGIA_MUESTRA_PAGINAS;
+    void **paginas = (void**) malloc(cant_muestra*sizeof(void*));
+    int *estados = (int*) malloc(cant_muestra*sizeof(int));
+
+    if (cant_muestra>0 && paginas!=NULL && estados!=NULL){
+        for (unsigned long i=0; i<cant_muestra; i++){
+            paginas[i] = (void*) ((primera + i*cant_paginas/cant_muestra) * tamanio_pagina);
+        }
+        //Sin nodos de destino, move_pages solo informa en 'estados' el nodo de cada página (o un error si no está presente).
+        if (syscall(__NR_move_pages, 0, cant_muestra, paginas, NULL, estados, 0)==0){
+            for (unsigned long i=0; i<cant_muestra; i++){
+                if (estados[i]==nodo){
+                    *locales = *locales + 1;
+                }
+                else if (estados[i]>=0){
+                    *remotas = *remotas + 1;
+                }
+            }
+        }
+    }
+    free(paginas);
+    free(estados);
+#else
+    (void) inicio;
+    (void) bytes;
+    (void) nodo;
+#endif
+}
+
+void topologia_eliminar(topologia_t **t){
+    for (int i=0; i<(*t)->cant_nodos; i++){
+        free((*t)->cpus[i]);
+    }
+    free((*t)->cant_cpus);
+    free((*t)->cpus);
+    free((*t)->ids);
+    free(*t);
+    *t = NULL;
+}
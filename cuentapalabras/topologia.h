@@ -0,0 +1,67 @@
+/**
+* @file topologia.h
+* @brief Archivo encabezado del TDA Topologia.
+* Describe los nodos NUMA de la máquina y sus procesadores, según /sys/devices/system/node en Linux, y permite fijar un
+* hilo a un procesador y consultar en qué nodo residen las páginas de una región de memoria.
+* Si la topología no está disponible (otro sistema, o un núcleo sin NUMA), se modela un único nodo con todos los
+* procesadores en línea, y fijar un hilo o consultar páginas no tiene efecto.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef TOPOLOGIA_H_INCLUDED
+#define TOPOLOGIA_H_INCLUDED
+
+#define ERROR_TOPOLOGIA_MEMORIA -24
+
+struct topologia;
+typedef struct topologia topologia_t;
+
+/**
+ * @brief Detecta los nodos de la máquina y sus procesadores.
+ * @throw ERROR_TOPOLOGIA_MEMORIA si no se logra reservar memoria.
+ * @return Puntero a la topología detectada, con al menos un nodo y un procesador.
+*/
+extern topologia_t *topologia_detectar();
+
+/**
+ * @brief Devuelve la cantidad de nodos de la topología 't'.
+*/
+extern int topologia_cantidad_nodos(topologia_t *t);
+
+/**
+ * @brief Devuelve el nodo y el procesador donde ubicar al trabajador de índice 'trabajador'. Los trabajadores se reparten
+ * entre los nodos en bloques contiguos (los primeros en el nodo 0, los siguientes en el 1, etc.) y, dentro de cada nodo,
+ * entre sus procesadores, de modo que los trabajadores de índices cercanos compartan nodo.
+ * @param t Puntero a la topología.
+ * @param trabajador Índice del trabajador, entre 0 y cant_trabajadores-1.
+ * @param cant_trabajadores Cantidad total de trabajadores.
+ * @param cpu Puntero donde se almacena el procesador asignado.
+ * @return Nodo asignado.
+*/
+extern int topologia_ubicar_trabajador(topologia_t *t, int trabajador, int cant_trabajadores, int *cpu);
+
+/**
+ * @brief Fija el hilo invocador al procesador 'cpu'. En Linux, la memoria que el hilo reserve y escriba por primera vez
+ * se ubica entonces en el nodo de dicho procesador.
+ * @return TRUE si el hilo quedó fijado, FALSE en caso contrario.
+*/
+extern int topologia_fijar_cpu(int cpu);
+
+/**
+ * @brief Cuenta cuantas páginas de la región dada residen en el nodo 'nodo' y cuantas en otros nodos.
+ * En regiones grandes se consulta una muestra de páginas equiespaciadas.
+ * @param inicio Puntero al inicio de la región.
+ * @param bytes Tamaño de la región.
+ * @param nodo Nodo considerado local.
+ * @param locales Puntero donde se almacena la cantidad de páginas consultadas que residen en 'nodo'.
+ * @param remotas Puntero donde se almacena la cantidad de páginas consultadas que residen en otro nodo.
+*/
+extern void topologia_contar_paginas(void *inicio, unsigned long bytes, int nodo, unsigned long *locales, unsigned long *remotas);
+
+/**
+ * @brief Elimina la topología liberando la memoria reservada. Luego de la invocación '*t' es NULL.
+*/
+extern void topologia_eliminar(topologia_t **t);
+
+#endif // TOPOLOGIA_H_INCLUDED
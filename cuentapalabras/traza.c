@@ -0,0 +1,294 @@
+/**
+* @file traza.c
+* @brief Implementación del TDA Traza.
+* Los búferes de los hilos forman una lista enlazada en la que cada hilo se agrega, la primera vez que registra un
+* evento, mediante una operación atómica. Solo el hilo dueño escribe en su búfer, por lo que registrar un evento no
+* toma candados. Como el escritor final se invoca con atexit, otros hilos pueden seguir registrando eventos (por
+* ejemplo, si un hilo trabajador invocó a exit). Por eso cada registro se anuncia en un contador atómico: el escritor
+* deshabilita la traza, espera a que no haya registros en curso y recién entonces lee y libera los búferes, que ya no
+* se vuelven a usar.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <sched.h>
+#endif
+#include "define.h"
+#include "traza.h"
+
+/**
+ * @struct evento_traza
+ * @brief Modela un evento: el comienzo ('B') o el fin ('E') de una fase en un instante, en nanosegundos.
+*/
+struct evento_traza {
+    long long instante;
+    const char *fase;
+    char tipo;
+    char detalle[TRAZA_LONGITUD_DETALLE+1];
+};
+
+/**
+ * @struct bufer_traza
+ * @brief Modela el búfer de eventos de un hilo. Las fases de un hilo se anidan, por lo que las fases abiertas forman
+ * una pila: las 'registradas' más externas tienen su comienzo en el búfer y las demás se descartaron por estar lleno.
+ * Un comienzo solo se registra si queda lugar para él, para su fin y para el fin de las fases registradas abiertas.
+*/
+struct bufer_traza {
+    struct evento_traza *eventos;
+    unsigned long cantidad; ///Eventos registrados, a lo sumo TRAZA_EVENTOS_POR_HILO.
+    unsigned long abiertas; ///Fases comenzadas y aún no terminadas.
+    unsigned long registradas; ///Fases abiertas cuyo comienzo se registró.
+    unsigned long long descartados; ///Eventos que no se registraron por estar lleno el búfer.
+    int hilo; ///Número del hilo en la traza, en el orden en que registró su primer evento.
+    struct bufer_traza *siguiente;
+};
+
+//Indica si la traza está habilitada.
+static int habilitada = FALSE;
+//Cantidad de hilos que están registrando un evento.
+static int registrando = 0;
+//Archivo donde se escribe la traza al finalizar.
+static char *path_traza = NULL;
+//Instante en que se habilitó la traza, a partir del cual se miden los eventos.
+static long long instante_inicial = 0;
+//Lista de los búferes de los hilos y cantidad de hilos que registraron eventos.
+static struct bufer_traza *buferes = NULL;
+static int cant_hilos = 0;
+//Búfer del hilo invocador (NULL hasta su primer evento).
+static __thread struct bufer_traza *bufer_hilo = NULL;
+
+/**
+ * @brief Devuelve el instante actual en nanosegundos desde un instante fijo.
+*/
+static long long aux_instante(){
+#ifndef _WIN32
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((long long) t.tv_sec)*1000000000LL + t.tv_nsec;
+#else
+    return ((long long) clock())*(1000000000LL/CLOCKS_PER_SEC);
+#endif
+}
+
+/**
+ * @brief Devuelve el búfer del hilo invocador, creándolo y agregándolo a la lista si es su primer evento.
+ * @throw ERROR_TRAZA_MEMORIA si no se pudo reservar memoria para el búfer.
+*/
+static struct bufer_traza *aux_bufer_del_hilo(){
+    if (bufer_hilo==NULL){
+        struct bufer_traza *B = (struct bufer_traza*) malloc(sizeof(struct bufer_traza));
+        if (B!=NULL){
+            B->eventos = (struct evento_traza*) malloc(TRAZA_EVENTOS_POR_HILO*sizeof(struct evento_traza));
+        }
+        if (B==NULL || B->eventos==NULL){
+            //El registro en curso termina aquí, para que el escritor final no lo espere.
+            __atomic_sub_fetch(&registrando, 1, __ATOMIC_RELEASE);
+            printf("Error %d: No se pudo reservar memoria para la traza.\n", ERROR_TRAZA_MEMORIA);
+            exit(ERROR_TRAZA_MEMORIA);
+        }
+        B->cantidad = 0;
+        B->abiertas = 0;
+        B->registradas = 0;
+        B->descartados = 0;
+        B->hilo = __atomic_add_fetch(&cant_hilos, 1, __ATOMIC_RELAXED);
+        B->siguiente = __atomic_load_n(&buferes, __ATOMIC_RELAXED);
+        while (__atomic_compare_exchange_n(&buferes, &(B->siguiente), B, FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED)==FALSE){
+            //Otro hilo se agregó antes: 'B->siguiente' ya tiene la nueva cabeza de la lista.
+        }
+        bufer_hilo = B;
+    }
+
+    return bufer_hilo;
+}
+
+/**
+ * @brief Decide si el evento dado se registra en el búfer B, actualizando su pila de fases abiertas y, si no se
+ * registra, la cuenta de descartados.
+ * @return TRUE si el evento debe registrarse, FALSE si no.
+*/
+static int aux_admitir(struct bufer_traza *B, char tipo){
+    int to_return = FALSE;
+
+    if (tipo=='B'){
+        //Las fases registradas son las más externas: dentro de una descartada tampoco se registra.
+        if (B->abiertas==B->registradas && B->cantidad + B->registradas + 2 <= TRAZA_EVENTOS_POR_HILO){
+            B->registradas = B->registradas + 1;
+            to_return = TRUE;
+        }
+        B->abiertas = B->abiertas + 1;
+    }
+    else if (B->abiertas>0){
+        //El fin se registra si su comienzo se registró, para lo cual se reservó su lugar.
+        if (B->abiertas==B->registradas){
+            B->registradas = B->registradas - 1;
+            to_return = TRUE;
+        }
+        B->abiertas = B->abiertas - 1;
+    }
+    if (to_return==FALSE){
+        __atomic_store_n(&(B->descartados), B->descartados+1, __ATOMIC_RELAXED);
+    }
+
+    return to_return;
+}
+
+/**
+ * @brief Registra un evento en el búfer del hilo invocador, si la traza sigue habilitada y corresponde (ver aux_admitir).
+*/
+static void aux_registrar(char tipo, const char *fase, const char *detalle){
+    //El anuncio precede a la consulta: si el escritor final ya deshabilitó la traza, el búfer no se toca.
+    __atomic_add_fetch(&registrando, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&habilitada, __ATOMIC_SEQ_CST)==TRUE){
+        struct bufer_traza *B = aux_bufer_del_hilo();
+        if (aux_admitir(B, tipo)==TRUE){
+            struct evento_traza *e = &(B->eventos[B->cantidad]);
+            e->instante = aux_instante();
+            e->fase = fase;
+            e->tipo = tipo;
+            e->detalle[0] = '\0';
+            if (detalle!=NULL){
+                unsigned long longitud = strlen(detalle);
+                //De un detalle largo se conservan los últimos caracteres, sin comenzar a la mitad de un caracter UTF-8.
+                if (longitud>TRAZA_LONGITUD_DETALLE){
+                    detalle = detalle + (longitud - TRAZA_LONGITUD_DETALLE);
+                    while ((((unsigned char) *detalle) & 0xC0)==0x80){
+                        detalle++;
+                    }
+                }
+                strcpy(e->detalle, detalle);
+            }
+            //El evento queda completo antes de que el escritor final pueda contarlo.
+            __atomic_store_n(&(B->cantidad), B->cantidad+1, __ATOMIC_RELEASE);
+        }
+    }
+    __atomic_sub_fetch(&registrando, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Escribe la cadena dada en el archivo como una cadena JSON, entre comillas y con los caracteres especiales escapados.
+*/
+static void aux_escribir_cadena(FILE *f, const char *s){
+    fputc('"', f);
+    while (*s!='\0'){
+        if (*s=='"' || *s=='\\'){
+            fputc('\\', f);
+            fputc(*s, f);
+        }
+        else if (((unsigned char) *s) < 0x20){
+            fprintf(f, "\\u%04x", (unsigned char) *s);
+        }
+        else{
+            fputc(*s, f);
+        }
+        s++;
+    }
+    fputc('"', f);
+}
+
+/**
+ * @brief Deshabilita la traza y espera a que terminen los registros en curso de los demás hilos. Luego de la
+ * invocación, ningún hilo vuelve a acceder a los búferes.
+*/
+static void aux_detener_registros(){
+    __atomic_store_n(&habilitada, FALSE, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&registrando, __ATOMIC_SEQ_CST)>0){
+#ifndef _WIN32
+        sched_yield();
+#endif
+    }
+}
+
+/**
+ * @brief Libera los búferes de todos los hilos.
+*/
+static void aux_liberar_buferes(){
+    struct bufer_traza *B = buferes;
+
+    while (B!=NULL){
+        struct bufer_traza *siguiente = B->siguiente;
+        free(B->eventos);
+        free(B);
+        B = siguiente;
+    }
+    buferes = NULL;
+}
+
+/**
+ * @brief Escribe los eventos de todos los hilos en el archivo de la traza y libera sus búferes. Se invoca al finalizar
+ * el programa, una vez detenidos los registros de los hilos que sigan ejecutándose.
+*/
+static void aux_escribir_traza(){
+    FILE *f;
+    unsigned long long escritos = 0;
+    unsigned long long descartados = 0;
+    int primero = TRUE;
+
+    aux_detener_registros();
+    f = fopen(path_traza, "w");
+
+    if (f==NULL){
+        printf("Error %d: No se pudo crear el archivo de la traza '%s'.\n", ERROR_TRAZA_ESCRITURA, path_traza);
+    }
+    else{
+        fprintf(f, "{\"traceEvents\":[\n");
+        for (struct bufer_traza *B = __atomic_load_n(&buferes, __ATOMIC_ACQUIRE); B!=NULL; B = B->siguiente){
+            unsigned long cantidad = __atomic_load_n(&(B->cantidad), __ATOMIC_ACQUIRE);
+
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+                    (primero==TRUE) ? "" : ",\n", B->hilo, (B->hilo==1) ? "principal" : "hilo", B->hilo);
+            primero = FALSE;
+            for (unsigned long i=0; i<cantidad; i++){
+                struct evento_traza *e = &(B->eventos[i]);
+                fprintf(f, ",\n{\"name\":");
+                aux_escribir_cadena(f, e->fase);
+                fprintf(f, ",\"cat\":\"cuentapalabras\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d", e->tipo, (e->instante - instante_inicial)/1000.0, B->hilo);
+                if (e->detalle[0]!='\0'){
+                    fprintf(f, ",\"args\":{\"detalle\":");
+                    aux_escribir_cadena(f, e->detalle);
+                    fprintf(f, "}");
+                }
+                fprintf(f, "}");
+            }
+            escritos = escritos + cantidad;
+            descartados = descartados + __atomic_load_n(&(B->descartados), __ATOMIC_RELAXED);
+        }
+        fprintf(f, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"eventos_descartados\":\"%llu\"}}\n", descartados);
+        if (fclose(f)!=0){
+            printf("Error %d: No se pudo escribir el archivo de la traza '%s'.\n", ERROR_TRAZA_ESCRITURA, path_traza);
+        }
+        else{
+            printf("Traza con %llu eventos de %d hilos escrita en '%s'", escritos, cant_hilos, path_traza);
+            if (descartados>0){
+                printf(" (se descartaron %llu eventos por llenarse el bufer de algun hilo)", descartados);
+            }
+            printf(".\n");
+        }
+    }
+    aux_liberar_buferes();
+}
+
+void traza_iniciar(char *path){
+    if (habilitada==FALSE){
+        path_traza = path;
+        instante_inicial = aux_instante();
+        habilitada = TRUE;
+        atexit(aux_escribir_traza);
+    }
+}
+
+void traza_comenzar(const char *fase, const char *detalle){
+    if (__atomic_load_n(&habilitada, __ATOMIC_RELAXED)==TRUE){
+        aux_registrar('B', fase, detalle);
+    }
+}
+
+void traza_terminar(const char *fase){
+    if (__atomic_load_n(&habilitada, __ATOMIC_RELAXED)==TRUE){
+        aux_registrar('E', fase, NULL);
+    }
+}
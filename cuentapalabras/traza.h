@@ -0,0 +1,53 @@
+/**
+* @file traza.h
+* @brief Archivo encabezado del TDA Traza.
+* Registra, si se habilita, una línea de tiempo de las fases del programa: cada fase se marca con un evento de comienzo
+* y otro de fin, junto al instante en que ocurre y el hilo que la ejecuta. Cada hilo guarda sus eventos en un búfer
+* propio, sin candados, de TRAZA_EVENTOS_POR_HILO eventos. Al llenarse, el hilo deja de registrar fases nuevas y solo
+* registra el fin de las que ya registró, de modo que la traza no tiene fases sin comienzo ni fin; los eventos que no
+* se registran se cuentan y se informan junto a la traza. Al finalizar el
+* programa, los eventos de todos los hilos se escriben en formato Chrome trace (JSON), que puede abrirse con Perfetto
+* (ui.perfetto.dev) o chrome://tracing para ver, por ejemplo, qué archivos demoraron en leerse y cuándo los hilos
+* esperaron a la entrada/salida.
+* Mientras la traza está deshabilitada, marcar una fase solo consulta una variable.
+*
+* @author Comisión N°17 (David Emanuel Latouquette - Otto Krause)
+*/
+
+#ifndef TRAZA_H_INCLUDED
+#define TRAZA_H_INCLUDED
+
+#define ERROR_TRAZA_MEMORIA -30
+#define ERROR_TRAZA_ESCRITURA -31
+
+//Cantidad de eventos que conserva cada hilo; al alcanzarla se descartan los nuevos. Puede redefinirse al compilar.
+#ifndef TRAZA_EVENTOS_POR_HILO
+#define TRAZA_EVENTOS_POR_HILO (1 << 16)
+#endif
+//Cantidad máxima de caracteres del detalle de un evento (se conservan los últimos, como el nombre de un archivo).
+#define TRAZA_LONGITUD_DETALLE 47
+
+/**
+ * @brief Habilita la traza a partir de la invocación. Los eventos se escriben en el archivo dado al finalizar el
+ * programa, ya sea retornando de main o invocando a exit.
+ * @param path Ruta del archivo JSON a escribir, que debe seguir siendo válida hasta el final del programa.
+*/
+extern void traza_iniciar(char *path);
+
+/**
+ * @brief Registra el comienzo de la fase dada en el hilo invocador. Sin la traza habilitada, no tiene efecto.
+ * @param fase Nombre de la fase, que debe ser una cadena constante (no se copia).
+ * @param detalle Dato adicional de la fase, como el nombre del archivo que procesa, o NULL (se copia).
+ * @throw ERROR_TRAZA_MEMORIA si no se pudo reservar memoria para el búfer del hilo.
+*/
+extern void traza_comenzar(const char *fase, const char *detalle);
+
+/**
+ * @brief Registra el fin de la fase dada, la última comenzada y aún no terminada en el hilo invocador.
+ * Sin la traza habilitada, no tiene efecto.
+ * @param fase Nombre de la fase, el mismo que recibió traza_comenzar.
+ * @throw ERROR_TRAZA_MEMORIA si no se pudo reservar memoria para el búfer del hilo.
+*/
+extern void traza_terminar(const char *fase);
+
+#endif // TRAZA_H_INCLUDED